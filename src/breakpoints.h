@@ -21,6 +21,10 @@
 
 #include <vector>
 #include <cstdint>
+#include <optional>
+#include <string>
+
+#include "tracepoint.h"
 
 namespace vicedebug {
 
@@ -36,6 +40,12 @@ struct Breakpoint {
     std::uint16_t addrStart;
     std::uint16_t addrEnd;
     bool enabled;
+    // VICE only stops if the condition holds. VICE doesn't report the condition
+    // text of existing checkpoints, so condition can be empty even if hasCondition is set.
+    bool hasCondition = false;
+    std::string condition;
+    // Set for tracepoints: on a hit, only this is recorded and execution continues.
+    std::optional<TraceSpec> trace;
 };
 
 typedef std::vector<Breakpoint> Breakpoints;
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bufferpool.h"
+
+#include <utility>
+
+namespace vicedebug {
+
+BufferPool::BufferPool() {
+    buffers_.reserve(kMaxPooledBuffers);
+}
+
+BufferPool& BufferPool::instance() {
+    static BufferPool pool;
+    return pool;
+}
+
+std::vector<std::uint8_t> BufferPool::acquire(std::size_t capacity) {
+    std::vector<std::uint8_t> res;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!buffers_.empty()) {
+            // Prefer the smallest buffer that fits, otherwise grow the largest one.
+            std::size_t best = 0;
+            for (std::size_t i = 1; i < buffers_.size(); i++) {
+                std::size_t c = buffers_[i].capacity();
+                std::size_t bestC = buffers_[best].capacity();
+                if ((c >= capacity && (bestC < capacity || c < bestC)) || (bestC < capacity && c > bestC)) {
+                    best = i;
+                }
+            }
+            std::swap(buffers_[best], buffers_.back());
+            res = std::move(buffers_.back());
+            buffers_.pop_back();
+        }
+    }
+    res.clear();
+    res.reserve(capacity);
+    return res;
+}
+
+void BufferPool::release(std::vector<std::uint8_t>&& buffer) {
+    if (buffer.capacity() == 0) {
+        return;
+    }
+    std::vector<std::uint8_t> dropped;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (buffers_.size() < kMaxPooledBuffers) {
+            buffers_.push_back(std::move(buffer));
+            return;
+        }
+        dropped = std::move(buffer);
+    }
+    // Freed outside of the lock.
+}
+
+std::size_t BufferPool::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return buffers_.size();
+}
+
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace vicedebug {
+
+// Recycles the storage of byte buffers, such as the payload of MEM_GET
+// responses. Buffers are acquired on the connection thread and are usually
+// released on the GUI thread once their content has been copied elsewhere.
+// Releasing a buffer is optional; buffers that are kept simply leave the pool.
+class BufferPool {
+public:
+    static constexpr const std::size_t kMaxPooledBuffers = 8;
+
+    BufferPool();
+
+    static BufferPool& instance();
+
+    // An empty buffer with room for at least `capacity` bytes.
+    std::vector<std::uint8_t> acquire(std::size_t capacity);
+
+    void release(std::vector<std::uint8_t>&& buffer);
+
+    // Number of buffers that are waiting to be reused.
+    std::size_t size() const;
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<std::vector<std::uint8_t>> buffers_;
+};
+
+}
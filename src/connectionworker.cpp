@@ -20,16 +20,18 @@
 #include "connectionworker.h"
 
 #include <iostream>
+#include <algorithm>
 
 #include <QIODevice>
 
-#include "vectorutils.h"
+#include "bufferpool.h"
+#include "tracing.h"
 
 namespace vicedebug {
 
 namespace {
 
-constexpr const int kHeaderSize = 12; // Size of the Response header
+static_assert(ReceiveBuffer::kHeaderSize == kEncodedSize<ResponseHeader>);
 
 std::map<int, const char*> kResponseTypeNames = {
     { RESPONSE_INVALID, "RESPONSE_INVALID" },
@@ -65,309 +67,259 @@ std::map<int, const char*> kResponseTypeNames = {
     { RESPONSE_AUTOSTART, "RESPONSE_AUTOSTART" }
 };
 
+// Request IDs wrap around, so they are compared by their distance.
+bool sentNoLaterThan(std::uint32_t id, std::uint32_t watermark) {
+    return (std::int32_t)(id - watermark) <= 0;
 }
 
-class Command {
-public:
-    Command(std::uint8_t cmd, std::uint32_t id, std::vector<std::uint8_t> body) : cmd_(cmd), id_(id), body_(body) {}
-
-    std::vector<std::uint8_t> getBuffer() {
-        std::vector<std::uint8_t> msg;
-        msg << (std::uint8_t)0x02 // Binary request marker
-            << (std::uint8_t)0x02 // API version
-            << (std::uint32_t)body_.size()
-            << id_
-            << cmd_;
-        msg.insert(msg.end(), body_.begin(), body_.end());
-        return msg;
-    }
-
-private:
-    uint8_t cmd_;
-    uint32_t id_;
-    std::vector<std::uint8_t> body_;
-};
-
+}
 
+bool decodeResponse(std::span<const std::uint8_t> body, MemGetResponse& r) {
+    MemGetResponseBody decoded;
+    if (!decode(body, decoded)) {
+        return false;
+    }
+    r.memory = BufferPool::instance().acquire(decoded.memory.size());
+    r.memory.assign(decoded.memory.begin(), decoded.memory.end());
+    return true;
+}
 
 ConnectionWorker::ConnectionWorker(QObject* parent)
-    : QObject(parent), socket_(this), reportOobStopped_(0)
+    : QObject(parent), flushScheduled_(false), maxInFlight_(kDefaultMaxInFlight), nextID_(0), lastSentID_(0), bulkInFlight_(0), socket_(this)
 {
     connect(&socket_, &QIODevice::readyRead, this, &ConnectionWorker::consumeBytes);
 }
 
 void ConnectionWorker::connectToHost(QString host, int port, int timeoutMs, QPromise<bool>* resultPromise) {
+    receiveBuffer_.clear();
     socket_.connectToHost(host, port);
     bool res = socket_.waitForConnected(timeoutMs);
+    if (res) {
+        // We coalesce writes ourselves, Nagle would only delay them.
+        socket_.setSocketOption(QAbstractSocket::LowDelayOption, 1);
+    }
     resultPromise->addResult(res);
     resultPromise->finish();
+    delete resultPromise;
 }
 
 void ConnectionWorker::disconnect() {
     socket_.disconnectFromHost();
-    socket_.waitForDisconnected();
+    if (socket_.state() != QAbstractSocket::UnconnectedState) {
+        socket_.waitForDisconnected();
+    }
+    dropAllRequests();
 }
 
-void ConnectionWorker::sendCommand(std::uint8_t cmd, std::vector<std::uint8_t> body, ResponseSetter* responseSetter) {
-    std::uint32_t id = nextID_++;
-    Command command(cmd, id, body);
-    std::vector<std::uint8_t> raw = command.getBuffer();
+void ConnectionWorker::setMaxInFlight(int maxInFlight) {
+    maxInFlight_ = std::max(1, maxInFlight);
+    scheduleFlush();
+}
 
-    reportOobResponses(false); // will be reenabled in the reponsesetter
-    outstandingRequests_[id] = responseSetter;
+void ConnectionWorker::sendCommand(std::uint8_t cmd, std::vector<std::uint8_t> body, ResponseSetter* responseSetter, std::uint32_t generation, RequestPriority priority) {
+    auto& queue = priority == RequestPriority::BULK ? bulkCommands_ : interactiveCommands_;
+    queue.push_back(PendingCommand{cmd, std::move(body), responseSetter, generation, priority});
+    scheduleFlush();
+}
 
-    socket_.write((char*)raw.data(), raw.size());
+void ConnectionWorker::dropSupersededCommands(std::uint32_t generation) {
+    // Requests that are already on the wire are answered anyway, only the
+    // ones still waiting for a slot in the window can be dropped.
+    auto superseded = [generation](const PendingCommand& pc) {
+        return pc.generation != kNoGeneration && pc.generation < generation;
+    };
+    for (auto* queue : { &interactiveCommands_, &bulkCommands_ }) {
+        for (auto& pc : *queue) {
+            if (superseded(pc)) {
+                delete pc.responseSetter;
+            }
+        }
+        std::erase_if(*queue, superseded);
+    }
 }
 
-std::uint32_t ConnectionWorker::readU32() {
-    std::uint32_t res;
-    std::uint8_t b1 = readU8();
-    std::uint8_t b2 = readU8();
-    std::uint8_t b3 = readU8();
-    std::uint8_t b4 = readU8();
-    res = b4 << 24 | b3 << 16 | b2 << 8 | b1;
-    return res;
+void ConnectionWorker::scheduleFlush() {
+    // Commands of a burst arrive as separate queued calls. Deferring the
+    // actual write until the event queue has delivered all of them lets us
+    // send the whole burst with a single write.
+    if (flushScheduled_) {
+        return;
+    }
+    flushScheduled_ = true;
+    QMetaObject::invokeMethod(this, &ConnectionWorker::flush, Qt::QueuedConnection);
 }
 
-std::uint8_t ConnectionWorker::readU8() {
-    std::uint8_t res;
-    socket_.read((char*)&res, sizeof(res));
-    return res;
+bool ConnectionWorker::hasSendableCommands() const {
+    return !interactiveCommands_.empty() || (!bulkCommands_.empty() && bulkInFlight_ < kMaxBulkInFlight);
+}
+
+void ConnectionWorker::flush() {
+    flushScheduled_ = false;
+    writeBuffer_.clear();
+    while (hasSendableCommands() && (int)outstandingRequests_.size() < maxInFlight_) {
+        auto& queue = interactiveCommands_.empty() ? bulkCommands_ : interactiveCommands_;
+        PendingCommand& pc = queue.front();
+        std::uint32_t id = nextID_++;
+        if (nextID_ == kOobRequestId) {
+            // Reserved for OOB responses
+            nextID_ = 0;
+        }
+        RequestHeader header;
+        header.bodyLength = pc.body.size();
+        header.requestId = id;
+        header.command = pc.cmd;
+        encodeTo(writeBuffer_, header);
+        writeBuffer_.insert(writeBuffer_.end(), pc.body.begin(), pc.body.end());
+        outstandingRequests_[id] = OutstandingRequest{pc.responseSetter, pc.priority};
+        if (pc.priority == RequestPriority::BULK) {
+            bulkInFlight_++;
+        }
+        lastSentID_ = id;
+        queue.pop_front();
+    }
+    if (!writeBuffer_.empty()) {
+        socket_.write((char*)writeBuffer_.data(), writeBuffer_.size());
+    }
+}
+
+void ConnectionWorker::dropAllRequests() {
+    // Deleting the setters cancels their promises, so nobody waits forever
+    // for responses that will never arrive.
+    for (auto& p : outstandingRequests_) {
+        delete p.second.responseSetter;
+    }
+    outstandingRequests_.clear();
+    bulkInFlight_ = 0;
+    for (auto* queue : { &interactiveCommands_, &bulkCommands_ }) {
+        for (auto& pc : *queue) {
+            delete pc.responseSetter;
+        }
+        queue->clear();
+    }
+    pendingOobs_.clear();
+    receiveBuffer_.clear();
 }
 
 void ConnectionWorker::consumeBytes() {
     qDebug() << "Available bytes: " << socket_.bytesAvailable();
 
-    while (socket_.bytesAvailable() > 0) {
-        std::uint8_t b = readU8();
-        currentMessage_.append(b);
-        if (currentMessage_.remaining() == 0) {
-            handleMessage(currentMessage_.data());
-            currentMessage_.reset();
+    // Drain everything the socket has in bulk, and hand out complete frames straight from the receive buffer.
+    qint64 available;
+    while ((available = socket_.bytesAvailable()) > 0) {
+        std::span<std::uint8_t> dest = receiveBuffer_.prepare(available);
+        qint64 read = socket_.read((char*)dest.data(), dest.size());
+        if (read <= 0) {
+            break;
+        }
+        receiveBuffer_.commit(read);
+        for (auto frame = receiveBuffer_.nextFrame(); !frame.empty(); frame = receiveBuffer_.nextFrame()) {
+            handleMessage(frame);
         }
     }
+
+    // Responses free up slots in the window, so send whatever is waiting.
+    if (hasSendableCommands()) {
+        flush();
+    }
 }
 
-void ConnectionWorker::handleMessage(std::vector<std::uint8_t> message) {
+void ConnectionWorker::handleMessage(std::span<const std::uint8_t> message) {
 
+    ResponseHeader h;
+    decode(message, h);
     // check whether we understand the message.
-    if (message[0] != 0x02) {
+    if (h.stx != kProtocolStx) {
         // Bad magic
         qCritical() << "BAD MAGIC!";
         return;
     }
-    if (message[1] != 0x02) {
+    if (h.apiVersion != kProtocolApiVersion) {
         qCritical() << "BAD API VERSION";
         return;
     }
-    int responseType = message[6];
-    int errorCode = message[7];
-    std::uint32_t bodyLength = message[5] << 24 | message[4] << 16 | message[3] << 8 | message[2];
-    if (message.size() - kHeaderSize != bodyLength) {
+    if (message.size() - kEncodedSize<ResponseHeader> != h.bodyLength) {
         qCritical() << "BAD BODY LENGTH";
         return;
     }
-    std::uint32_t responseID = message[11] << 24 | message[10] << 16 | message[9] << 8 | message[8];
+    int responseType = h.responseType;
+    std::uint32_t responseID = h.requestId;
+
+    Response header;
+    header.errorCode = h.errorCode;
+    header.id = responseID;
+    header.responseType = (ResponseType)responseType;
+
+    // Bodies of failed requests don't have the regular layout, don't decode them.
+    std::span<const std::uint8_t> body = h.errorCode == 0 ? message.subspan(kEncodedSize<ResponseHeader>) : std::span<const std::uint8_t>();
 
-    std::shared_ptr<Response> r = nullptr;
     qDebug() << QThread::currentThreadId() << "Received " << kResponseTypeNames[responseType] << "(" << responseType << ")";
-    switch(responseType) {
-    case RESPONSE_INVALID:
-        break;
-    case RESPONSE_MEM_GET: {
-        std::shared_ptr<MemGetResponse> m = std::make_shared<MemGetResponse>();
-        // First 2 bytes are memory length. Safe to ignore.
-        m->memory = std::vector<std::uint8_t>(message.begin() + kHeaderSize + 2, message.end());
-        r = m;
-        break;
-    }
-    case RESPONSE_MEM_SET: {
-        std::shared_ptr<MemSetResponse> m = std::make_shared<MemSetResponse>();
-        r = m;
-        break;
-    }
-    case RESPONSE_REGISTER_INFO: {
-        qDebug() << "Received RESPONSE_REGISTER_INFO (" << RESPONSE_REGISTER_INFO << "):";
-        std::shared_ptr<RegistersResponse> m = std::make_shared<RegistersResponse>();
-        vistream is(message.begin() + kHeaderSize);
-        std::uint16_t cnt = is.readU16();
-        qDebug() << "  " << cnt << " registers.";
-        while (cnt-- > 0) {
-            std::uint8_t len = is.readU8();
-            std::uint8_t id = is.readU8();
-            std::uint16_t val = is.readU16();
-            m->values[id] = val;
-            qDebug() << "  register " << id << " == " << val;
+
+    if (responseID != kOobRequestId) {
+        auto it = outstandingRequests_.find(responseID);
+        if (it == outstandingRequests_.end()) {
+            qWarning() << "Message " << responseID << " of type " << responseType << " is not expected by anybody!";
+            return;
         }
-        r = m;
-        break;
-    }
-    case RESPONSE_REGISTERS_AVAILABLE: {
-        std::shared_ptr<RegistersAvailableResponse> m = std::make_shared<RegistersAvailableResponse>();
-        vistream is(message.begin() + kHeaderSize);
-        std::uint16_t cnt = is.readU16();
-        qDebug() << "  " << cnt << " registers.";
-        while (cnt-- > 0) {
-            std::uint8_t len = is.readU8();
-            std::uint8_t id = is.readU8();
-            std::uint8_t bits = is.readU8();
-            std::string name;
-            std::uint8_t nameLen = is.readU8();
-            while (nameLen-- > 0) {
-                name += is.readU8();
+        // The setter decodes the body straight from the receive buffer into the promise's result.
+        auto handler = it->second.responseSetter;
+        handler->set(header, body);
+        if (handler->responseIsComplete()) {
+            if (it->second.priority == RequestPriority::BULK) {
+                bulkInFlight_--;
             }
-            m->regInfos[id] = RegInfo{bits, name};
-            qDebug() << "  register " << id << ": name == " << name.c_str() << ", bits == " << bits;
+            outstandingRequests_.erase(it);
+            delete handler;
+            reportPendingOobs();
         }
-        r = m;
-        break;
-    }
-    case RESPONSE_CHECKPOINT_INFO: {
-        qDebug() << "Received RESPONSE_CHECKPOINT_INFO (" << RESPONSE_CHECKPOINT_INFO << "):";
-        std::shared_ptr<CheckpointInfoResponse> m = std::make_shared<CheckpointInfoResponse>();
-        vistream is(message.begin() + kHeaderSize);
-        m->checkpoint.number = is.readU32();
-        m->checkpoint.hit = is.readU8();
-        m->checkpoint.startAddress = is.readU16();
-        m->checkpoint.endAddress = is.readU16();
-        m->checkpoint.stopWhenHit = is.readU8();
-        m->checkpoint.enabled = is.readU8();
-        m->checkpoint.op = is.readU8(); // 0x01: load, 0x02: store, 0x04: exec
-        m->checkpoint.isTemporary = is.readU8();
-        m->checkpoint.hitCount = is.readU32();
-        m->checkpoint.ignoreCount = is.readU32();
-        m->checkpoint.hasCondition = is.readU8();
-        m->checkpoint.memspace = is.readU8();
-        r = m;
-        break;
-    }
-    case RESPONSE_CHECKPOINT_LIST: {
-        std::shared_ptr<CheckpointListResponse> m = std::make_shared<CheckpointListResponse>();
-        vistream is(message.begin() + kHeaderSize);
-        m->nofCheckpoints = is.readU32();
-        r = m;
-        break;
-    }
-    case RESPONSE_CHECKPOINT_DELETE: {
-        std::shared_ptr<CheckpointDeleteResponse> m = std::make_shared<CheckpointDeleteResponse>();
-        r = m;
-        break;
-    }
-    case RESPONSE_CHECKPOINT_TOGGLE: {
-        std::shared_ptr<CheckpointToggleResponse> m = std::make_shared<CheckpointToggleResponse>();
-        r = m;
-        break;
-    }
-    case RESPONSE_ADVANCE_INSTRUCTIONS: {
-        std::shared_ptr<AdvanceInstructionsResponse> m = std::make_shared<AdvanceInstructionsResponse>();
-        r = m;
-        break;
-    }
-    case RESPONSE_EXIT: {
-        std::shared_ptr<ExitResponse> m = std::make_shared<ExitResponse>();
-        r = m;
-        break;
-    }
-    case RESPONSE_EXECUTE_UNTIL_RETURN: {
-        std::shared_ptr<ExecuteUntilReturnResponse> m = std::make_shared<ExecuteUntilReturnResponse>();
-        r = m;
-        break;
+        return;
     }
+
+    std::shared_ptr<Response> r = nullptr;
+    switch(responseType) {
     case RESPONSE_STOPPED: {
+        Tracer::instance().instant(kTraceStoppedReceived);
         std::shared_ptr<StoppedResponse> m = std::make_shared<StoppedResponse>();
-        vistream is(message.begin() + kHeaderSize);
-        m->pc = is.readU16();
+        decodeResponse(body, *m);
         r = m;
         break;
     }
     case RESPONSE_RESUMED: {
         std::shared_ptr<ResumedResponse> m = std::make_shared<ResumedResponse>();
-        vistream is(message.begin() + kHeaderSize);
-        m->pc = is.readU16();
+        decodeResponse(body, *m);
         r = m;
         break;
     }
-    case RESPONSE_BANKS_AVAILABLE: {
-        std::shared_ptr<BanksAvailableResponse> m = std::make_shared<BanksAvailableResponse>();
-        vistream is(message.begin() + kHeaderSize);
-        std::uint16_t cnt = is.readU16();
-        qDebug() << "  " << cnt << " banks.";
-        while (cnt-- > 0) {
-            std::uint8_t len = is.readU8();
-            std::uint16_t id = is.readU16();
-            std::string name;
-            std::uint8_t nameLen = is.readU8();
-            while (nameLen-- > 0) {
-                name += is.readU8();
-            }
-            m->banks[id] = name;
-            qDebug() << "  bank " << id << ": " << name.c_str();
-        }
+    case RESPONSE_CHECKPOINT_INFO: {
+        std::shared_ptr<CheckpointInfoResponse> m = std::make_shared<CheckpointInfoResponse>();
+        decodeResponse(body, *m);
         r = m;
         break;
     }
-    case RESPONSE_CONDITION_SET:
-    case RESPONSE_DUMP:
-    case RESPONSE_UNDUMP:
-    case RESPONSE_RESOURCE_GET:
-    case RESPONSE_RESOURCE_SET:
-    case RESPONSE_JAM:
-    case RESPONSE_KEYBOARD_FEED:
-    case RESPONSE_PING:
-    case RESPONSE_DISPLAY_GET:
-    case RESPONSE_VICE_INFO:
-    case RESPONSE_PALETTE_GET:
-    case RESPONSE_JOYPORT_SET:
-    case RESPONSE_USERPORT_SET:
-    case RESPONSE_QUIT:
-    case RESPONSE_RESET:
-    case RESPONSE_AUTOSTART:
-    default: {
-        qCritical() << "Received unknown response type " << responseType << ", ignoring it.";
-    }
-    }
-    qDebug() << QThread::currentThreadId() << "Done receiveing " << kResponseTypeNames[responseType] << "(" << responseType << ")";
-
-    if (r == nullptr) {
-        qWarning() << "Message " << responseID << " of type " << responseType << " received, but handled";
+    default:
+        qWarning() << "OOB message of type " << responseType << " received, but not handled";
         return;
     }
+    static_cast<Response&>(*r) = header;
 
-    r->responseType = (ResponseType)responseType;
-
-    if (responseID != -1) {
-        qDebug() << QThread::currentThreadId() << "Going to call " << kResponseTypeNames[responseType] << " handler for responseID " << responseID;
-        auto handler = outstandingRequests_[responseID];
-
-        if (handler != nullptr) {
-            qDebug() << QThread::currentThreadId() << "Calling " << kResponseTypeNames[responseType] << " handler for responseID " << responseID;
-            handler->set(r);
-            if (handler->responseIsComplete()) {
-                outstandingRequests_.erase(responseID);
-                delete handler;
-            }
-        } else {
-            qWarning() << "Message " << responseID << " of type " << responseType << " is not expected by anybody!";
-        }
-    } else {
-        if (reportOobStopped_ > 0) {
-            unreportedOobs_.push_back(r);
-        } else {
-            emit oobResponseReceived(r);
-        }
-    }
+    // OOB events (STOPPED, RESUMED, ...) must not overtake the responses
+    // to requests that VICE received before it sent the event.
+    pendingOobs_.push_back(PendingOob{lastSentID_, r});
+    reportPendingOobs();
 }
 
-void ConnectionWorker::reportOobResponses(bool enabled) {
-    if (enabled) {
-        if (--reportOobStopped_ == 0) {
-            for (auto r : unreportedOobs_) {
-                emit oobResponseReceived(r);
-            }
-            unreportedOobs_.clear();
+void ConnectionWorker::reportPendingOobs() {
+    while (!pendingOobs_.empty()) {
+        const PendingOob& oob = pendingOobs_.front();
+        // Only a window of requests is in flight, so checking them all is cheap.
+        bool waiting = std::any_of(outstandingRequests_.begin(), outstandingRequests_.end(), [&oob](const auto& e) {
+            return sentNoLaterThan(e.first, oob.watermark);
+        });
+        if (waiting) {
+            return;
         }
-    } else {
-        reportOobStopped_++;
+        std::shared_ptr<Response> r = oob.response;
+        pendingOobs_.pop_front();
+        emit oobResponseReceived(r);
     }
 }
 
@@ -25,128 +25,47 @@
 #include <QTcpSocket>
 #include <QPromise>
 
-namespace vicedebug {
-
-enum BinaryCommand {
-    // Copied from https://sourceforge.net/p/vice-emu/code/HEAD/tree/trunk/vice/src/monitor/monitor_binary.c
-    CMD_INVALID = 0x00,
-
-    CMD_MEM_GET = 0x01,
-    CMD_MEM_SET = 0x02,
-
-    CMD_CHECKPOINT_GET = 0x11,
-    CMD_CHECKPOINT_SET = 0x12,
-    CMD_CHECKPOINT_DELETE = 0x13,
-    CMD_CHECKPOINT_LIST = 0x14,
-    CMD_CHECKPOINT_TOGGLE = 0x15,
-
-    CMD_CONDITION_SET = 0x22,
-
-    CMD_REGISTERS_GET = 0x31,
-    CMD_REGISTERS_SET = 0x32,
-
-    CMD_DUMP = 0x41,
-    CMD_UNDUMP = 0x42,
-
-    CMD_RESOURCE_GET = 0x51,
-    CMD_RESOURCE_SET = 0x52,
-
-    CMD_ADVANCE_INSTRUCTIONS = 0x71,
-    CMD_KEYBOARD_FEED = 0x72,
-    CMD_EXECUTE_UNTIL_RETURN = 0x73,
-
-    CMD_PING = 0x81,
-    CMD_BANKS_AVAILABLE = 0x82,
-    CMD_REGISTERS_AVAILABLE = 0x83,
-    CMD_DISPLAY_GET = 0x84,
-    CMD_VICE_INFO = 0x85,
-
-    CMD_PALETTE_GET = 0x91,
-
-    CMD_JOYPORT_SET = 0xa2,
-
-    CMD_USERPORT_SET = 0xb2,
-
-    CMD_EXIT = 0xaa,
-    CMD_QUIT = 0xbb,
-    CMD_RESET = 0xcc,
-    CMD_AUTOSTART = 0xdd,
-};
-
-enum ResponseType {
-    // Copied from https://sourceforge.net/p/vice-emu/code/HEAD/tree/trunk/vice/src/monitor/monitor_binary.c
+#include <span>
+#include <deque>
 
-    RESPONSE_INVALID = 0x00,
-    RESPONSE_MEM_GET = 0x01,
-    RESPONSE_MEM_SET = 0x02,
+#include "protocol.h"
+#include "receivebuffer.h"
 
-    RESPONSE_CHECKPOINT_INFO = 0x11,
-
-    RESPONSE_CHECKPOINT_DELETE = 0x13,
-    RESPONSE_CHECKPOINT_LIST = 0x14,
-    RESPONSE_CHECKPOINT_TOGGLE = 0x15,
-
-    RESPONSE_CONDITION_SET = 0x22,
-
-    RESPONSE_REGISTER_INFO = 0x31,
-
-    RESPONSE_DUMP = 0x41,
-    RESPONSE_UNDUMP = 0x42,
-
-    RESPONSE_RESOURCE_GET = 0x51,
-    RESPONSE_RESOURCE_SET = 0x52,
-
-    RESPONSE_JAM = 0x61,
-    RESPONSE_STOPPED = 0x62,
-    RESPONSE_RESUMED = 0x63,
-
-    RESPONSE_ADVANCE_INSTRUCTIONS = 0x71,
-    RESPONSE_KEYBOARD_FEED = 0x72,
-    RESPONSE_EXECUTE_UNTIL_RETURN = 0x73,
-
-    RESPONSE_PING = 0x81,
-    RESPONSE_BANKS_AVAILABLE = 0x82,
-    RESPONSE_REGISTERS_AVAILABLE = 0x83,
-    RESPONSE_DISPLAY_GET = 0x84,
-    RESPONSE_VICE_INFO = 0x85,
-
-    RESPONSE_PALETTE_GET = 0x91,
-
-    RESPONSE_JOYPORT_SET = 0xa2,
-
-    RESPONSE_USERPORT_SET = 0xb2,
-
-    RESPONSE_EXIT = 0xaa,
-    RESPONSE_QUIT = 0xbb,
-    RESPONSE_RESET = 0xcc,
-    RESPONSE_AUTOSTART = 0xdd,
-};
+namespace vicedebug {
 
+// Responses: the header fields, and the body members listed in kFields (see protocol.h).
 struct Response {
     std::uint8_t errorCode;
     std::uint32_t id;
     ResponseType responseType;
 };
 
+// Decoded from a MemGetResponseBody, see decodeResponse() below.
 struct MemGetResponse : public Response {
     std::vector<std::uint8_t> memory;
 };
 
 struct MemSetResponse : public Response {
-    // EMPTY
+    static constexpr auto kFields = std::make_tuple();
 };
 
 struct RegistersResponse : public Response {
     std::map<std::uint8_t, std::uint16_t> values;
+
+    static constexpr auto kFields = std::make_tuple(&RegistersResponse::values);
 };
 
 struct RegInfo {
-    int bits;
+    std::uint8_t bits;
     std::string name;
+
+    static constexpr auto kFields = std::make_tuple(&RegInfo::bits, &RegInfo::name);
 };
 
 struct RegistersAvailableResponse : public Response {
     std::map<std::uint8_t, RegInfo> regInfos;
+
+    static constexpr auto kFields = std::make_tuple(&RegistersAvailableResponse::regInfos);
 };
 
 struct CheckpointInfo {
@@ -162,133 +81,178 @@ struct CheckpointInfo {
     std::uint32_t ignoreCount;
     bool hasCondition;
     std::uint8_t memspace;
+
+    static constexpr auto kFields = std::make_tuple(
+        &CheckpointInfo::number, &CheckpointInfo::hit, &CheckpointInfo::startAddress, &CheckpointInfo::endAddress,
+        &CheckpointInfo::stopWhenHit, &CheckpointInfo::enabled, &CheckpointInfo::op, &CheckpointInfo::isTemporary,
+        &CheckpointInfo::hitCount, &CheckpointInfo::ignoreCount, &CheckpointInfo::hasCondition, &CheckpointInfo::memspace);
 };
 
 struct CheckpointListResponse : public Response {
     std::uint32_t nofCheckpoints;
-    std::vector<CheckpointInfo> checkpoints;
+    std::vector<CheckpointInfo> checkpoints; // Collected from the preceding CHECKPOINT_INFO responses
+
+    static constexpr auto kFields = std::make_tuple(&CheckpointListResponse::nofCheckpoints);
 };
 
 struct CheckpointInfoResponse : public Response {
     CheckpointInfo checkpoint;
+
+    static constexpr auto kFields = std::make_tuple(&CheckpointInfoResponse::checkpoint);
 };
 
 struct CheckpointDeleteResponse : public Response {
-    // EMPTY
+    static constexpr auto kFields = std::make_tuple();
 };
 
 struct CheckpointToggleResponse : public Response {
-    // EMPTY
+    static constexpr auto kFields = std::make_tuple();
+};
+
+struct ConditionSetResponse : public Response {
+    static constexpr auto kFields = std::make_tuple();
 };
 
 struct ExitResponse : public Response {
-    // EMPTY
+    static constexpr auto kFields = std::make_tuple();
 };
 
 struct AdvanceInstructionsResponse : public Response {
-    // EMPTY
+    static constexpr auto kFields = std::make_tuple();
 };
 
 struct ExecuteUntilReturnResponse : public Response {
-    // EMPTY
+    static constexpr auto kFields = std::make_tuple();
+};
+
+struct PingResponse : public Response {
+    static constexpr auto kFields = std::make_tuple();
 };
 
 struct BanksAvailableResponse : public Response {
     std::map<std::uint16_t, std::string> banks;
+
+    static constexpr auto kFields = std::make_tuple(&BanksAvailableResponse::banks);
 };
 
 struct StoppedResponse : public Response {
     std::uint16_t pc;
+
+    static constexpr auto kFields = std::make_tuple(&StoppedResponse::pc);
 };
 
 struct ResumedResponse : public Response {
     std::uint16_t pc;
+
+    static constexpr auto kFields = std::make_tuple(&ResumedResponse::pc);
 };
 
+static_assert(kEncodedSize<CheckpointInfo> == 23);
+
+// Decodes the body of a response into the type specific fields; the header
+// fields are filled in by the caller. Returns false if the body is truncated.
+template<typename T>
+bool decodeResponse(std::span<const std::uint8_t> body, T& r) {
+    return decode(body, r);
+}
+
+// MEM_GET payloads are decoded into pooled buffers.
+bool decodeResponse(std::span<const std::uint8_t> body, MemGetResponse& r);
+
 class ResponseSetter {
 public:
     virtual ~ResponseSetter() {};
 
-    virtual void set(std::shared_ptr<Response> response) = 0;
+    // Called on the connection thread with the response's header and a view
+    // of its body in the receive buffer. The body is only valid during the call.
+    virtual void set(const Response& header, std::span<const std::uint8_t> body) = 0;
     virtual bool responseIsComplete() = 0;
 };
 
-class MessageCollector {
-public:
-    MessageCollector() {
-        reset();
-    };
-
-    void reset() {
-        headerRemaining_ = 12;
-        bodyRemaining_ = 0;
-        buf_.clear();
-    }
-
-    int remaining() {
-        if (headerRemaining_ > 0) {
-            return headerRemaining_;
-        }
-        return bodyRemaining_;
-    }
-
-    void append(std::uint8_t val) {
-        buf_.push_back(val);
-        if (headerRemaining_ > 0) {
-            headerRemaining_--;
-            if (headerRemaining_ == 0) {
-                // Header complete: extract body length
-                bodyRemaining_ = buf_[5] << 24 | buf_[4] << 16 | buf_[3] << 8 | buf_[2];
-            }
-        } else {
-            bodyRemaining_--;
-        }
-    }
-
-    std::vector<std::uint8_t> data() {
-        return buf_;
-    }
-
-private:
-    int headerRemaining_;
-    int bodyRemaining_;
-    std::vector<std::uint8_t> buf_;
+enum class RequestPriority {
+    INTERACTIVE, // Something the user waits for: registers, the visible memory, edits, steps
+    BULK,        // Large transfers nobody waits for, sent in the gaps between interactive requests
 };
-      
+
 class ConnectionWorker : public QObject {
     Q_OBJECT
 
 public:
-    ConnectionWorker(QObject* parent);
+    // Default number of requests that are sent to VICE without waiting for their responses.
+    static constexpr const int kDefaultMaxInFlight = 16;
+
+    // Generation of commands that must never be dropped.
+    static constexpr const std::uint32_t kNoGeneration = 0;
 
-    // This is a dirty hack so that we don't get deadlocks
-    // at connection time...
-    void reportOobResponses(bool enabled);
+    // Number of bulk requests that are sent to VICE without waiting for their
+    // responses. Kept low so that an interactive request never waits long
+    // behind bulk requests that are already on the wire.
+    static constexpr const int kMaxBulkInFlight = 2;
+
+    ConnectionWorker(QObject* parent);
 
 signals:
     void oobResponseReceived(std::shared_ptr<Response> response);
 
 public slots:
+    // Takes ownership of resultPromise.
     void connectToHost(QString host, int port, int timeoutMs, QPromise<bool>* resultPromise);
     void disconnect();
-    void sendCommand(std::uint8_t cmd, std::vector<std::uint8_t> body, ResponseSetter* resposnseSetter);
+    // Commands with a generation other than kNoGeneration are side effect free
+    // reads that dropSupersededCommands() may discard before they are sent.
+    // Interactive commands overtake queued bulk commands, so only side effect
+    // free reads may be sent with RequestPriority::BULK.
+    void sendCommand(std::uint8_t cmd, std::vector<std::uint8_t> body, ResponseSetter* resposnseSetter,
+                     std::uint32_t generation = kNoGeneration, RequestPriority priority = RequestPriority::INTERACTIVE);
+    // Drops the queued reads of generations older than generation. Their futures are canceled.
+    void dropSupersededCommands(std::uint32_t generation);
+    void setMaxInFlight(int maxInFlight);
 
 private slots:
     void consumeBytes();
+    void flush();
 
 private:
-    std::uint32_t readU32();
-    std::uint8_t readU8();
-    //void putU32(std::uint32_t val, std::uint8_t* buf);
-    void handleMessage(std::vector<std::uint8_t> message);
+    struct PendingCommand {
+        std::uint8_t cmd;
+        std::vector<std::uint8_t> body;
+        ResponseSetter* responseSetter;
+        std::uint32_t generation;
+        RequestPriority priority;
+    };
+
+    struct OutstandingRequest {
+        ResponseSetter* responseSetter;
+        RequestPriority priority;
+    };
+
+    struct PendingOob {
+        // Highest request ID that was sent when the event arrived. The event
+        // is reported once all requests up to this one are complete.
+        std::uint32_t watermark;
+        std::shared_ptr<Response> response;
+    };
 
-    MessageCollector currentMessage_;
+    void scheduleFlush();
+    void handleMessage(std::span<const std::uint8_t> message);
+    void reportPendingOobs();
+    void dropAllRequests();
+    bool hasSendableCommands() const;
 
-    int reportOobStopped_;
-    std::vector<std::shared_ptr<Response>> unreportedOobs_;
+    ReceiveBuffer receiveBuffer_;
+    std::vector<std::uint8_t> writeBuffer_;
+    bool flushScheduled_;
 
+    int maxInFlight_;
     std::uint32_t nextID_;
-    std::map<std::uint32_t, ResponseSetter*> outstandingRequests_;
+    std::uint32_t lastSentID_;
+    // Request IDs are assigned when a command is sent, so they are in the
+    // order VICE sees the commands even if interactive ones overtake bulk ones.
+    std::deque<PendingCommand> interactiveCommands_;
+    std::deque<PendingCommand> bulkCommands_;
+    std::map<std::uint32_t, OutstandingRequest> outstandingRequests_;
+    int bulkInFlight_;
+    std::deque<PendingOob> pendingOobs_;
     QTcpSocket socket_;
 
     std::vector<CheckpointInfo> checkpointInfos;
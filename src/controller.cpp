@@ -19,10 +19,15 @@
 
 #include "controller.h"
 
+#include <algorithm>
+#include <array>
 #include <set>
 
 #include <QFuture>
 
+#include "bufferpool.h"
+#include "tracing.h"
+
 namespace vicedebug {
 
 namespace {
@@ -49,86 +54,251 @@ namespace {
   // common regs
   constexpr static const std::uint8_t kRegPCId = 3;
   constexpr static const std::uint8_t kRegSPId = 4;
+
+  constexpr static const int kNoRegister = -1;
+
+  // VICE's register ID for each Registers::ID
+  constexpr static const std::array<std::uint8_t, Registers::kNofRegisters> kViceRegIds = [] {
+      std::array<std::uint8_t, Registers::kNofRegisters> ids{};
+      ids[Registers::A] = kRegAId;
+      ids[Registers::X] = kRegXId;
+      ids[Registers::Y] = kRegYId;
+      ids[Registers::Flags] = kRegFlagsId;
+      ids[Registers::AF] = kRegAFId;
+      ids[Registers::BC] = kRegBCId;
+      ids[Registers::DE] = kRegDEId;
+      ids[Registers::HL] = kRegHLId;
+      ids[Registers::IX] = kRegIXId;
+      ids[Registers::IY] = kRegIYId;
+      ids[Registers::I] = kRegIId;
+      ids[Registers::R] = kRegRId;
+      ids[Registers::AFPrime] = kRegAFPrimeId;
+      ids[Registers::BCPrime] = kRegBCPrimeId;
+      ids[Registers::DEPrime] = kRegDEPrimtId;
+      ids[Registers::HLPrime] = kRegHLPrimeId;
+      ids[Registers::PC] = kRegPCId;
+      ids[Registers::SP] = kRegSPId;
+      return ids;
+  }();
+
+  // Registers::ID for each of VICE's register IDs, or kNoRegister
+  constexpr static const std::array<int, 256> kRegisterIds = [] {
+      std::array<int, 256> ids{};
+      ids.fill(kNoRegister);
+      for (int i = 0; i < Registers::kNofRegisters; i++) {
+          ids[kViceRegIds[i]] = i;
+      }
+      return ids;
+  }();
+
+  static_assert([] {
+      for (int i = 0; i < Registers::kNofRegisters; i++) {
+          if (kRegisterIds[kViceRegIds[i]] != i) {
+              return false; // Two registers map to the same VICE ID
+          }
+      }
+      return true;
+  }());
 }
 
 Controller::Controller(ViceClient* viceClient)
     : viceClient_(viceClient),
       connected_(false),
+      connecting_(false),
+      connectAttempt_(0),
       ignoreStopped_(true),
-      nextWatchNumber_(1)
+      pauseMethod_(PauseMethod::PING),
+      nextWatchNumber_(1),
+      paused_(false),
+      cpuBankId_(0),
+      activeCpu_(Cpu::MOS6502),
+      memoryGeneration_(0),
+      stepInFlight_(false),
+      stepNCount_(0),
+      stepLoopActive_(false),
+      stepLoopCanceled_(false),
+      hiddenResumes_(0),
+      pauseRequested_(false),
+      hitCountsStale_(false),
+      pollStopPending_(false),
+      profiling_(false),
+      recordingCoverage_(false),
+      coverageBankId_(0),
+      rasterProfiling_(false)
 {
     connect(viceClient_, &ViceClient::stoppedResponseReceived, this, &Controller::onStoppedReceived);
     connect(viceClient_, &ViceClient::resumedResponseReceived, this, &Controller::onResumedReceived);
+    connect(viceClient_, &ViceClient::checkpointHit, this, &Controller::onCheckpointHit);
+    hitCountTimer_.setInterval(kHitCountPollIntervalMs);
+    connect(&hitCountTimer_, &QTimer::timeout, this, &Controller::onHitCountTimer);
+}
+
+Registers Controller::registersFromResponse(const RegistersResponse& response) const {
+    Registers regs;
+    for (const auto& [viceRegId, value] : response.values) {
+        int id = kRegisterIds[viceRegId];
+        if (id != kNoRegister) {
+            regs[(Registers::ID)id] = value;
+        }
+    }
+    return regs;
 }
 
 namespace {
 
-inline static void maybeRegisterFromRespsonse(const RegistersResponse& response, std::uint8_t viceRegId, Registers& regs, Registers::ID reg) {
-    if (response.values.contains(viceRegId)) {
-//        auto a = ;
-        regs[reg] = response.values.at(viceRegId);
-    }
+// The code around PC: enough to fill the disassembly view before and after it.
+MemoryRange codeRange(std::uint16_t bankId, std::uint16_t pc) {
+    std::uint16_t start = pc >= 0x100 ? pc - 0x100 : 0;
+    std::uint16_t end = pc <= 0xfdff ? pc + 0x1ff : 0xffff;
+    return MemoryRange{bankId, start, end};
 }
 
+MemoryRange stackRange(std::uint16_t bankId, Cpu cpu, std::uint16_t sp) {
+    if (cpu == Cpu::MOS6502) {
+        return MemoryRange{bankId, 0x0100, 0x01ff};
+    }
+    return MemoryRange{bankId, (std::uint16_t)(sp & 0xff00), (std::uint16_t)(sp | 0x00ff)};
 }
 
-Registers Controller::registersFromResponse(RegistersResponse response) const {
-    Registers regs;
+std::vector<std::uint32_t> checkpointNumbers(const Profile& profile) {
+    std::vector<std::uint32_t> numbers;
+    for (const auto& e : profile.entries()) {
+        numbers.push_back(e.checkpointNumber);
+    }
+    return numbers;
+}
 
-    // 6502 regs
-    maybeRegisterFromRespsonse(response, kRegAId, regs, Registers::A);
-    maybeRegisterFromRespsonse(response, kRegXId, regs, Registers::X);
-    maybeRegisterFromRespsonse(response, kRegYId, regs, Registers::Y);
-    maybeRegisterFromRespsonse(response, kRegFlagsId, regs, Registers::Flags);
-
-    // Z80 regs
-    maybeRegisterFromRespsonse(response, kRegAFId, regs, Registers::AF);
-    maybeRegisterFromRespsonse(response, kRegBCId, regs, Registers::BC);
-    maybeRegisterFromRespsonse(response, kRegDEId, regs, Registers::DE);
-    maybeRegisterFromRespsonse(response, kRegHLId, regs, Registers::HL);
-    maybeRegisterFromRespsonse(response, kRegIXId, regs, Registers::IX);
-    maybeRegisterFromRespsonse(response, kRegIYId, regs, Registers::IY);
-    maybeRegisterFromRespsonse(response, kRegIId, regs, Registers::I);
-    maybeRegisterFromRespsonse(response, kRegRId, regs, Registers::R);
-    maybeRegisterFromRespsonse(response, kRegAFPrimeId, regs, Registers::AFPrime);
-    maybeRegisterFromRespsonse(response, kRegBCPrimeId, regs, Registers::BCPrime);
-    maybeRegisterFromRespsonse(response, kRegDEPrimtId, regs, Registers::DEPrime);
-    maybeRegisterFromRespsonse(response, kRegHLPrimeId, regs, Registers::HLPrime);
-
-    // Common regs
-    maybeRegisterFromRespsonse(response, kRegPCId, regs, Registers::PC);
-    maybeRegisterFromRespsonse(response, kRegSPId, regs, Registers::SP);
+}
 
-    return regs;
+std::vector<std::pair<MemoryRange, QFuture<MemGetResponse>>> Controller::fetchMissingPages(const MemoryRange& range, RequestPriority priority) {
+    std::vector<std::pair<MemoryRange, QFuture<MemGetResponse>>> res;
+    auto it = memory_.find(range.bankId);
+    if (it == memory_.end()) {
+        return res;
+    }
+    // Bulk fetches are split, so interactive requests can get in between the chunks.
+    int maxLen = priority == RequestPriority::BULK ? kBulkChunkSize : 0x10000;
+    auto& inFlight = pagesInFlight_[range.bankId];
+    for (const auto& [start, end] : it->second.missingRanges(range.start, range.end, inFlight)) {
+        for (int page = MemoryImage::pageOf(start); page <= MemoryImage::pageOf(end); page++) {
+            inFlight[page] = true;
+        }
+        for (int chunkStart = start; chunkStart <= end; chunkStart += maxLen) {
+            std::uint16_t chunkEnd = std::min(chunkStart + maxLen - 1, (int)end);
+            res.push_back({MemoryRange{range.bankId, (std::uint16_t)chunkStart, chunkEnd},
+                           viceClient_->memGet(chunkStart, chunkEnd, MemSpace::MAIN_MEMORY, range.bankId, false, priority)});
+        }
+    }
+    return res;
 }
 
-MachineState Controller::getMachineState() {    
-    MachineState machineState;
+void Controller::storePages(const MemoryRange& range, const std::vector<std::uint8_t>& data) {
+    auto it = memory_.find(range.bankId);
+    if (it == memory_.end()) {
+        return;
+    }
+    it->second.write(range.start, data);
+    auto& inFlight = pagesInFlight_[range.bankId];
+    for (int page = MemoryImage::pageOf(range.start); page <= MemoryImage::pageOf(range.end); page++) {
+        inFlight[page] = false;
+    }
+}
 
-    // Get memory for all banks
-    std::unordered_map<std::uint16_t, QFuture<MemGetResponse>> memGetResponseFutures;
-    for (const auto& p : availableBanks_) {
-        memGetResponseFutures[p.id] = viceClient_->memGet(0, 0xffff, MemSpace::MAIN_MEMORY, p.id, false);
+void Controller::requestMissingPages(const MemoryRange& range, RequestPriority priority) {
+    std::uint32_t generation = memoryGeneration_;
+    for (auto& p : fetchMissingPages(range, priority)) {
+        MemoryRange r = p.first;
+        p.second.then(this, [this, generation, r](QFuture<MemGetResponse> f) {
+            if (generation != memoryGeneration_ || f.resultCount() == 0) {
+                // The machine ran in the meantime, so this memory is stale.
+                return;
+            }
+            MemGetResponse response = f.takeResult();
+            storePages(r, response.memory);
+            emit memoryChanged(r.bankId, r.start, response.memory);
+            BufferPool::instance().release(std::move(response.memory));
+        });
     }
-    for (auto& p : memGetResponseFutures) {
-        p.second.waitForFinished();
-        machineState.memory.insert({p.first, p.second.result().memory});
+}
+
+void Controller::streamMemory() {
+    if (!connected_ || !paused_) {
+        return;
     }
+    // The visible memory is there already. Fetch the rest of what the CPU
+    // sees in the background, so that scrolling doesn't wait for VICE.
+    requestMissingPages(MemoryRange{cpuBankId_, 0, 0xffff}, RequestPriority::BULK);
+}
 
-    // Get registers
-    auto registersResponseFuture = viceClient_->registersGet(MemSpace::MAIN_MEMORY);
-    registersResponseFuture.waitForFinished();
-    auto registersResponse = registersResponseFuture.result();
+void Controller::setVisibleMemory(const QObject* viewer, const std::vector<MemoryRange>& ranges) {
+    if (ranges.empty()) {
+        visibleMemory_.erase(viewer);
+    } else {
+        if (!visibleMemory_.contains(viewer)) {
+            connect(viewer, &QObject::destroyed, this, [this, viewer] {
+                visibleMemory_.erase(viewer);
+            });
+        }
+        visibleMemory_[viewer] = ranges;
+    }
+    if (!connected_ || !paused_) {
+        // Will be prefetched on the next stop.
+        return;
+    }
+    for (const auto& r : ranges) {
+        requestMissingPages(r);
+    }
+}
 
-    machineState.regs = registersFromResponse(registersResponse);
+Task<std::optional<MachineState>> Controller::getMachineState(std::optional<std::uint16_t> pc) {
+    TraceScope trace(kTraceMachineState);
+    MachineState machineState;
 
     // Determine "cpu" bank
     for (const auto& p : availableBanks_) {
         if (p.name == "cpu" || p.name == "default") {
-            machineState.cpuBankId = p.id;
+            cpuBankId_ = p.id;
             break;
         }
     }
+    machineState.cpuBankId = cpuBankId_;
+
+    // Whatever we fetched before is stale now.
+    std::uint32_t generation = ++memoryGeneration_;
+    memory_.clear();
+    pagesInFlight_.clear();
+    for (const auto& p : availableBanks_) {
+        memory_.emplace(p.id, MemoryImage());
+    }
+
+    // Only fetch the memory that is actually shown: the ranges the viewers
+    // reported, and the code around PC if we know it already. All of it is
+    // pipelined with the registers request.
+    std::vector<std::pair<MemoryRange, QFuture<MemGetResponse>>> memGetResponseFutures;
+    auto fetch = [this, &memGetResponseFutures](const MemoryRange& range) {
+        auto futures = fetchMissingPages(range);
+        memGetResponseFutures.insert(memGetResponseFutures.end(), futures.begin(), futures.end());
+    };
+    for (const auto& p : visibleMemory_) {
+        for (const auto& r : p.second) {
+            fetch(r);
+        }
+    }
+    if (pc.has_value()) {
+        fetch(codeRange(cpuBankId_, pc.value()));
+    }
+    auto registersResponseFuture = viceClient_->registersGet(MemSpace::MAIN_MEMORY);
+
+    std::optional<RegistersResponse> registersResponse;
+    {
+        TraceScope trace(kTraceRegistersWait);
+        registersResponse = co_await registersResponseFuture;
+    }
+    if (!registersResponse.has_value() || generation != memoryGeneration_) {
+        co_return std::nullopt;
+    }
+
+    machineState.regs = registersFromResponse(registersResponse.value());
 
     // Determine available CPUs and active CPU
     machineState.activeCpu = Cpu::MOS6502;
@@ -136,40 +306,83 @@ MachineState Controller::getMachineState() {
         machineState.activeCpu = Cpu::Z80;
     }
     machineState.availableCpus = availableCpus_;
+    activeCpu_ = machineState.activeCpu;
+
+    // Now that PC and SP are known, make sure code and stack are there, too.
+    // Usually, this doesn't add any requests.
+    fetch(codeRange(cpuBankId_, machineState.regs[Registers::PC]));
+    fetch(stackRange(cpuBankId_, machineState.activeCpu, machineState.regs[Registers::SP]));
 
-    return machineState;
+    TraceScope memoryTrace(kTraceMemoryWait);
+    for (auto& p : memGetResponseFutures) {
+        std::optional<MemGetResponse> response = co_await p.second;
+        if (generation != memoryGeneration_) {
+            // Somebody else is fetching the state now, and owns memory_.
+            co_return std::nullopt;
+        }
+        if (!response.has_value()) {
+            continue;
+        }
+        storePages(p.first, response->memory);
+        BufferPool::instance().release(std::move(response->memory));
+    }
+    machineState.memory = memory_;
+
+    co_return machineState;
 }
 
 void Controller::connectToVice(QString host, int port) {
-    if (connected_) {
+    if (connected_ || connecting_) {
         return;
     }
+    spawn(this, connectToViceTask(host, port));
+}
 
+Task<> Controller::connectToViceTask(QString host, int port) {
+    connecting_ = true;
+    std::uint32_t attempt = ++connectAttempt_;
     ignoreStopped_ = true;
     host_ = host;
     port_ = port;
     qDebug() <<  QThread::currentThreadId() << "**** Connecting";
-    connected_ = viceClient_->connectToVice(host, port, 1000); // 1 sec timeout
+    std::optional<bool> connected = co_await viceClient_->connectToVice(host, port, 1000); // 1 sec timeout
     qDebug() << QThread::currentThreadId() << "**** Connected";
-    if (!connected_) {
+    if (attempt != connectAttempt_) {
+        // disconnect() was called while we were waiting.
+        co_return;
+    }
+    if (!connected.value_or(false)) {
+        connecting_ = false;
         emit connectionFailed();
-        return;
+        co_return;
     }
 
+    // These don't depend on each other, so send them all before waiting for any of them.
     auto registersAvailableResponseFuture = viceClient_->registersAvailable(MemSpace::MAIN_MEMORY);
-    registersAvailableResponseFuture.waitForFinished();
-    auto registersAvailableResponse = registersAvailableResponseFuture.result();
+    auto banksAvailableResponseFuture = viceClient_->banksAvailable();
+    auto checkpointListResponseFuture = viceClient_->checkpointList();
+
+    auto registersAvailableResponse = co_await registersAvailableResponseFuture;
+    auto banksAvailableResponse = co_await banksAvailableResponseFuture;
+    auto checkpointListResponse = co_await checkpointListResponseFuture;
+    if (attempt != connectAttempt_) {
+        co_return;
+    }
+    if (!registersAvailableResponse.has_value() || !banksAvailableResponse.has_value() || !checkpointListResponse.has_value()) {
+        // Connection dropped while we were setting up.
+        connecting_ = false;
+        emit connectionFailed();
+        co_return;
+    }
+
     qDebug() << "Available registers:";
-    for (const auto& p : registersAvailableResponse.regInfos) {
-        qDebug() << "    " << p.first << ": " << p.second.name.c_str() << " (" << p.second.bits << " bits)";
+    for (const auto& p : registersAvailableResponse->regInfos) {
+        qDebug() << "    " << p.first << ": " << p.second.name.c_str() << " (" << (int)p.second.bits << " bits)";
     }
 
-    auto banksAvailableResponseFuture = viceClient_->banksAvailable();
-    banksAvailableResponseFuture.waitForFinished();
-    auto banksAvailableResponse = banksAvailableResponseFuture.result();
     availableBanks_.clear();
     qDebug() << "Available banks:";
-    for (const auto& p : banksAvailableResponse.banks) {
+    for (const auto& p : banksAvailableResponse->banks) {
         availableBanks_.push_back(Bank{p.first, p.second});
         qDebug() << "    " << p.first << ": " << p.second.c_str();
     }
@@ -184,23 +397,26 @@ void Controller::connectToVice(QString host, int port) {
         availableCpus_.push_back(Cpu::Z80);
     }
 
-    auto checkpointListResponseFuture = viceClient_->checkpointList();
-    checkpointListResponseFuture.waitForFinished();
-    auto checkpointListResponse = checkpointListResponseFuture.result();
     qDebug() << "Got checkpoints";
 
     breakpoints_.clear();
+    traceLogs_.clear();
     // It looks like as of 2023-01-24, VICE head is returning breakpoints multiple time,
     // so we need to filter them.
     // Patch submitted to VICE: https://sourceforge.net/p/vice-emu/patches/354/
     Breakpoints breakpoints;
-    for (auto cp : checkpointListResponse.checkpoints) {
+    for (auto cp : checkpointListResponse->checkpoints) {
+        if (!cp.stopWhenHit) {
+            // Just counts hits, e.g. left over from a profiler or coverage run. Not a breakpoint.
+            continue;
+        }
         Breakpoint bp;
         bp.addrStart = cp.startAddress;
         bp.addrEnd = cp.endAddress;
         bp.enabled = cp.enabled;
         bp.number = cp.number;
         bp.op = cp.op;
+        bp.hasCondition = cp.hasCondition;
         if (breakpoints_.find(bp.number) == breakpoints_.end()) {
             // Not seen yet, add it.
             breakpoints.push_back(bp);
@@ -208,9 +424,26 @@ void Controller::connectToVice(QString host, int port) {
         }
     }
 
-    MachineState machineState = getMachineState();
+    std::optional<MachineState> machineState = co_await getMachineState();
+    if (attempt != connectAttempt_) {
+        co_return;
+    }
+    connecting_ = false;
+    if (!machineState.has_value()) {
+        emit connectionFailed();
+        co_return;
+    }
+    // VICE reported the registers of the CPU that is active now.
+    availableRegisters_.clear();
+    rasterLineRegister_.reset();
+    rasterCycleRegister_.reset();
+    storeAvailableRegisters(machineState->activeCpu, registersAvailableResponse.value());
+
+    connected_ = true;
     ignoreStopped_ = true;
-    emit connected(machineState, availableBanks_, breakpoints);
+    paused_ = true;
+    emit connected(machineState.value(), availableBanks_, breakpoints);
+    streamMemory();
 }
 
 System Controller::determineSystem() const {
@@ -241,21 +474,66 @@ System Controller::determineSystem() const {
 }
 
 void Controller::disconnect() {
-    if (!connected_) {
+    if (!connected_ && !connecting_) {
         return;
     }
     viceClient_->disconnect();
     connected_ = false;
+    // Makes a connectToViceTask() that is still running give up.
+    connecting_ = false;
+    connectAttempt_++;
+    paused_ = false;
+    stepInFlight_ = false;
+    queuedSteps_.clear();
+    stepNCount_ = 0;
+    // Cancels the future a step loop waits for.
+    stopPromise_.reset();
+    hitCheckpoint_.reset();
+    hiddenResumes_ = 0;
+    pauseRequested_ = false;
+    // The checkpoints stay in VICE, but they can't be polled anymore.
+    profiling_ = false;
+    recordingCoverage_ = false;
+    coverageCheckpoints_.clear();
+    rasterProfiling_ = false;
+    rasterCheckpoints_.clear();
+    pollStopPending_ = false;
+    hitCountTimer_.stop();
     emit disconnected();
 }
 
-void Controller::createBreakpoint(std::uint8_t op, std::uint16_t start, std::uint16_t end, bool enabled) {
-    auto checkpointSetFuture = viceClient_->checkpointSet(start, end, true, enabled, op, false, MemSpace::MAIN_MEMORY);
-    checkpointSetFuture.waitForFinished();
-    auto checkpointSetResponse = checkpointSetFuture.result();
+void Controller::createBreakpoint(std::uint8_t op, std::uint16_t start, std::uint16_t end, bool enabled, const std::string& condition,
+                                  const std::optional<TraceSpec>& trace) {
+    spawn(this, createBreakpointTask(op, start, end, enabled, condition, trace));
+}
+
+Task<> Controller::createBreakpointTask(std::uint8_t op, std::uint16_t start, std::uint16_t end, bool enabled, std::string condition,
+                                        std::optional<TraceSpec> trace) {
+    auto checkpointSetResponse = co_await viceClient_->checkpointSet(start, end, true, enabled, op, false, MemSpace::MAIN_MEMORY);
+    if (!checkpointSetResponse.has_value()) {
+        co_return;
+    }
 
-    auto cp = checkpointSetResponse.checkpoint;
+    auto cp = checkpointSetResponse->checkpoint;
     Breakpoint bp{cp.number, cp.op, cp.startAddress, cp.endAddress, cp.enabled};
+    if (!condition.empty()) {
+        auto conditionSetResponse = co_await viceClient_->conditionSet(cp.number, condition);
+        if (!conditionSetResponse.has_value()) {
+            co_return;
+        }
+        if (conditionSetResponse->errorCode != 0) {
+            // A breakpoint that stops on every hit is not what was asked for.
+            viceClient_->checkpointDelete(cp.number);
+            emit breakpointConditionRejected(condition);
+            co_return;
+        }
+        bp.hasCondition = true;
+        bp.condition = condition;
+    }
+    if (trace.has_value()) {
+        bp.trace = trace;
+        traceLogs_.insert_or_assign(bp.number, TraceLog(*trace));
+    }
     breakpoints_[bp.number] = bp;
     emitBreakpoints();
 }
@@ -264,6 +542,7 @@ void Controller::deleteBreakpoint(std::uint32_t breakpointNumber) {
     auto checkpointDeleteFuture = viceClient_->checkpointDelete(breakpointNumber);
     // Response is empty, no need to wait for the result.
     breakpoints_.erase(breakpointNumber);
+    traceLogs_.erase(breakpointNumber);
     emitBreakpoints();
 }
 
@@ -277,6 +556,344 @@ void Controller::enableBreakpoint(std::uint32_t breakpointNumber, bool enabled)
     emitBreakpoints();
 }
 
+const TraceLog* Controller::traceLog(std::uint32_t breakpointNumber) const {
+    auto it = traceLogs_.find(breakpointNumber);
+    return it != traceLogs_.end() ? &it->second : nullptr;
+}
+
+void Controller::startProfiler(const std::vector<ProfileRegion>& regions) {
+    if (!connected_ || profiling_) {
+        return;
+    }
+    spawn(this, startProfilerTask(regions));
+}
+
+Task<> Controller::startProfilerTask(std::vector<ProfileRegion> regions) {
+    profiling_ = true;
+    profile_ = Profile();
+    std::vector<QFuture<CheckpointInfoResponse>> futures;
+    for (const auto& region : regions) {
+        futures.push_back(viceClient_->checkpointSet(region.start, region.end, false, true, Breakpoint::Type::EXEC, false, MemSpace::MAIN_MEMORY));
+    }
+    for (int i = 0; i < futures.size(); i++) {
+        auto checkpointSetResponse = co_await futures[i];
+        if (!checkpointSetResponse.has_value()) {
+            // Disconnected
+            co_return;
+        }
+        if (checkpointSetResponse->errorCode == 0) {
+            profile_.add(regions[i], checkpointSetResponse->checkpoint.number);
+        }
+    }
+    if (!profiling_) {
+        // Stopped while the checkpoints were set up.
+        removeCheckpoints(checkpointNumbers(profile_));
+        co_return;
+    }
+    hitCountsStale_ = false;
+    hitCountTimer_.start();
+    emit profileUpdated(profile_);
+}
+
+void Controller::stopProfiler() {
+    if (!profiling_) {
+        return;
+    }
+    profiling_ = false;
+    if (!needsHitCounts()) {
+        hitCountTimer_.stop();
+    }
+    removeCheckpoints(checkpointNumbers(profile_));
+}
+
+bool Controller::needsHitCounts() const {
+    return profiling_ || !coverageCheckpoints_.empty();
+}
+
+void Controller::removeCheckpoints(const std::vector<std::uint32_t>& numbers) {
+    if (numbers.empty()) {
+        return;
+    }
+    if (!paused_ && !pollStopPending_) {
+        // VICE stops to answer; onStoppedReceived() lets it continue.
+        pollStopPending_ = true;
+    }
+    for (std::uint32_t number : numbers) {
+        viceClient_->checkpointDelete(number);
+    }
+}
+
+void Controller::onHitCountTimer() {
+    if (!connected_ || pollStopPending_ || !needsHitCounts()) {
+        return;
+    }
+    if (paused_) {
+        if (hitCountsStale_) {
+            spawn(this, pollHitCountsTask());
+        }
+        return;
+    }
+    if (stepInFlight_ || !queuedSteps_.empty() || stepNCount_ > 0 || stepLoopActive_ || pauseRequested_) {
+        // The stop is reported anyway, the counts are fetched then.
+        return;
+    }
+    // VICE stops to answer; onStoppedReceived() lets it continue.
+    pollStopPending_ = true;
+    spawn(this, pollHitCountsTask());
+}
+
+Task<> Controller::pollHitCountsTask() {
+    hitCountsStale_ = false;
+    auto checkpointListResponse = co_await viceClient_->checkpointList();
+    if (!checkpointListResponse.has_value()) {
+        co_return;
+    }
+    std::unordered_map<std::uint32_t, std::uint32_t> hitCounts;
+    for (const auto& cp : checkpointListResponse->checkpoints) {
+        hitCounts[cp.number] = cp.hitCount;
+    }
+    if (profiling_) {
+        profile_.update(hitCounts);
+        emit profileUpdated(profile_);
+    }
+    // While a poll stopped the machine, its STOPPED is reported after this,
+    // so the checkpoints are deleted before the machine continues. Deleting
+    // them while it runs would stop it.
+    if (recordingCoverage_ && harvestCoverage(hitCounts, paused_ || pollStopPending_)) {
+        emit coverageChanged(coverage_);
+    }
+}
+
+void Controller::startCoverage(std::uint16_t start, std::uint16_t end) {
+    if (!connected_ || recordingCoverage_) {
+        return;
+    }
+    spawn(this, startCoverageTask(start, end));
+}
+
+Task<> Controller::startCoverageTask(std::uint16_t start, std::uint16_t end) {
+    recordingCoverage_ = true;
+    coverageBankId_ = cpuBankId_;
+    auto memGetResponse = co_await viceClient_->memGet(start, end, MemSpace::MAIN_MEMORY, coverageBankId_, false);
+    if (!memGetResponse.has_value() || !recordingCoverage_) {
+        co_return;
+    }
+    std::vector<std::uint8_t> memory(0x10000);
+    std::copy(memGetResponse->memory.begin(), memGetResponse->memory.end(), memory.begin() + start);
+    BufferPool::instance().release(std::move(memGetResponse->memory));
+
+    // Blocks that ran in an earlier run don't need a checkpoint anymore.
+    const CoverageMap* covered = coverage_.bank(coverageBankId_);
+    std::vector<CodeBlock> blocks;
+    for (const auto& block : Coverage::codeBlocks(activeCpu_, memory, start, end)) {
+        if (covered == nullptr || !covered->isCovered(block.start)) {
+            blocks.push_back(block);
+        }
+    }
+
+    std::vector<QFuture<CheckpointInfoResponse>> futures;
+    for (const auto& block : blocks) {
+        futures.push_back(viceClient_->checkpointSet(block.start, block.end, false, true, Breakpoint::Type::EXEC, false, MemSpace::MAIN_MEMORY));
+    }
+    for (int i = 0; i < futures.size(); i++) {
+        auto checkpointSetResponse = co_await futures[i];
+        if (!checkpointSetResponse.has_value()) {
+            // Disconnected
+            co_return;
+        }
+        if (checkpointSetResponse->errorCode == 0) {
+            coverageCheckpoints_[checkpointSetResponse->checkpoint.number] = blocks[i];
+        }
+    }
+    if (!recordingCoverage_) {
+        // Stopped while the checkpoints were set up, stopCoverageTask() deletes them.
+        co_return;
+    }
+    hitCountsStale_ = false;
+    hitCountTimer_.start();
+    emit coverageChanged(coverage_);
+}
+
+void Controller::stopCoverage() {
+    if (!recordingCoverage_) {
+        return;
+    }
+    recordingCoverage_ = false;
+    if (!needsHitCounts()) {
+        hitCountTimer_.stop();
+    }
+    spawn(this, stopCoverageTask());
+}
+
+Task<> Controller::stopCoverageTask() {
+    // Collect the hits since the last poll before the checkpoints are gone.
+    // Like a poll, this must not pause a running machine.
+    if (!paused_ && !pollStopPending_) {
+        pollStopPending_ = true;
+    }
+    auto checkpointListResponse = co_await viceClient_->checkpointList();
+    if (!checkpointListResponse.has_value()) {
+        co_return;
+    }
+    std::unordered_map<std::uint32_t, std::uint32_t> hitCounts;
+    for (const auto& cp : checkpointListResponse->checkpoints) {
+        hitCounts[cp.number] = cp.hitCount;
+    }
+    harvestCoverage(hitCounts, false);
+    std::vector<std::uint32_t> numbers;
+    for (const auto& [number, block] : coverageCheckpoints_) {
+        numbers.push_back(number);
+    }
+    removeCheckpoints(numbers);
+    coverageCheckpoints_.clear();
+    if (!needsHitCounts()) {
+        hitCountTimer_.stop();
+    }
+    emit coverageChanged(coverage_);
+}
+
+bool Controller::harvestCoverage(const std::unordered_map<std::uint32_t, std::uint32_t>& hitCounts, bool deleteCheckpoints) {
+    bool changed = false;
+    for (auto it = coverageCheckpoints_.begin(); it != coverageCheckpoints_.end();) {
+        auto hits = hitCounts.find(it->first);
+        if (hits == hitCounts.end() || hits->second == 0) {
+            ++it;
+            continue;
+        }
+        const CoverageMap* covered = coverage_.bank(coverageBankId_);
+        if (covered == nullptr || !covered->isCovered(it->second.start)) {
+            coverage_.mark(coverageBankId_, it->second);
+            changed = true;
+        }
+        if (!deleteCheckpoints) {
+            // Marked again by the next poll, which deletes it.
+            ++it;
+            continue;
+        }
+        viceClient_->checkpointDelete(it->first);
+        it = coverageCheckpoints_.erase(it);
+    }
+    return changed;
+}
+
+void Controller::mergeCoverage(const Coverage& coverage) {
+    coverage_.merge(coverage);
+    emit coverageChanged(coverage_);
+}
+
+void Controller::clearCoverage() {
+    coverage_.clear();
+    emit coverageChanged(coverage_);
+}
+
+void Controller::startRasterProfiler(const std::vector<RasterRoutine>& routines, RasterGeometry geometry) {
+    if (!connected_ || rasterProfiling_ || !hasRasterRegisters()) {
+        return;
+    }
+    spawn(this, startRasterProfilerTask(routines, geometry));
+}
+
+Task<> Controller::startRasterProfilerTask(std::vector<RasterRoutine> routines, RasterGeometry geometry) {
+    rasterProfiling_ = true;
+    // Look for the returns of routines without an exit in the code after their entries.
+    std::vector<std::optional<QFuture<MemGetResponse>>> codeFutures;
+    for (const auto& routine : routines) {
+        if (routine.exit.has_value()) {
+            codeFutures.push_back(std::nullopt);
+            continue;
+        }
+        std::uint16_t end = std::min(routine.entry + 4 * RasterProfile::kMaxRoutineInstructions, 0xffff);
+        codeFutures.push_back(viceClient_->memGet(routine.entry, end, MemSpace::MAIN_MEMORY, cpuBankId_, false));
+    }
+    std::vector<RasterRoutine> found;
+    std::vector<std::uint8_t> memory(0x10000);
+    for (int i = 0; i < routines.size(); i++) {
+        if (codeFutures[i].has_value()) {
+            auto memGetResponse = co_await codeFutures[i].value();
+            if (!memGetResponse.has_value()) {
+                // Disconnected
+                co_return;
+            }
+            std::copy(memGetResponse->memory.begin(), memGetResponse->memory.end(), memory.begin() + routines[i].entry);
+            BufferPool::instance().release(std::move(memGetResponse->memory));
+            routines[i].exit = RasterProfile::findExit(activeCpu_, memory, routines[i].entry);
+            if (!routines[i].exit.has_value()) {
+                qDebug() << "Raster profiler: no return found after" << QString::asprintf("$%04x", routines[i].entry);
+                continue;
+            }
+        }
+        found.push_back(routines[i]);
+    }
+
+    rasterProfile_ = RasterProfile(found, geometry);
+    rasterCheckpoints_.clear();
+    std::vector<QFuture<CheckpointInfoResponse>> futures;
+    for (const auto& routine : found) {
+        futures.push_back(viceClient_->checkpointSet(routine.entry, routine.entry, true, true, Breakpoint::Type::EXEC, false, MemSpace::MAIN_MEMORY));
+        futures.push_back(viceClient_->checkpointSet(*routine.exit, *routine.exit, true, true, Breakpoint::Type::EXEC, false, MemSpace::MAIN_MEMORY));
+    }
+    for (int i = 0; i < futures.size(); i++) {
+        auto checkpointSetResponse = co_await futures[i];
+        if (!checkpointSetResponse.has_value()) {
+            // Disconnected
+            co_return;
+        }
+        if (checkpointSetResponse->errorCode == 0) {
+            rasterCheckpoints_[checkpointSetResponse->checkpoint.number] = RasterProbe{i / 2, i % 2 == 0};
+        }
+    }
+    if (!rasterProfiling_) {
+        // Stopped while the checkpoints were set up.
+        removeRasterCheckpoints();
+        co_return;
+    }
+    rasterUpdateTimer_.start();
+    emit rasterProfileUpdated(rasterProfile_);
+}
+
+void Controller::stopRasterProfiler() {
+    if (!rasterProfiling_) {
+        return;
+    }
+    rasterProfiling_ = false;
+    removeRasterCheckpoints();
+    emit rasterProfileUpdated(rasterProfile_);
+}
+
+void Controller::removeRasterCheckpoints() {
+    std::vector<std::uint32_t> numbers;
+    for (const auto& [number, probe] : rasterCheckpoints_) {
+        numbers.push_back(number);
+    }
+    // Once they are forgotten, a stop they cause would look like a breakpoint hit.
+    removeCheckpoints(numbers);
+    rasterCheckpoints_.clear();
+}
+
+Task<> Controller::rasterHitTask(std::uint32_t number) {
+    RasterProbe probe = rasterCheckpoints_.at(number);
+    // Like a tracepoint hit, but only the registers are needed.
+    auto registersFuture = viceClient_->registersGet(MemSpace::MAIN_MEMORY);
+    hiddenResumes_++;
+    viceClient_->exit();
+
+    auto registersResponse = co_await registersFuture;
+    if (!registersResponse.has_value() || !rasterProfiling_) {
+        co_return;
+    }
+    const auto& values = registersResponse->values;
+    auto line = values.find(*rasterLineRegister_);
+    auto cycle = values.find(*rasterCycleRegister_);
+    if (line == values.end() || cycle == values.end()) {
+        co_return;
+    }
+    rasterProfile_.addHit(probe.routine, probe.entry, line->second, cycle->second);
+    if (rasterUpdateTimer_.elapsed() >= kHitCountPollIntervalMs) {
+        rasterUpdateTimer_.restart();
+        emit rasterProfileUpdated(rasterProfile_);
+    }
+}
+
 void Controller::emitBreakpoints() {
     Breakpoints bps;
     for (auto it = breakpoints_.begin(); it != breakpoints_.end(); ++it) {
@@ -316,107 +933,307 @@ void Controller::deleteWatch(std::uint32_t number) {
     qWarning() << "deleteWatch: No watch found with number " << number << "!";
 }
 
-namespace {
+void Controller::updateRegisters(const Registers& registers) {
+    spawn(this, updateRegistersTask(registers));
+}
 
-inline static void maybeRegisterToRequest(const std::set<std::uint8_t>& availableRegs, const Registers& regs, Registers::ID regId, std::map<std::uint8_t, std::uint16_t>& viceRegs, std::uint8_t viceRegId) {
-    if (availableRegs.contains(viceRegId) && regs.contains(regId)) {
-        viceRegs[viceRegId] = regs[regId];
+Task<> Controller::updateRegistersTask(Registers registers) {
+    // VICE really does not like it if we set registers that it doesn't currently support,
+    // so we filter by the registers it reported for the active CPU.
+    Cpu cpu = activeCpu_;
+    if (!availableRegisters_.contains(cpu)) {
+        auto registersAvailableResponse = co_await viceClient_->registersAvailable(MemSpace::MAIN_MEMORY);
+        if (!registersAvailableResponse.has_value()) {
+            co_return;
+        }
+        storeAvailableRegisters(cpu, registersAvailableResponse.value());
     }
+    const auto& availableRegs = availableRegisters_[cpu];
+
+    std::map<std::uint8_t, std::uint16_t> regs;
+    for (int id = 0; id < Registers::kNofRegisters; id++) {
+        std::uint8_t viceRegId = kViceRegIds[id];
+        if (registers.contains((Registers::ID)id) && availableRegs[viceRegId]) {
+            regs[viceRegId] = registers[(Registers::ID)id];
+        }
+    }
+
+    auto registersSetResponse = co_await viceClient_->registersSet(MemSpace::MAIN_MEMORY, regs);
+    if (!registersSetResponse.has_value()) {
+        co_return;
+    }
+
+    emit registersChanged(registersFromResponse(registersSetResponse.value()));
 }
 
+void Controller::storeAvailableRegisters(Cpu cpu, const RegistersAvailableResponse& response) {
+    auto& available = availableRegisters_[cpu];
+    available.reset();
+    for (const auto& p : response.regInfos) {
+        available[p.first] = true;
+        // Not CPU registers, so they have no Registers::ID.
+        if (p.second.name == "LIN") {
+            rasterLineRegister_ = p.first;
+        } else if (p.second.name == "CYC") {
+            rasterCycleRegister_ = p.first;
+        }
+    }
 }
 
-void Controller::updateRegisters(const Registers& registers) {
+void Controller::stepIn() {
+    queueStep(StepKind::IN);
+}
 
-    // VICE really does not like it if we set registers that it doesn't currently support.
-    // To ensure we don't set bad regs, we first ask for registers info and filter by it.
-    auto registersAvailableResponseFuture = viceClient_->registersAvailable(MemSpace::MAIN_MEMORY);
-    registersAvailableResponseFuture.waitForFinished();
-    auto registersAvailableResponse = registersAvailableResponseFuture.result();
-    std::set<std::uint8_t> availableRegs;
-    for (const auto& p : registersAvailableResponse.regInfos) {
-        availableRegs.insert(p.first);
-    }
+void Controller::stepOut() {
+    queueStep(StepKind::OUT);
+}
 
-    std::map<std::uint8_t, std::uint16_t> regs;
+void Controller::stepOver() {
+    queueStep(StepKind::OVER);
+}
 
-    // 6502 regs
-    maybeRegisterToRequest(availableRegs, registers, Registers::A, regs, kRegAId);
-    maybeRegisterToRequest(availableRegs, registers, Registers::X, regs, kRegXId);
-    maybeRegisterToRequest(availableRegs, registers, Registers::Y, regs, kRegYId);
-    maybeRegisterToRequest(availableRegs, registers, Registers::Flags, regs, kRegFlagsId);
-
-    // Z80 regs
-    maybeRegisterToRequest(availableRegs, registers, Registers::AF, regs, kRegAFId);
-    maybeRegisterToRequest(availableRegs, registers, Registers::BC, regs, kRegBCId);
-    maybeRegisterToRequest(availableRegs, registers, Registers::DE, regs, kRegDEId);
-    maybeRegisterToRequest(availableRegs, registers, Registers::HL, regs, kRegHLId);
-    maybeRegisterToRequest(availableRegs, registers, Registers::IX, regs, kRegIXId);
-    maybeRegisterToRequest(availableRegs, registers, Registers::IY, regs, kRegIYId);
-    maybeRegisterToRequest(availableRegs, registers, Registers::I, regs, kRegIId);
-    maybeRegisterToRequest(availableRegs, registers, Registers::R, regs, kRegRId);
-    maybeRegisterToRequest(availableRegs, registers, Registers::AFPrime, regs, kRegAFPrimeId);
-    maybeRegisterToRequest(availableRegs, registers, Registers::BCPrime, regs, kRegBCPrimeId);
-    maybeRegisterToRequest(availableRegs, registers, Registers::DEPrime, regs, kRegDEPrimtId);
-    maybeRegisterToRequest(availableRegs, registers, Registers::HLPrime, regs, kRegHLPrimeId);
-
-    // Common regs
-    maybeRegisterToRequest(availableRegs, registers, Registers::SP, regs, kRegSPId);
-    maybeRegisterToRequest(availableRegs, registers, Registers::PC, regs, kRegPCId);
-
-    auto registersSetResponseFuture = viceClient_->registersSet(MemSpace::MAIN_MEMORY, regs);
-    registersSetResponseFuture.waitForFinished();
-    auto registersSetResponse = registersSetResponseFuture.result();
-
-    emit registersChanged(registersFromResponse(registersSetResponse));
+void Controller::queueStep(StepKind kind) {
+    if (stepLoopActive_) {
+        return;
+    }
+    if (!stepInFlight_) {
+        sendStep(QueuedStep{kind, 1});
+        return;
+    }
+    // ADVANCE_INSTRUCTIONS takes a count, so a run of steps of the same kind
+    // becomes one command. There's no count for "execute until return".
+    if (!queuedSteps_.empty()) {
+        QueuedStep& last = queuedSteps_.back();
+        if (last.kind == kind && kind != StepKind::OUT && last.count < 0xffff) {
+            last.count++;
+            return;
+        }
+    }
+    queuedSteps_.push_back(QueuedStep{kind, 1});
 }
 
-void Controller::stepIn() {
+void Controller::sendStep(const QueuedStep& step) {
     ignoreStopped_ = false;
-    viceClient_->advanceInstructions(false, 1);
+    markRunning();
+    traceStep();
+    stepInFlight_ = true;
+    if (step.kind == StepKind::OUT) {
+        viceClient_->executeUntilReturn();
+    } else {
+        viceClient_->advanceInstructions(step.kind == StepKind::OVER, step.count);
+    }
 }
 
-void Controller::stepOut() {
+void Controller::stepN(int count, bool stepOver) {
     ignoreStopped_ = false;
-    viceClient_->executeUntilReturn();
+    markRunning();
+    traceStep();
+    stepNCount_ = std::clamp(count, 1, 0xffff); // VICE takes a 16 bit count
+    stepTimer_.start();
+    viceClient_->advanceInstructions(stepOver, stepNCount_);
 }
 
-void Controller::stepOver() {
+void Controller::stepUntil(const StepCondition& condition, bool stepOver, int maxSteps) {
+    if (stepLoopActive_) {
+        return;
+    }
+    spawn(this, stepUntilTask(condition, stepOver, maxSteps));
+}
+
+Task<> Controller::stepUntilTask(StepCondition condition, bool stepOver, int maxSteps) {
+    stepLoopActive_ = true;
+    stepLoopCanceled_ = false;
     ignoreStopped_ = false;
-    viceClient_->advanceInstructions(true, 1);
+    markRunning();
+    traceStep();
+    emit executionResumed();
+
+    QElapsedTimer timer;
+    timer.start();
+    const std::vector<std::uint16_t>& addresses = condition.memoryAddresses();
+    std::optional<std::uint16_t> pc;
+    int steps = 0;
+    while (steps < maxSteps && !stepLoopCanceled_) {
+        stopPromise_ = std::make_unique<QPromise<std::uint16_t>>();
+        stopPromise_->start();
+        QFuture<std::uint16_t> stopped = stopPromise_->future();
+        viceClient_->advanceInstructions(stepOver, 1);
+        std::optional<std::uint16_t> stoppedAt = co_await stopped;
+        if (!stoppedAt.has_value()) {
+            // Disconnected
+            break;
+        }
+        pc = stoppedAt;
+        steps++;
+
+        // Fetch just what the condition needs, all pipelined.
+        auto registersFuture = viceClient_->registersGet(MemSpace::MAIN_MEMORY);
+        std::vector<QFuture<MemGetResponse>> memoryFutures;
+        for (std::uint16_t addr : addresses) {
+            memoryFutures.push_back(viceClient_->memGet(addr, addr, MemSpace::MAIN_MEMORY, cpuBankId_, false));
+        }
+        auto registersResponse = co_await registersFuture;
+        std::unordered_map<std::uint16_t, std::uint8_t> memory;
+        bool complete = registersResponse.has_value();
+        for (int i = 0; i < memoryFutures.size(); i++) {
+            auto memGetResponse = co_await memoryFutures[i];
+            if (!memGetResponse.has_value()) {
+                complete = false;
+                continue;
+            }
+            if (!memGetResponse->memory.empty()) {
+                memory[addresses[i]] = memGetResponse->memory[0];
+            }
+            BufferPool::instance().release(std::move(memGetResponse->memory));
+        }
+        if (!complete || condition.evaluate(registersFromResponse(registersResponse.value()), memory)) {
+            break;
+        }
+    }
+    stopPromise_.reset();
+    stepLoopActive_ = false;
+    if (!connected_) {
+        co_return;
+    }
+
+    double seconds = timer.nsecsElapsed() / 1e9;
+    emit steppingFinished(steps, seconds > 0 ? steps / seconds : 0);
+
+    std::optional<MachineState> machineState = co_await getMachineState(pc);
+    if (!machineState.has_value()) {
+        co_return;
+    }
+    paused_ = true;
+    {
+        TraceScope trace(kTracePausedFanOut);
+        emit executionPaused(machineState.value());
+    }
+    streamMemory();
 }
 
 void Controller::pauseExecution() {
-    // VICE has no "pause" command, so we need to disconnect and reconnect to get the behavior
+    if (!connected_) {
+        return;
+    }
+    if (stepLoopActive_) {
+        // The loop stops after the current step.
+        stepLoopCanceled_ = true;
+        return;
+    }
+    // Steps that were not sent yet are dropped, a running one stops anyway.
+    queuedSteps_.clear();
+    // If VICE is stopped at a tracepoint, it stays there.
+    pauseRequested_ = true;
+    if (pauseMethod_ == PauseMethod::RECONNECT) {
+        spawn(this, pauseByReconnectTask());
+        return;
+    }
+
+    traceStep();
+    // VICE has no "pause" command, but it enters the monitor to answer any command.
+    // It reports that with a STOPPED event, which onStoppedReceived() handles like
+    // a breakpoint hit: banks, register layout and checkpoints stay as they are,
+    // only registers and memory are fetched again.
+    ignoreStopped_ = false;
+    viceClient_->ping();
+}
+
+Task<> Controller::pauseByReconnectTask() {
+    traceStep();
+
+    // Dropping the connection makes VICE enter the monitor when we connect again.
     viceClient_->disconnect();
 
-    connected_ = viceClient_->connectToVice(host_, port_, 1000); // 1 sec timeout
+    std::optional<bool> connected = co_await viceClient_->connectToVice(host_, port_, 1000); // 1 sec timeout
+    connected_ = connected.value_or(false);
     if (!connected_) {
         emit disconnected();
-        return;
+        co_return;
+    }
+
+    std::optional<MachineState> machineState = co_await getMachineState();
+    if (!machineState.has_value()) {
+        co_return;
+    }
+    paused_ = true;
+    {
+        TraceScope trace(kTracePausedFanOut);
+        emit executionPaused(machineState.value());
     }
+    streamMemory();
+}
+
+void Controller::traceStep() {
+    // Everything recorded until the next step belongs to this one.
+    Tracer& tracer = Tracer::instance();
+    tracer.beginStep();
+    tracer.instant(kTraceStepRequested);
+}
 
-    MachineState machineState = getMachineState();
-    emit executionPaused(machineState);
+void Controller::markRunning() {
+    // Drop responses to memory requests that are still in flight, and don't
+    // even send the ones that are still queued.
+    paused_ = false;
+    hitCountsStale_ = true;
+    memoryGeneration_++;
+    viceClient_->supersedeReads();
 }
 
 void Controller::resumeExecution() {
+    spawn(this, resumeExecutionTask());
+}
+
+Task<> Controller::resumeExecutionTask() {
+    queuedSteps_.clear();
+    pauseRequested_ = false;
+    pollStopPending_ = false;
     ignoreStopped_ = false;
-    auto exitFuture = viceClient_->exit();
-    exitFuture.waitForFinished();
+    markRunning();
+    traceStep();
+    auto exitResponse = co_await viceClient_->exit();
+    if (!exitResponse.has_value()) {
+        co_return;
+    }
     emit executionResumed();
 }
 
 void Controller::writeMemory(std::uint16_t bankId, std::uint16_t addr, std::uint8_t data) {
-    std::vector<std::uint8_t> vals { data };
-    auto memSetResponseFuture = viceClient_->memSet(addr, MemSpace::MAIN_MEMORY, bankId, false, vals);
-    memSetResponseFuture.waitForFinished();
+    MemoryEditTransaction transaction;
+    transaction.set(addr, data);
+    writeMemory(bankId, transaction);
+}
 
-    auto memGetResponseFuture = viceClient_->memGet(addr, addr, MemSpace::MAIN_MEMORY, bankId, false);
-    memGetResponseFuture.waitForFinished();
-    auto memGetResponse = memGetResponseFuture.result();
+void Controller::writeMemory(std::uint16_t bankId, const MemoryEditTransaction& transaction) {
+    if (transaction.empty()) {
+        return;
+    }
+    spawn(this, writeMemoryTask(bankId, transaction.runs()));
+}
 
-    emit memoryChanged(bankId, addr, memGetResponse.memory);
+Task<> Controller::writeMemoryTask(std::uint16_t bankId, std::vector<MemoryEditTransaction::Run> runs) {
+    // VICE handles requests in order, so there's no need to wait for the memSets before reading back.
+    for (const auto& run : runs) {
+        viceClient_->memSet(run.addr, MemSpace::MAIN_MEMORY, bankId, false, run.data);
+    }
+    std::vector<QFuture<MemGetResponse>> readBacks;
+    for (const auto& run : runs) {
+        readBacks.push_back(viceClient_->memGet(run.addr, run.end(), MemSpace::MAIN_MEMORY, bankId, false));
+    }
+
+    for (int i = 0; i < runs.size(); i++) {
+        auto memGetResponse = co_await readBacks[i];
+        if (!memGetResponse.has_value()) {
+            continue;
+        }
+        // ROM, or I/O registers, may read back differently than written. The
+        // views show what was read back.
+        auto it = memory_.find(bankId);
+        if (it != memory_.end()) {
+            it->second.write(runs[i].addr, memGetResponse->memory);
+        }
+        emit memoryChanged(bankId, runs[i].addr, memGetResponse->memory);
+        BufferPool::instance().release(std::move(memGetResponse->memory));
+    }
 }
 
 
@@ -424,15 +1241,136 @@ void Controller::onStoppedReceived(std::uint16_t pc) {
     if (ignoreStopped_) {
         qDebug() << "STOPPED received, but should ignore it. Therefore, ignoring it!";
     }
-    MachineState machineState = getMachineState();
-    emit executionPaused(machineState);
+    Tracer::instance().instant(kTraceStoppedDispatched);
+    std::optional<std::uint32_t> hitCheckpoint = hitCheckpoint_;
+    hitCheckpoint_.reset();
+    bool pollStop = pollStopPending_;
+    pollStopPending_ = false;
+    // A raster checkpoint that was hit just before it was deleted doesn't count.
+    bool checkpointStop = hitCheckpoint.has_value() && (breakpoints_.contains(*hitCheckpoint) || rasterCheckpoints_.contains(*hitCheckpoint));
+    if (pollStop && !checkpointStop && !pauseRequested_ && stopPromise_ == nullptr && !stepInFlight_ && stepNCount_ == 0) {
+        // Stopped to answer a hit count poll, or to delete checkpoints, which is done by now.
+        // Otherwise, a breakpoint was hit before VICE got the poll: a real stop.
+        hiddenResumes_++;
+        viceClient_->exit();
+        return;
+    }
+    if (stopPromise_ != nullptr) {
+        // A step loop is waiting for this, it fetches what it needs itself.
+        stopPromise_->addResult(pc);
+        stopPromise_->finish();
+        stopPromise_.reset();
+        return;
+    }
+    bool stepped = stepInFlight_ || stepNCount_ > 0;
+    stepInFlight_ = false;
+    if (!queuedSteps_.empty()) {
+        // The state at this stop is outdated before it could be shown, so
+        // don't fetch it and send the next step right away.
+        QueuedStep step = queuedSteps_.front();
+        queuedSteps_.pop_front();
+        sendStep(step);
+        return;
+    }
+    if (hitCheckpoint.has_value() && !stepped && !pauseRequested_ && traceLogs_.contains(*hitCheckpoint)) {
+        spawn(this, traceHitTask(*hitCheckpoint, pc));
+        return;
+    }
+    if (hitCheckpoint.has_value() && !stepped && !pauseRequested_ && rasterCheckpoints_.contains(*hitCheckpoint)) {
+        spawn(this, rasterHitTask(*hitCheckpoint));
+        return;
+    }
+    pauseRequested_ = false;
+    spawn(this, onStoppedReceivedTask(pc));
+}
+
+Task<> Controller::traceHitTask(std::uint32_t number, std::uint16_t pc) {
+    std::int64_t timestampNs = Tracer::now();
+    TraceSpec spec = traceLogs_.at(number).spec();
+
+    std::optional<QFuture<RegistersResponse>> registersFuture;
+    if (!spec.registers.empty()) {
+        registersFuture = viceClient_->registersGet(MemSpace::MAIN_MEMORY);
+    }
+    std::vector<QFuture<MemGetResponse>> memoryFutures;
+    for (const auto& range : spec.memory) {
+        memoryFutures.push_back(viceClient_->memGet(range.start, range.end, MemSpace::MAIN_MEMORY, cpuBankId_, false));
+    }
+    // VICE answers the reads before it handles the exit, so the machine
+    // continues without waiting for a round trip. The UI still shows it as
+    // running, so the RESUMED event is not reported.
+    hiddenResumes_++;
+    viceClient_->exit();
+
+    Registers regs;
+    if (registersFuture.has_value()) {
+        auto registersResponse = co_await registersFuture.value();
+        if (registersResponse.has_value()) {
+            regs = registersFromResponse(registersResponse.value());
+        }
+    }
+    std::vector<std::uint8_t> memory;
+    memory.reserve(spec.memorySize());
+    for (int i = 0; i < memoryFutures.size(); i++) {
+        std::size_t offset = memory.size();
+        auto memGetResponse = co_await memoryFutures[i];
+        if (memGetResponse.has_value()) {
+            memory.insert(memory.end(), memGetResponse->memory.begin(), memGetResponse->memory.end());
+            BufferPool::instance().release(std::move(memGetResponse->memory));
+        }
+        // Keep the bytes of the following ranges in place if a read failed.
+        memory.resize(offset + spec.memory[i].size());
+    }
+
+    auto it = traceLogs_.find(number);
+    if (it == traceLogs_.end()) {
+        // Deleted in the meantime.
+        co_return;
+    }
+    it->second.append(timestampNs, pc, regs, memory);
+    emit tracepointHit(number, it->second.size(), it->second.hitsPerSecond(Tracer::now()));
+}
+
+Task<> Controller::onStoppedReceivedTask(std::uint16_t pc) {
+    std::optional<MachineState> machineState = co_await getMachineState(pc);
+    if (!machineState.has_value()) {
+        // Superseded by a newer stop, or disconnected.
+        co_return;
+    }
+    paused_ = true;
+    {
+        TraceScope trace(kTracePausedFanOut);
+        emit executionPaused(machineState.value());
+    }
+    streamMemory();
+    if (stepNCount_ > 0) {
+        // VICE stops early if a breakpoint is hit, so this is an upper bound.
+        int steps = stepNCount_;
+        stepNCount_ = 0;
+        double seconds = stepTimer_.nsecsElapsed() / 1e9;
+        emit steppingFinished(steps, seconds > 0 ? steps / seconds : 0);
+    }
+}
+
+void Controller::onCheckpointHit(std::uint32_t number) {
+    hitCheckpoint_ = number;
 }
 
 void Controller::onResumedReceived(std::uint16_t pc) {
+    markRunning();
+    if (hiddenResumes_ > 0) {
+        // Continuing from a tracepoint or a hit count poll, the UI never saw the stop.
+        hiddenResumes_--;
+        return;
+    }
 //    if (ignoreStopped_) {
 //        qDebug() << "STOPPED received, but should ignore it. Therefore, ignoring it!";
 //    }
 //    MachineState machineState = getMachineState();
+    if (stepLoopActive_) {
+        // Reported once for the whole loop.
+        return;
+    }
     emit executionResumed();
 }
 
@@ -20,27 +20,122 @@
 #pragma once
 
 #include <QString>
+#include <QElapsedTimer>
+#include <QPromise>
+#include <QTimer>
 
+#include <bitset>
+#include <deque>
+#include <memory>
+#include <optional>
+
+#include "coro.h"
 #include "viceclient.h"
 #include "machinestate.h"
+#include "coverage.h"
+#include "memoryedittransaction.h"
+#include "profile.h"
+#include "rasterprofile.h"
 #include "breakpoints.h"
+#include "stepcondition.h"
+#include "tracepoint.h"
 #include "watches.h"
 
 namespace vicedebug {
 
+// Talks to VICE on behalf of the UI. None of the methods block: they send
+// their requests and return, and the results are reported with signals.
 class Controller : public QObject {
     Q_OBJECT
 
 public:
+    enum class PauseMethod {
+        PING, // Send a command on the open connection, VICE stops to answer it.
+        RECONNECT, // Reconnect, VICE stops for new connections.
+    };
+
+    // Size of the memGet requests that fetch memory in the background.
+    static constexpr const int kBulkChunkSize = 4 * MemoryImage::kPageSize;
+
+    // Upper bound for the number of steps of stepUntil()
+    static constexpr const int kDefaultMaxSteps = 100000;
+
+    // How often the hit counts of the profiler's and the coverage map's checkpoints are fetched.
+    static constexpr const int kHitCountPollIntervalMs = 500;
+
     Controller(ViceClient* viceClient);
 
     void connectToVice(QString host, int port);
     void disconnect();
 
-    void createBreakpoint(std::uint8_t op, std::uint16_t start, std::uint16_t end, bool enabled);
+    // If condition is not empty, VICE only stops when it holds, see ConditionSetCommand.
+    // With a trace spec, the breakpoint is a tracepoint: when it is hit while the
+    // machine runs, only the spec's registers and memory are fetched into the
+    // breakpoint's trace log, and execution continues right away.
+    void createBreakpoint(std::uint8_t op, std::uint16_t start, std::uint16_t end, bool enabled, const std::string& condition = {},
+                          const std::optional<TraceSpec>& trace = std::nullopt);
     void deleteBreakpoint(std::uint32_t breakpointNumber);
     void enableBreakpoint(std::uint32_t breakpointNumber, bool enabled);
 
+    // nullptr if the breakpoint is not a tracepoint.
+    const TraceLog* traceLog(std::uint32_t breakpointNumber) const;
+
+    // Installs a non-stopping exec checkpoint for each region. VICE counts
+    // their hits; the counts are fetched every kHitCountPollIntervalMs and
+    // reported with profileUpdated(). While the machine runs, a poll stops
+    // it for just one round trip. Only call these while the machine is paused.
+    void startProfiler(const std::vector<ProfileRegion>& regions);
+    void stopProfiler();
+
+    bool isProfiling() const {
+        return profiling_;
+    }
+
+    // Splits the code from start to end in the CPU's bank into blocks (see
+    // CodeBlock), and installs a non-stopping exec checkpoint for each block
+    // that is not covered yet. The hit counts are fetched like the profiler's,
+    // and checkpoints of blocks that ran are deleted, so VICE gets faster as
+    // the coverage grows. Changes are reported with coverageChanged(). Only
+    // call these while the machine is paused.
+    void startCoverage(std::uint16_t start, std::uint16_t end);
+    void stopCoverage();
+
+    bool isRecordingCoverage() const {
+        return recordingCoverage_;
+    }
+
+    // Blocks that still have a checkpoint.
+    std::size_t uncoveredBlocks() const {
+        return coverageCheckpoints_.size();
+    }
+
+    // Coverage is kept across runs and connections until it is cleared.
+    const Coverage& coverage() const {
+        return coverage_;
+    }
+
+    void mergeCoverage(const Coverage& coverage);
+    void clearCoverage();
+
+    // Installs an exec checkpoint that stops the machine at the entry and at
+    // the exit of each routine. Routines without an exit get the first return
+    // after their entry; ones where there is none are left out. At each hit,
+    // only the registers are fetched, and the machine continues right away.
+    // The raster line and cycle among them go into the raster profile, which
+    // is reported with rasterProfileUpdated() at most every
+    // kHitCountPollIntervalMs. Only call these while the machine is paused.
+    void startRasterProfiler(const std::vector<RasterRoutine>& routines, RasterGeometry geometry);
+    void stopRasterProfiler();
+
+    bool isRasterProfiling() const {
+        return rasterProfiling_;
+    }
+
+    // False if VICE does not report the raster line and cycle among the registers.
+    bool hasRasterRegisters() const {
+        return rasterLineRegister_.has_value() && rasterCycleRegister_.has_value();
+    }
+
     void createWatch(Watch::ViewType viewType, std::uint16_t bankId, std::uint16_t addr, std::uint16_t len);
     void modifyWatch(std::uint32_t number, Watch::ViewType viewType, std::uint16_t bankId, std::uint16_t addr, std::uint16_t len);
     void deleteWatch(std::uint32_t number);
@@ -51,13 +146,36 @@ public:
 
     void updateRegisters(const Registers& newValues);
 
+    // Steps requested while an earlier one is still running are queued, and
+    // consecutive ones of the same kind are sent to VICE as a single command.
+    // The state is only fetched once the queue is empty.
     void stepIn();
     void stepOut();
     void stepOver();
     void pauseExecution();
     void resumeExecution();
 
+    // Executes count instructions with a single command, and refreshes the state once at the end.
+    void stepN(int count, bool stepOver);
+
+    // Steps until condition holds, up to maxSteps steps. Between the steps, only
+    // the registers and the memory bytes the condition reads are fetched. The
+    // full state is refreshed once at the end. pauseExecution() stops early.
+    void stepUntil(const StepCondition& condition, bool stepOver, int maxSteps = kDefaultMaxSteps);
+
+    void setPauseMethod(PauseMethod pauseMethod) {
+        pauseMethod_ = pauseMethod;
+    }
+
     void writeMemory(std::uint16_t bankId, std::uint16_t addr, std::uint8_t data);
+    // Sends each contiguous run of the transaction with a single MEM_SET, reads
+    // each run back once, and emits one memoryChanged per run.
+    void writeMemory(std::uint16_t bankId, const MemoryEditTransaction& transaction);
+
+    // Tells the controller which memory a viewer currently shows. Missing pages in
+    // these ranges are fetched right away, and the ranges are prefetched on every
+    // stop. Passing an empty vector removes the viewer's ranges.
+    void setVisibleMemory(const QObject* viewer, const std::vector<MemoryRange>& ranges);
 
 signals:
     void connected(const MachineState& machineState, const Banks& availableBanks, const Breakpoints& breakpoints);
@@ -66,33 +184,150 @@ signals:
     void executionResumed();
     void executionPaused(const MachineState& machineState);
     void breakpointsChanged(const Breakpoints& breakpoints);
+    // VICE could not parse the condition; the breakpoint was not created.
+    void breakpointConditionRejected(const std::string& condition);
+    // A hit was added to the tracepoint's log.
+    void tracepointHit(std::uint32_t breakpointNumber, std::size_t hits, double hitsPerSecond);
+    void profileUpdated(const Profile& profile);
+    void coverageChanged(const Coverage& coverage);
+    void rasterProfileUpdated(const RasterProfile& profile);
     void watchesChanged(const Watches& watches);
     void registersChanged(const Registers& registers);
     void memoryChanged(std::uint16_t bankId, std::uint16_t address, const std::vector<std::uint8_t>& data);
+    // Emitted when stepN() or stepUntil() is done.
+    void steppingFinished(int steps, double stepsPerSecond);
 
 private slots:
     void onStoppedReceived(std::uint16_t pc);
     void onResumedReceived(std::uint16_t pc);
+    void onCheckpointHit(std::uint32_t number);
+    void onHitCountTimer();
 
 private:
     System determineSystem() const;
-    Registers registersFromResponse(RegistersResponse response) const;
-    MachineState getMachineState();
+    Registers registersFromResponse(const RegistersResponse& response) const;
+    void storeAvailableRegisters(Cpu cpu, const RegistersAvailableResponse& response);
+    // Empty if the connection dropped, or if the machine state was requested again in the meantime.
+    Task<std::optional<MachineState>> getMachineState(std::optional<std::uint16_t> pc = std::nullopt);
+    std::vector<std::pair<MemoryRange, QFuture<MemGetResponse>>> fetchMissingPages(const MemoryRange& range, RequestPriority priority = RequestPriority::INTERACTIVE);
+    void storePages(const MemoryRange& range, const std::vector<std::uint8_t>& data);
+    void requestMissingPages(const MemoryRange& range, RequestPriority priority = RequestPriority::INTERACTIVE);
+    void streamMemory();
+    void markRunning();
+    void traceStep();
+
+    enum class StepKind {
+        IN,
+        OVER,
+        OUT,
+    };
+    struct QueuedStep {
+        StepKind kind;
+        int count;
+    };
+    void queueStep(StepKind kind);
+    void sendStep(const QueuedStep& step);
+
+    // The coroutines behind the public methods of the same name.
+    Task<> connectToViceTask(QString host, int port);
+    Task<> createBreakpointTask(std::uint8_t op, std::uint16_t start, std::uint16_t end, bool enabled, std::string condition,
+                                std::optional<TraceSpec> trace);
+    Task<> updateRegistersTask(Registers registers);
+    Task<> pauseByReconnectTask();
+    Task<> resumeExecutionTask();
+    Task<> writeMemoryTask(std::uint16_t bankId, std::vector<MemoryEditTransaction::Run> runs);
+    Task<> onStoppedReceivedTask(std::uint16_t pc);
+    Task<> stepUntilTask(StepCondition condition, bool stepOver, int maxSteps);
+    Task<> traceHitTask(std::uint32_t number, std::uint16_t pc);
+    Task<> startProfilerTask(std::vector<ProfileRegion> regions);
+    Task<> pollHitCountsTask();
+    Task<> startCoverageTask(std::uint16_t start, std::uint16_t end);
+    Task<> stopCoverageTask();
+    Task<> startRasterProfilerTask(std::vector<RasterRoutine> routines, RasterGeometry geometry);
+    Task<> rasterHitTask(std::uint32_t number);
+
+    bool needsHitCounts() const;
+    // Deletes checkpoints of the profilers or the coverage map. If the machine
+    // runs, the stop this causes is hidden like the one of a hit count poll.
+    void removeCheckpoints(const std::vector<std::uint32_t>& numbers);
+    void removeRasterCheckpoints();
+    // Marks the blocks whose checkpoints were hit as covered. Returns true if the coverage changed.
+    bool harvestCoverage(const std::unordered_map<std::uint32_t, std::uint32_t>& hitCounts, bool deleteCheckpoints);
 
     void emitBreakpoints();
 
     bool ignoreStopped_;
+    PauseMethod pauseMethod_;
 
     QString host_;
     int port_;
     bool connected_;
+    bool connecting_;
+    std::uint32_t connectAttempt_; // Bumped by every connect and disconnect
     ViceClient* viceClient_;
     System system_;
     Cpus availableCpus_;
+    Cpu activeCpu_;
+    // VICE register IDs that can be set in the main memory space, per CPU. The
+    // set changes when the C128 switches CPUs, so the cache is keyed by CPU.
+    std::map<Cpu, std::bitset<256>> availableRegisters_;
     std::map<std::uint32_t, Breakpoint> breakpoints_;
+    std::map<std::uint32_t, TraceLog> traceLogs_;
     Banks availableBanks_;    
     Watches watches_;
     std::uint32_t nextWatchNumber_;
+
+    // Memory as far as it is fetched from VICE since the last stop.
+    bool paused_;
+    std::uint16_t cpuBankId_;
+    std::uint32_t memoryGeneration_;
+    std::unordered_map<std::uint16_t, MemoryImage> memory_;
+    std::unordered_map<std::uint16_t, std::bitset<MemoryImage::kMaxPages>> pagesInFlight_;
+    std::map<const QObject*, std::vector<MemoryRange>> visibleMemory_;
+
+    // Single steps
+    bool stepInFlight_; // A step was sent, and its STOPPED is not in yet
+    std::deque<QueuedStep> queuedSteps_;
+
+    // Multi-step commands
+    int stepNCount_; // Instructions of the running stepN(), or 0
+    QElapsedTimer stepTimer_;
+    bool stepLoopActive_;
+    bool stepLoopCanceled_;
+    // While set, STOPPED events fulfill this promise instead of refreshing the state.
+    std::unique_ptr<QPromise<std::uint16_t>> stopPromise_;
+
+    // Tracepoints
+    std::optional<std::uint32_t> hitCheckpoint_; // Reported by VICE for the next STOPPED
+    int hiddenResumes_; // RESUMED events of tracepoint or hit count poll continues that are still to come
+    bool pauseRequested_; // Keeps a tracepoint hit from continuing
+
+    // Hit counts of the profiler's and the coverage map's checkpoints
+    bool hitCountsStale_; // The machine ran since the last poll
+    bool pollStopPending_; // A poll, or deleting checkpoints, stopped the machine, its STOPPED is not in yet
+    QTimer hitCountTimer_;
+
+    // Profiler
+    bool profiling_;
+    Profile profile_;
+
+    // Coverage
+    bool recordingCoverage_;
+    std::uint16_t coverageBankId_;
+    std::map<std::uint32_t, CodeBlock> coverageCheckpoints_; // The blocks that were not hit yet, by checkpoint number
+    Coverage coverage_;
+
+    // Raster profiler
+    struct RasterProbe {
+        int routine;
+        bool entry;
+    };
+    bool rasterProfiling_;
+    std::optional<std::uint8_t> rasterLineRegister_; // VICE's register IDs of the raster position
+    std::optional<std::uint8_t> rasterCycleRegister_;
+    std::map<std::uint32_t, RasterProbe> rasterCheckpoints_;
+    RasterProfile rasterProfile_;
+    QElapsedTimer rasterUpdateTimer_;
 };
 
 }
@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QObject>
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace vicedebug {
+
+// Minimal C++20 coroutine support, so that code on the GUI thread can wait
+// for VICE without blocking the event loop:
+//
+//     Task<int> Foo::countRegisters() {
+//         std::optional<RegistersResponse> r = co_await viceClient_->registersGet(MemSpace::MAIN_MEMORY);
+//         if (!r) {
+//             co_return -1; // Connection dropped, the request was canceled.
+//         }
+//         co_return r->values.size();
+//     }
+//
+//     spawn(this, countRegisters()); // Runs until the first co_await, then returns.
+//
+// Awaiting a QFuture suspends the coroutine until the future finishes, and
+// resumes it in the thread that awaited it, from the event loop. The result
+// is empty if the future was canceled.
+//
+// Tasks are lazy: they start running when they are awaited, or spawned. A
+// task spawned with a context object is never resumed after the context was
+// deleted; its frame is leaked instead, which is fine at shutdown.
+
+template<typename T>
+class Task;
+
+namespace coro_internal {
+
+template<typename T>
+class TaskPromiseBase {
+public:
+    std::suspend_always initial_suspend() noexcept {
+        return {};
+    }
+
+    auto final_suspend() noexcept {
+        // Continue with whoever awaited the task, if anybody.
+        struct FinalAwaiter {
+            bool await_ready() noexcept {
+                return false;
+            }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<>) noexcept {
+                return continuation;
+            }
+            void await_resume() noexcept {}
+
+            std::coroutine_handle<> continuation;
+        };
+        return FinalAwaiter{continuation_ ? continuation_ : std::noop_coroutine()};
+    }
+
+    void unhandled_exception() noexcept {
+        std::terminate();
+    }
+
+    void setContinuation(std::coroutine_handle<> continuation) {
+        continuation_ = continuation;
+    }
+
+    QObject* context() const {
+        return context_;
+    }
+
+    void setContext(QObject* context) {
+        context_ = context;
+    }
+
+private:
+    QObject* context_ = nullptr;
+    std::coroutine_handle<> continuation_;
+};
+
+template<typename T>
+class TaskPromise : public TaskPromiseBase<T> {
+public:
+    Task<T> get_return_object();
+
+    void return_value(T value) {
+        value_.emplace(std::move(value));
+    }
+
+    T takeValue() {
+        return std::move(*value_);
+    }
+
+private:
+    std::optional<T> value_;
+};
+
+template<>
+class TaskPromise<void> : public TaskPromiseBase<void> {
+public:
+    Task<void> get_return_object();
+
+    void return_void() {}
+
+    void takeValue() {}
+};
+
+// Coroutine type of spawn(): starts right away and frees itself when done.
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() {
+            return {};
+        }
+        std::suspend_never initial_suspend() noexcept {
+            return {};
+        }
+        std::suspend_never final_suspend() noexcept {
+            return {};
+        }
+        void return_void() {}
+        void unhandled_exception() noexcept {
+            std::terminate();
+        }
+
+        QObject* context() const {
+            return context_;
+        }
+
+        QObject* context_ = nullptr;
+    };
+};
+
+// Sets the context of the awaiting Detached coroutine, without suspending it.
+struct SetContext {
+    bool await_ready() noexcept {
+        return false;
+    }
+    bool await_suspend(std::coroutine_handle<Detached::promise_type> h) noexcept {
+        h.promise().context_ = context;
+        return false;
+    }
+    void await_resume() noexcept {}
+
+    QObject* context;
+};
+
+}
+
+template<typename T = void>
+class [[nodiscard]] Task {
+public:
+    using promise_type = coro_internal::TaskPromise<T>;
+
+    explicit Task(std::coroutine_handle<promise_type> handle)
+        : handle_(handle) {}
+
+    Task(Task&& other) noexcept
+        : handle_(std::exchange(other.handle_, nullptr)) {}
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    template<typename P>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<P> awaiter) noexcept {
+        // Nested tasks inherit the context of the task that awaits them.
+        handle_.promise().setContext(awaiter.promise().context());
+        handle_.promise().setContinuation(awaiter);
+        return handle_;
+    }
+
+    T await_resume() {
+        return handle_.promise().takeValue();
+    }
+
+private:
+    std::coroutine_handle<promise_type> handle_;
+};
+
+namespace coro_internal {
+
+template<typename T>
+Task<T> TaskPromise<T>::get_return_object() {
+    return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() {
+    return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+template<typename T>
+Detached runDetached(QObject* context, Task<T> task) {
+    co_await SetContext{context};
+    co_await task;
+}
+
+}
+
+// Starts a task without waiting for it. It runs on its own until it is done,
+// or until context is deleted.
+template<typename T>
+void spawn(QObject* context, Task<T>&& task) {
+    coro_internal::runDetached(context, std::move(task));
+}
+
+template<typename T>
+class FutureAwaiter {
+public:
+    explicit FutureAwaiter(QFuture<T> future)
+        : future_(std::move(future)) {}
+
+    bool await_ready() const {
+        return future_.isFinished();
+    }
+
+    template<typename P>
+    void await_suspend(std::coroutine_handle<P> h) {
+        // The watcher lives in the awaiting thread, and reports cancellations
+        // as well. QFuture::then() would not run for canceled futures. As a
+        // child of the context, it is gone when the context is.
+        auto watcher = new QFutureWatcher<T>(h.promise().context());
+        QObject::connect(watcher, &QFutureWatcherBase::finished, watcher, [watcher, h] {
+            watcher->deleteLater();
+            h.resume();
+        });
+        watcher->setFuture(future_);
+    }
+
+    std::optional<T> await_resume() {
+        if (future_.isCanceled() || future_.resultCount() == 0) {
+            return std::nullopt;
+        }
+        return future_.takeResult();
+    }
+
+private:
+    QFuture<T> future_;
+};
+
+template<typename T>
+FutureAwaiter<T> operator co_await(QFuture<T> future) {
+    return FutureAwaiter<T>(std::move(future));
+}
+
+}
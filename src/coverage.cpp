@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "coverage.h"
+
+#include <algorithm>
+#include <bit>
+#include <memory>
+
+#include "disassembler.h"
+#include "littleendian.h"
+
+namespace vicedebug {
+
+namespace {
+
+constexpr const char kMagic[] = "VDCOVER1";
+constexpr const std::size_t kBitmapSize = 0x10000 / 8;
+
+// Instructions disassembled per call while looking for blocks.
+constexpr const int kLinesPerChunk = 256;
+
+bool readU16(std::istream& is, std::uint16_t& value) {
+    std::uint8_t bytes[2];
+    if (!is.read((char*)bytes, sizeof(bytes))) {
+        return false;
+    }
+    value = bytes[0] | bytes[1] << 8;
+    return true;
+}
+
+}
+
+void CoverageMap::mark(std::uint16_t start, std::uint16_t end) {
+    for (int addr = start; addr <= end; addr++) {
+        bits_[addr >> 6] |= std::uint64_t(1) << (addr & 63);
+    }
+}
+
+std::size_t CoverageMap::coveredBytes() const {
+    std::size_t count = 0;
+    for (std::uint64_t word : bits_) {
+        count += std::popcount(word);
+    }
+    return count;
+}
+
+void CoverageMap::merge(const CoverageMap& other) {
+    for (std::size_t i = 0; i < kWords; i++) {
+        bits_[i] |= other.bits_[i];
+    }
+}
+
+std::vector<CodeBlock> Coverage::codeBlocks(Cpu cpu, const std::vector<std::uint8_t>& memory, std::uint16_t start, std::uint16_t end) {
+    std::unique_ptr<Disassembler> disassembler = Disassembler::forCpu(cpu);
+
+    std::vector<CodeBlock> blocks;
+    int blockStart = start;
+    int pos = start;
+    while (pos <= end && blocks.size() < kMaxBlocks) {
+        Disassembler::Instructions instrs = disassembler->decodeForward(pos, memory, kLinesPerChunk);
+        if (instrs.empty()) {
+            break;
+        }
+        for (int i = 0; i < instrs.size(); i++) {
+            pos = instrs.end(i);
+            bool isLast = pos > end;
+            if (isLast || disassembler->isControlTransfer(instrs[i])) {
+                blocks.push_back(CodeBlock{(std::uint16_t)blockStart, (std::uint16_t)std::min(pos - 1, 0xffff)});
+                blockStart = pos;
+            }
+            if (isLast || blocks.size() == kMaxBlocks) {
+                break;
+            }
+        }
+    }
+    return blocks;
+}
+
+void Coverage::mark(std::uint16_t bankId, const CodeBlock& block) {
+    banks_[bankId].mark(block.start, block.end);
+}
+
+const CoverageMap* Coverage::bank(std::uint16_t bankId) const {
+    auto it = banks_.find(bankId);
+    return it != banks_.end() ? &it->second : nullptr;
+}
+
+std::size_t Coverage::coveredBytes() const {
+    std::size_t count = 0;
+    for (const auto& [bankId, map] : banks_) {
+        count += map.coveredBytes();
+    }
+    return count;
+}
+
+void Coverage::merge(const Coverage& other) {
+    for (const auto& [bankId, map] : other.banks_) {
+        banks_[bankId].merge(map);
+    }
+}
+
+void Coverage::write(std::ostream& os) const {
+    os.write(kMagic, sizeof(kMagic) - 1);
+    writeLittleEndian<std::uint16_t>(os, banks_.size());
+    for (const auto& [bankId, map] : banks_) {
+        writeLittleEndian(os, bankId);
+        for (int addr = 0; addr < 0x10000; addr += 8) {
+            std::uint8_t byte = 0;
+            for (int bit = 0; bit < 8; bit++) {
+                byte |= map.isCovered(addr + bit) << bit;
+            }
+            os.put((char)byte);
+        }
+    }
+}
+
+std::optional<Coverage> Coverage::read(std::istream& is, std::string& error) {
+    char magic[sizeof(kMagic) - 1];
+    if (!is.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), kMagic)) {
+        error = "Not a coverage file";
+        return std::nullopt;
+    }
+    std::uint16_t nofBanks;
+    if (!readU16(is, nofBanks)) {
+        error = "Truncated coverage file";
+        return std::nullopt;
+    }
+    Coverage coverage;
+    std::vector<std::uint8_t> bitmap(kBitmapSize);
+    for (int i = 0; i < nofBanks; i++) {
+        std::uint16_t bankId;
+        if (!readU16(is, bankId) || !is.read((char*)bitmap.data(), bitmap.size())) {
+            error = "Truncated coverage file";
+            return std::nullopt;
+        }
+        CoverageMap& map = coverage.banks_[bankId];
+        for (int addr = 0; addr < 0x10000; addr++) {
+            if ((bitmap[addr >> 3] >> (addr & 7)) & 1) {
+                map.mark(addr, addr);
+            }
+        }
+    }
+    return coverage;
+}
+
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <istream>
+#include <map>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "machinestate.h"
+
+namespace vicedebug {
+
+// Instructions that run one after the other: only the last one may jump
+// away. VICE counts the instructions executed in a checkpoint's range, so a
+// hit in a block's range means the block ran, as long as nothing jumps into
+// its middle.
+struct CodeBlock {
+    std::uint16_t start;
+    std::uint16_t end; // Last byte of the last instruction
+};
+
+// One bit per address of a bank, set for the bytes of instructions that ran.
+class CoverageMap {
+public:
+    static constexpr const std::size_t kWords = 0x10000 / 64;
+
+    void mark(std::uint16_t start, std::uint16_t end);
+
+    bool isCovered(std::uint16_t addr) const {
+        return (bits_[addr >> 6] >> (addr & 63)) & 1;
+    }
+
+    std::size_t coveredBytes() const;
+
+    void merge(const CoverageMap& other);
+
+    bool operator==(const CoverageMap& other) const = default;
+
+private:
+    std::array<std::uint64_t, kWords> bits_ = {};
+};
+
+// The coverage maps of all banks that have covered code.
+class Coverage {
+public:
+    // Every armed checkpoint slows VICE down a bit, so the number of blocks is capped.
+    static constexpr const std::size_t kMaxBlocks = 4096;
+
+    // Disassembles memory from start to end, and splits the instructions into
+    // blocks, at most kMaxBlocks. Data in the range just results in blocks
+    // that are never hit.
+    static std::vector<CodeBlock> codeBlocks(Cpu cpu, const std::vector<std::uint8_t>& memory, std::uint16_t start, std::uint16_t end);
+
+    void mark(std::uint16_t bankId, const CodeBlock& block);
+
+    // nullptr if nothing in the bank is covered.
+    const CoverageMap* bank(std::uint16_t bankId) const;
+
+    const std::map<std::uint16_t, CoverageMap>& banks() const {
+        return banks_;
+    }
+
+    std::size_t coveredBytes() const;
+
+    // Adds the coverage of another run.
+    void merge(const Coverage& other);
+
+    void clear() {
+        banks_.clear();
+    }
+
+    // Little endian:
+    //
+    //     "VDCOVER1", u16 nofBanks, (u16 bank ID, 8K bitmap)...
+    //
+    // Bit n of the bitmap's byte m is address 8 * m + n.
+    void write(std::ostream& os) const;
+
+    // Empty, with error set, if the data is not a coverage file.
+    static std::optional<Coverage> read(std::istream& is, std::string& error);
+
+private:
+    std::map<std::uint16_t, CoverageMap> banks_;
+};
+
+}
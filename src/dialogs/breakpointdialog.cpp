@@ -40,6 +40,14 @@ BreakpointDialog::BreakpointDialog(Breakpoint breakpoint, SymTable *symtab, QWid
     typeExecute_->setChecked(breakpoint.op & Breakpoint::Type::EXEC);
     typeRead_->setChecked(breakpoint.op & Breakpoint::Type::READ);
     typeWrite_->setChecked(breakpoint.op & Breakpoint::Type::WRITE);
+    condition_->setText(QString::fromStdString(breakpoint.condition));
+    if (breakpoint.hasCondition && breakpoint.condition.empty()) {
+        condition_->setPlaceholderText(tr("Set in VICE; not known here, re-enter it to keep it"));
+    }
+    if (breakpoint.trace.has_value()) {
+        traceGroup_->setChecked(true);
+        traceSpec_->setText(QString::fromStdString(breakpoint.trace->toString()));
+    }
     setWindowTitle("Edit breakpoint...");
 }
 
@@ -69,6 +77,27 @@ void BreakpointDialog::setupUI() {
     QGroupBox* typeGroup = new QGroupBox(tr("Break on..."));
     typeGroup->setLayout(typeGroupLayout);
 
+    condition_ = new QLineEdit();
+    condition_->setMaxLength(255);
+    condition_->setToolTip(tr("Evaluated by VICE, e.g. \"A == $ff\" or \"X > $10 && @cpu:$d020 == 0\".\nLeave empty to always break."));
+    QHBoxLayout* conditionLayout = new QHBoxLayout();
+    conditionLayout->addWidget(condition_);
+    QGroupBox* conditionGroup = new QGroupBox(tr("Only if..."));
+    conditionGroup->setLayout(conditionLayout);
+
+    traceSpec_ = new QLineEdit();
+    traceSpec_->setPlaceholderText("A X Y [$d020] [$fb-$fe]");
+    traceSpec_->setToolTip(tr("Registers and memory to record on every hit"));
+    connect(traceSpec_, &QLineEdit::textChanged, this, &BreakpointDialog::enableControls);
+    QHBoxLayout* traceLayout = new QHBoxLayout();
+    traceLayout->addWidget(new QLabel("Record "));
+    traceLayout->addWidget(traceSpec_);
+    traceGroup_ = new QGroupBox(tr("Log and continue..."));
+    traceGroup_->setCheckable(true);
+    traceGroup_->setChecked(false);
+    traceGroup_->setLayout(traceLayout);
+    connect(traceGroup_, &QGroupBox::toggled, this, &BreakpointDialog::enableControls);
+
     QHBoxLayout* addrRangeLayout = new QHBoxLayout();
     addrRangeLayout->addWidget(new QLabel("From "));
     addrRangeLayout->addWidget(addrStart_);
@@ -92,6 +121,8 @@ void BreakpointDialog::setupUI() {
 
     vLayout->addWidget(addrRangeGroup);
     vLayout->addWidget(typeGroup);
+    vLayout->addWidget(conditionGroup);
+    vLayout->addWidget(traceGroup_);
     vLayout->addSpacing(10);
     vLayout->addLayout(buttons);
 
@@ -126,27 +157,34 @@ std::uint16_t BreakpointDialog::parseAddress(QString str, bool& ok) {
 void BreakpointDialog::enableControls() {
     cancelBtn_->setEnabled(true);
 
+    bool traceSpecIsValid = true;
+    if (traceGroup_->isChecked()) {
+        std::string error;
+        traceSpecIsValid = TraceSpec::parse(traceSpec_->text().toStdString(), error).has_value();
+        traceSpec_->setToolTip(traceSpecIsValid ? tr("Registers and memory to record on every hit") : QString::fromStdString(error));
+    }
+    okBtn_->setEnabled(addressRangeIsValid() && traceSpecIsValid);
+}
+
+bool BreakpointDialog::addressRangeIsValid() {
     QString addrStartStr = addrStart_->text().trimmed();
     QString addrEndStr = addrEnd_->text().trimmed();
 
     bool ok;
     std::uint16_t addrStart = parseAddress(addrStartStr, ok);
     if (!ok) {
-        okBtn_->setEnabled(false);
-        return;
+        return false;
     }
 
     if (addrEndStr.length() == 0) {
-        okBtn_->setEnabled(true);
-        return;
+        return true;
     }
 
     std::uint16_t addrEnd = parseAddress(addrEndStr, ok);
     if (!ok) {
-        okBtn_->setEnabled(false);
-        return;
+        return false;
     }
-    okBtn_->setEnabled(addrEnd >= addrStart);
+    return addrEnd >= addrStart;
 }
 
 void BreakpointDialog::fillBreakpoint() {
@@ -159,6 +197,13 @@ void BreakpointDialog::fillBreakpoint() {
     bp_.op = (typeExecute_->isChecked() ? Breakpoint::Type::EXEC : 0)
             | (typeRead_->isChecked() ? Breakpoint::Type::READ : 0)
             | (typeWrite_->isChecked() ? Breakpoint::Type::WRITE : 0);
+    bp_.condition = condition_->text().trimmed().toStdString();
+    bp_.hasCondition = !bp_.condition.empty();
+    bp_.trace.reset();
+    if (traceGroup_->isChecked()) {
+        std::string error;
+        bp_.trace = TraceSpec::parse(traceSpec_->text().toStdString(), error);
+    }
 }
 
 }
@@ -22,6 +22,7 @@
 #include <QDialog>
 #include <QLineEdit>
 #include <QCheckBox>
+#include <QGroupBox>
 
 #include "breakpoints.h"
 #include "symtab.h"
@@ -42,6 +43,7 @@ private:
     void setupUI();
     std::uint16_t parseAddress(QString str, bool& ok);
     void enableControls();
+    bool addressRangeIsValid();
     void fillBreakpoint();
 
     QLineEdit* addrStart_;
@@ -49,6 +51,9 @@ private:
     QCheckBox* typeExecute_;
     QCheckBox* typeRead_;
     QCheckBox* typeWrite_;
+    QLineEdit* condition_;
+    QGroupBox* traceGroup_;
+    QLineEdit* traceSpec_;
 
     QPushButton* okBtn_;
     QPushButton* cancelBtn_;
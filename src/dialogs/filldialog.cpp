@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "filldialog.h"
+
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QLabel>
+
+namespace vicedebug {
+
+FillDialog::FillDialog(std::uint16_t start, QWidget* parent)
+    : QDialog(parent), start_(start), end_(start), value_(0) {
+    setupUI();
+    startEdit_->setText(QString::asprintf("%04X", start));
+    endEdit_->setText(QString::asprintf("%04X", start));
+    valueEdit_->setText("00");
+    setWindowTitle("Fill memory...");
+}
+
+void FillDialog::setupUI() {
+    QVBoxLayout* vLayout = new QVBoxLayout();
+
+    auto makeEdit = [this](const char* sizeText) {
+        QLineEdit* edit = new QLineEdit();
+        edit->setMaxLength(6);
+        QFontMetrics fm = edit->fontMetrics();
+        edit->setFixedWidth(fm.boundingRect(sizeText).width() + 10); // some slack
+        connect(edit, &QLineEdit::textChanged, this, &FillDialog::enableControls);
+        return edit;
+    };
+    startEdit_ = makeEdit("0000");
+    endEdit_ = makeEdit("0000");
+    valueEdit_ = makeEdit("0000");
+
+    QHBoxLayout* elements = new QHBoxLayout();
+    elements->addWidget(new QLabel("From:"));
+    elements->addWidget(startEdit_);
+    elements->addWidget(new QLabel("To:"));
+    elements->addWidget(endEdit_);
+    elements->addWidget(new QLabel("Value:"));
+    elements->addWidget(valueEdit_);
+
+    QHBoxLayout* buttons = new QHBoxLayout();
+    okBtn_ = new QPushButton("Ok");
+    connect(okBtn_, &QPushButton::clicked, this, &QDialog::accept);
+    cancelBtn_ = new QPushButton("Cancel");
+    connect(cancelBtn_, &QPushButton::clicked, this, &QDialog::reject);
+    buttons->addStretch();
+    buttons->addWidget(okBtn_);
+    buttons->addWidget(cancelBtn_);
+
+    vLayout->addLayout(elements);
+    vLayout->addSpacing(10);
+    vLayout->addLayout(buttons);
+
+    setLayout(vLayout);
+}
+
+std::uint16_t FillDialog::parseInt(QString str, int defaultBase, bool& ok) {
+    str = str.trimmed();
+    if (str.length() == 0) {
+        ok = false;
+        return 0;
+    }
+    int base = defaultBase;
+    if (str[0] == '+') {
+        str = str.mid(1);
+        base = 10;
+    } else if (str[0] == '$') {
+        str = str.mid(1);
+        base = 16;
+    }
+    uint res = str.toUInt(&ok, base);
+    if (res > 0xffff) {
+        res = 0;
+        ok = false;
+    }
+    return res;
+}
+
+void FillDialog::enableControls() {
+    bool startOk, endOk, valueOk;
+    std::uint16_t start = parseInt(startEdit_->text(), 16, startOk);
+    std::uint16_t end = parseInt(endEdit_->text(), 16, endOk);
+    std::uint16_t value = parseInt(valueEdit_->text(), 16, valueOk);
+    bool ok = startOk && endOk && valueOk && start <= end && value <= 0xff;
+    if (ok) {
+        start_ = start;
+        end_ = end;
+        value_ = value;
+    }
+    okBtn_->setEnabled(ok);
+}
+
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <QDialog>
+#include <QLineEdit>
+#include <QPushButton>
+
+namespace vicedebug {
+
+// Asks for a memory range and the byte to fill it with.
+class FillDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit FillDialog(std::uint16_t start, QWidget* parent);
+
+    std::uint16_t start() const { return start_; }
+    std::uint16_t end() const { return end_; }
+    std::uint8_t value() const { return value_; }
+
+private:
+    void setupUI();
+    std::uint16_t parseInt(QString str, int defaultBase, bool& ok);
+    void enableControls();
+
+    QLineEdit* startEdit_;
+    QLineEdit* endEdit_;
+    QLineEdit* valueEdit_;
+
+    QPushButton* okBtn_;
+    QPushButton* cancelBtn_;
+
+    std::uint16_t start_;
+    std::uint16_t end_;
+    std::uint8_t value_;
+};
+
+}
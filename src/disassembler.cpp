@@ -22,20 +22,147 @@
 #include <string>
 #include <QString>
 
+#include "disassembler_6502.h"
+#include "disassembler_z80.h"
+
 namespace vicedebug {
 
-std::vector<Disassembler::Line> Disassembler::disassembleForward(std::uint16_t pos, const std::vector<std::uint8_t>& memory, int lines) {
-    std::vector<Line> res;
+void Disassembler::Instructions::push_back(const Decoded& instr) {
+    addr.push_back(instr.addr);
+    length.push_back(instr.length);
+    opcode.push_back(instr.opcode);
+    operand.push_back(instr.operand);
+    mode.push_back(instr.mode);
+    minCycles.push_back(instr.minCycles);
+    maxCycles.push_back(instr.maxCycles);
+}
+
+void Disassembler::Instructions::insert(std::size_t pos, const Instructions& other) {
+    addr.insert(addr.begin() + pos, other.addr.begin(), other.addr.end());
+    length.insert(length.begin() + pos, other.length.begin(), other.length.end());
+    opcode.insert(opcode.begin() + pos, other.opcode.begin(), other.opcode.end());
+    operand.insert(operand.begin() + pos, other.operand.begin(), other.operand.end());
+    mode.insert(mode.begin() + pos, other.mode.begin(), other.mode.end());
+    minCycles.insert(minCycles.begin() + pos, other.minCycles.begin(), other.minCycles.end());
+    maxCycles.insert(maxCycles.begin() + pos, other.maxCycles.begin(), other.maxCycles.end());
+}
+
+void Disassembler::Instructions::erase(std::size_t first, std::size_t last) {
+    addr.erase(addr.begin() + first, addr.begin() + last);
+    length.erase(length.begin() + first, length.begin() + last);
+    opcode.erase(opcode.begin() + first, opcode.begin() + last);
+    operand.erase(operand.begin() + first, operand.begin() + last);
+    mode.erase(mode.begin() + first, mode.begin() + last);
+    minCycles.erase(minCycles.begin() + first, minCycles.begin() + last);
+    maxCycles.erase(maxCycles.begin() + first, maxCycles.begin() + last);
+}
+
+void Disassembler::Instructions::clear() {
+    erase(0, size());
+}
+
+std::unique_ptr<Disassembler> Disassembler::forCpu(Cpu cpu) {
+    auto noSymbols = std::make_unique<SymTable>();
+    std::unique_ptr<Disassembler> disassembler;
+    if (cpu == Cpu::Z80) {
+        disassembler = std::make_unique<DisassemblerZ80>(noSymbols.get());
+    } else {
+        disassembler = std::make_unique<Disassembler6502>(noSymbols.get());
+    }
+    disassembler->noSymbols_ = std::move(noSymbols);
+    return disassembler;
+}
 
-    while(lines-- > 0 && (0 < pos && pos < memory.size())) {
-        std::uint16_t oldpos = pos;
-        res.push_back(disassembleLine(pos, memory));
-        if (pos < oldpos) {
+Disassembler::Instructions Disassembler::decodeForward(std::uint16_t pos, const std::vector<std::uint8_t>& memory, int lines) const {
+    Instructions res;
+
+    while(lines-- > 0 && pos < memory.size()) {
+        Decoded instr = decode(pos, memory);
+        res.push_back(instr);
+        if (pos + instr.length > 0xffff) {
             // overflow
             break;
         }
+        pos += instr.length;
+    }
+    return res;
+}
+
+std::vector<Disassembler::Line> Disassembler::disassembleForward(std::uint16_t pos, const std::vector<std::uint8_t>& memory, int lines) const {
+    Instructions instrs = decodeForward(pos, memory, lines);
+    std::vector<Line> res;
+    for (int i = 0; i < instrs.size(); i++) {
+        res.push_back(toLine(instrs[i], memory));
+    }
+    return res;
+}
+
+std::vector<Disassembler::Line> Disassembler::disassembleBackward(std::uint16_t pos, const std::vector<std::uint8_t>& memory, int lines, const InstructionBoundaryMap* boundaries) const {
+    Instructions instrs = decodeBackward(pos, memory, lines, boundaries);
+    std::vector<Line> res;
+    for (int i = 0; i < instrs.size(); i++) {
+        res.push_back(toLine(instrs[i], memory));
     }
     return res;
 }
 
+bool Disassembler::isControlTransfer(const Line& line) const {
+    // Decode the line's bytes again. Padded, so that decoding never reads past them.
+    std::vector<std::uint8_t> bytes(line.bytes);
+    bytes.resize(InstructionBoundaryMap::kMaxInstructionLength + 1);
+    return isControlTransfer(decode(0, bytes));
+}
+
+Disassembler::Line Disassembler::toLine(const Decoded& instr, const std::vector<std::uint8_t>& memory) const {
+    Line res;
+    res.addr = instr.addr;
+    for (int i = 0; i < instr.length; i++) {
+        res.bytes.push_back(memory[(instr.addr + i) % 0xffff]);
+    }
+    res.disassembly = format(instr);
+    res.minCycles = instr.minCycles;
+    res.maxCycles = instr.maxCycles;
+    return res;
+}
+
+std::optional<std::uint16_t> Disassembler::knownInstructionBefore(std::uint16_t pos, const InstructionBoundaryMap* boundaries) {
+    if (boundaries == nullptr) {
+        return std::nullopt;
+    }
+    for (int len = 1; len <= InstructionBoundaryMap::kMaxInstructionLength && len <= pos; len++) {
+        if (boundaries->lengthAt(pos - len) == len) {
+            return pos - len;
+        }
+    }
+    return std::nullopt;
+}
+
+CachedFormatter::CachedFormatter() {
+}
+
+void CachedFormatter::setDisassembler(std::shared_ptr<Disassembler> disassembler) {
+    if (disassembler != disassembler_) {
+        disassembler_ = disassembler;
+        clear();
+    }
+}
+
+const std::string& CachedFormatter::format(const Disassembler::Decoded& instr) {
+    // Everything the text depends on, except for the labels.
+    std::uint64_t key = (std::uint64_t)instr.addr << 48 | (std::uint64_t)instr.opcode << 32
+            | (std::uint64_t)instr.operand << 16 | (std::uint64_t)instr.length << 8 | instr.mode;
+    auto it = texts_.find(key);
+    if (it != texts_.end()) {
+        return it->second;
+    }
+    if (texts_.size() >= kMaxEntries) {
+        clear();
+    }
+    return texts_.emplace(key, disassembler_->format(instr)).first->second;
+}
+
+void CachedFormatter::clear() {
+    texts_.clear();
+}
+
 }
@@ -23,7 +23,12 @@
 #include <vector>
 #include <cstdint>
 #include <memory>
+#include <optional>
+#include <unordered_map>
+#include <utility>
 
+#include "instructionboundarymap.h"
+#include "machinestate.h"
 #include "symtab.h"
 
 namespace vicedebug {
@@ -34,19 +39,149 @@ public:
         std::uint16_t addr;
         std::vector<std::uint8_t> bytes;
         std::string disassembly;
+        // Clock cycles: minCycles without and maxCycles with the penalties
+        // for taken branches and crossed pages. 0 if the instruction never finishes.
+        int minCycles = 0;
+        int maxCycles = 0;
+    };
+
+    // Marks bytes that are no instruction, shown as "???".
+    static constexpr const std::uint16_t kUndecoded = 0xffff;
+
+    // An instruction without its text. opcode and mode are the decoder's own:
+    // an index into its instruction tables, and the kind of operand.
+    struct Decoded {
+        std::uint16_t addr = 0;
+        std::uint8_t length = 1;
+        std::uint16_t opcode = kUndecoded;
+        std::uint16_t operand = 0;
+        std::uint8_t mode = 0;
+        std::uint8_t minCycles = 0;
+        std::uint8_t maxCycles = 0;
+    };
+
+    // Decoded instructions in parallel arrays, in the order they were decoded.
+    struct Instructions {
+        std::vector<std::uint16_t> addr;
+        std::vector<std::uint8_t> length;
+        std::vector<std::uint16_t> opcode;
+        std::vector<std::uint16_t> operand;
+        std::vector<std::uint8_t> mode;
+        std::vector<std::uint8_t> minCycles;
+        std::vector<std::uint8_t> maxCycles;
+
+        std::size_t size() const {
+            return addr.size();
+        }
+
+        bool empty() const {
+            return addr.empty();
+        }
+
+        Decoded operator[](std::size_t i) const {
+            return Decoded{addr[i], length[i], opcode[i], operand[i], mode[i], minCycles[i], maxCycles[i]};
+        }
+
+        // Address after the instruction
+        int end(std::size_t i) const {
+            return addr[i] + length[i];
+        }
+
+        void push_back(const Decoded& instr);
+        void insert(std::size_t pos, const Instructions& other);
+        void erase(std::size_t first, std::size_t last);
+        void clear();
+    };
+
+    struct CycleTotals {
+        int minCycles = 0;
+        int maxCycles = 0;
+        int instructions = 0;
     };
 
     explicit Disassembler(SymTable* symtab) : symtab_(symtab) {}
     virtual ~Disassembler() = default;
 
-    virtual std::vector<Line> disassembleForward(std::uint16_t pos, const std::vector<std::uint8_t>& memory, int lines);
+    // A disassembler for cpu without any labels, for when only the
+    // instructions matter, not their text.
+    static std::unique_ptr<Disassembler> forCpu(Cpu cpu);
+
+    Instructions decodeForward(std::uint16_t pos, const std::vector<std::uint8_t>& memory, int lines) const;
+
+    // Instructions known from boundaries are used as they are, the others are guessed. boundaries may be nullptr.
+    virtual Instructions decodeBackward(std::uint16_t pos, const std::vector<std::uint8_t>& memory, int lines, const InstructionBoundaryMap* boundaries) const = 0;
 
-    virtual std::vector<Line> disassembleBackward(std::uint16_t pos, const std::vector<std::uint8_t>& memory, int lines, const std::vector<Disassembler::Line>& disassemblyHint) = 0;
+    // Text of instr, with labels for the addresses it uses.
+    virtual std::string format(const Decoded& instr) const = 0;
+
+    // decodeForward and decodeBackward, formatted.
+    std::vector<Line> disassembleForward(std::uint16_t pos, const std::vector<std::uint8_t>& memory, int lines) const;
+    std::vector<Line> disassembleBackward(std::uint16_t pos, const std::vector<std::uint8_t>& memory, int lines, const InstructionBoundaryMap* boundaries) const;
+
+    // True if execution may continue somewhere else than at the next instruction: jumps, branches, calls, returns.
+    virtual bool isControlTransfer(const Decoded& instr) const = 0;
+    bool isControlTransfer(const Line& line) const;
+
+    // Sums up the cycles of lines[first] to lines[last]. Lines is std::vector<Line> or Instructions.
+    template<typename Lines>
+    static CycleTotals cycleTotals(const Lines& lines, int first, int last) {
+        CycleTotals totals;
+        for (int i = first; i <= last; i++) {
+            totals.minCycles += lines[i].minCycles;
+            totals.maxCycles += lines[i].maxCycles;
+            totals.instructions++;
+        }
+        return totals;
+    }
+
+    // First and last index of the basic block lines[line] is in: it starts
+    // after a control transfer, and ends with the next one.
+    template<typename Lines>
+    std::pair<int, int> basicBlock(const Lines& lines, int line) const {
+        int first = line;
+        while (first > 0 && !isControlTransfer(lines[first - 1])) {
+            first--;
+        }
+        int last = line;
+        while (last < (int)lines.size() - 1 && !isControlTransfer(lines[last])) {
+            last++;
+        }
+        return {first, last};
+    }
 
 protected:
-    virtual Line disassembleLine(std::uint16_t& pos, const std::vector<std::uint8_t>& memory) = 0;
+    // Decodes the instruction at pos.
+    virtual Decoded decode(std::uint16_t pos, const std::vector<std::uint8_t>& memory) const = 0;
+
+    Line toLine(const Decoded& instr, const std::vector<std::uint8_t>& memory) const;
+
+    // Start of the instruction that ends right before pos, if boundaries knows it.
+    static std::optional<std::uint16_t> knownInstructionBefore(std::uint16_t pos, const InstructionBoundaryMap* boundaries);
 
     SymTable* symtab_;
+
+private:
+    std::unique_ptr<SymTable> noSymbols_; // Set by forCpu()
+};
+
+// Formats instructions with a Disassembler, and keeps the texts. Drawing a
+// line again, or scrolling back to it, doesn't format it again.
+class CachedFormatter {
+public:
+    // The cache is emptied when it is full.
+    static constexpr const std::size_t kMaxEntries = 4096;
+
+    CachedFormatter();
+
+    // Empties the cache if disassembler is a different one.
+    void setDisassembler(std::shared_ptr<Disassembler> disassembler);
+    const std::string& format(const Disassembler::Decoded& instr);
+    // To be called when the labels change.
+    void clear();
+
+private:
+    std::shared_ptr<Disassembler> disassembler_;
+    std::unordered_map<std::uint64_t, std::string> texts_;
 };
 
 }
@@ -19,6 +19,8 @@
 
 #include "disassembler_6502.h"
 
+#include <algorithm>
+#include <limits>
 #include <string>
 #include <QString>
 
@@ -62,341 +64,407 @@ struct InstrDesc {
     std::string mnemo;
     AddressMode mode;
     bool illegal;
+    int cycles; // Without penalties. 0 for JAM, which never finishes.
+    bool pageCrossPenalty; // One more cycle if the indexed address is in the next page
 };
 
 InstrDesc instructions[256] = {
-    /* 0x00 */ {"BRK",AM_IMPLIED, false},
-    /* 0x01 */ {"ORA",AM_INDIRECT_X, false},
-    /* 0x02 */ {"JAM",AM_IMPLIED, true},
-    /* 0x03 */ {"SLO",AM_INDIRECT_X, true},
-    /* 0x04 */ {"NOOP",AM_ZERO_PAGE, true},
-    /* 0x05 */ {"ORA",AM_ZERO_PAGE, false},
-    /* 0x06 */ {"ASL",AM_ZERO_PAGE, false},
-    /* 0x07 */ {"SLO",AM_ZERO_PAGE, true},
-    /* 0x08 */ {"PHP",AM_IMPLIED, false},
-    /* 0x09 */ {"ORA",AM_IMMEDIATE, false},
-    /* 0x0a */ {"ASL",AM_ACCUMULATOR, false},
-    /* 0x0B */ {"ANC",AM_IMMEDIATE, true},
-    /* 0x0C */ {"NOOP",AM_ABSOLUTE, true},
-    /* 0x0d */ {"ORA",AM_ABSOLUTE, false},
-    /* 0x0e */ {"ASL",AM_ABSOLUTE, false},
-    /* 0x0F */ {"SLO",AM_ABSOLUTE, true},
-    /* 0x10 */ {"BPL",AM_RELATIVE, false},
-    /* 0x11 */ {"ORA",AM_INDIRECT_Y, false},
-    /* 0x12 */ {"JAM",AM_IMPLIED, true},
-    /* 0x13 */ {"SLO",AM_INDIRECT_Y, true},
-    /* 0x14 */ {"NOOP",AM_ZERO_PAGE_X, true},
-    /* 0x15 */ {"ORA",AM_ZERO_PAGE_X, false},
-    /* 0x16 */ {"ASL",AM_ZERO_PAGE_X, false},
-    /* 0x17 */ {"SLO",AM_ZERO_PAGE_X, true},
-    /* 0x18 */ {"CLC",AM_IMPLIED, false},
-    /* 0x19 */ {"ORA",AM_INDEXED_Y, false},
-    /* 0x1A */ {"NOOP",AM_IMPLIED, true},
-    /* 0x1B */ {"SLO",AM_INDEXED_Y, true},
-    /* 0x1C */ {"NOOP",AM_INDEXED_X, true},
-    /* 0x1d */ {"ORA",AM_INDEXED_X, false},
-    /* 0x1e */ {"ASL",AM_INDEXED_X, false},
-    /* 0x1F */ {"SLO",AM_INDEXED_X, true},
-    /* 0x20 */ {"JSR",AM_ABSOLUTE, false},
-    /* 0x21 */ {"AND",AM_INDIRECT_X, false},
-    /* 0x22 */ {"JAM",AM_IMPLIED, true},
-    /* 0x23 */ {"RLA",AM_INDIRECT_X, true},
-    /* 0x24 */ {"BIT",AM_ZERO_PAGE, false},
-    /* 0x25 */ {"AND",AM_ZERO_PAGE, false},
-    /* 0x26 */ {"ROL",AM_ZERO_PAGE, false},
-    /* 0x27 */ {"RLA",AM_ZERO_PAGE, true},
-    /* 0x28 */ {"PLP",AM_IMPLIED, false},
-    /* 0x29 */ {"AND",AM_IMMEDIATE, false},
-    /* 0x2a */ {"ROL",AM_ACCUMULATOR, false},
-    /* 0x2B */ {"ANC",AM_IMMEDIATE, true},
-    /* 0x2c */ {"BIT",AM_ABSOLUTE, false},
-    /* 0x2d */ {"AND",AM_ABSOLUTE, false},
-    /* 0x2e */ {"ROL",AM_ABSOLUTE, false},
-    /* 0x2F */ {"RLA",AM_ABSOLUTE, true},
-    /* 0x30 */ {"BMI",AM_RELATIVE, false},
-    /* 0x31 */ {"AND",AM_INDIRECT_Y, false},
-    /* 0x32 */ {"JAM",AM_IMPLIED, true},
-    /* 0x33 */ {"RLA",AM_INDIRECT_Y, true},
-    /* 0x34 */ {"NOOP",AM_ZERO_PAGE_X, true},
-    /* 0x35 */ {"AND",AM_ZERO_PAGE_X, false},
-    /* 0x36 */ {"ROL",AM_ZERO_PAGE_X, false},
-    /* 0x37 */ {"RLA",AM_ZERO_PAGE_X, true},
-    /* 0x38 */ {"SEC",AM_IMPLIED, false},
-    /* 0x39 */ {"AND",AM_INDEXED_Y, false},
-    /* 0x3A */ {"NOOP",AM_IMPLIED, true},
-    /* 0x3B */ {"RLA",AM_INDEXED_Y, true},
-    /* 0x3C */ {"NOOP",AM_INDEXED_X, true},
-    /* 0x3d */ {"AND",AM_INDEXED_X, false},
-    /* 0x3e */ {"ROL",AM_INDEXED_X, false},
-    /* 0x3F */ {"RLA",AM_INDEXED_X, true},
-    /* 0x40 */ {"RTI",AM_IMPLIED, false},
-    /* 0x41 */ {"EOR",AM_INDIRECT_X, false},
-    /* 0x42 */ {"JAM",AM_IMPLIED, true},
-    /* 0x43 */ {"SRE",AM_INDIRECT_X, true},
-    /* 0x44 */ {"NOOP",AM_ZERO_PAGE, true},
-    /* 0x45 */ {"EOR",AM_ZERO_PAGE, false},
-    /* 0x46 */ {"LSR",AM_ZERO_PAGE, false},
-    /* 0x47 */ {"SRE",AM_ZERO_PAGE, true},
-    /* 0x48 */ {"PHA",AM_IMPLIED, false},
-    /* 0x49 */ {"EOR",AM_IMMEDIATE, false},
-    /* 0x4a */ {"LSR",AM_ACCUMULATOR, false},
-    /* 0x4B */ {"ALR",AM_IMMEDIATE, true},
-    /* 0x4c */ {"JMP",AM_ABSOLUTE, false},
-    /* 0x4d */ {"EOR",AM_ABSOLUTE, false},
-    /* 0x4e */ {"LSR",AM_ABSOLUTE, false},
-    /* 0x4F */ {"SRE",AM_ABSOLUTE, true},
-    /* 0x50 */ {"BVC",AM_RELATIVE, false},
-    /* 0x51 */ {"EOR",AM_INDIRECT_Y, false},
-    /* 0x52 */ {"JAM",AM_IMPLIED, true},
-    /* 0x53 */ {"SRE",AM_INDIRECT_Y, true},
-    /* 0x54 */ {"NOOP",AM_ZERO_PAGE_X, true},
-    /* 0x55 */ {"EOR",AM_ZERO_PAGE_X, false},
-    /* 0x56 */ {"LSR",AM_ZERO_PAGE_X, false},
-    /* 0x57 */ {"SRE",AM_ZERO_PAGE_X, true},
-    /* 0x58 */ {"CLI",AM_IMPLIED, false},
-    /* 0x59 */ {"EOR",AM_INDEXED_Y, false},
-    /* 0x5A */ {"NOOP",AM_IMPLIED, true},
-    /* 0x5B */ {"SRE",AM_INDEXED_Y, true},
-    /* 0x5C */ {"NOOP",AM_INDEXED_X, true},
-    /* 0x5d */ {"EOR",AM_INDEXED_X, false},
-    /* 0x5e */ {"LSR",AM_INDEXED_X, false},
-    /* 0x5F */ {"SRE",AM_INDEXED_X, true},
-    /* 0x60 */ {"RTS",AM_IMPLIED, false},
-    /* 0x61 */ {"ADC",AM_INDIRECT_X, false},
-    /* 0x62 */ {"JAM",AM_IMPLIED, true},
-    /* 0x63 */ {"RRA",AM_INDIRECT_X, true},
-    /* 0x64 */ {"NOOP",AM_ZERO_PAGE, true},
-    /* 0x65 */ {"ADC",AM_ZERO_PAGE, false},
-    /* 0x66 */ {"ROR",AM_ZERO_PAGE, false},
-    /* 0x67 */ {"RRA",AM_ZERO_PAGE, true},
-    /* 0x68 */ {"PLA",AM_IMPLIED, false},
-    /* 0x69 */ {"ADC",AM_IMMEDIATE, false},
-    /* 0x6a */ {"ROR",AM_ACCUMULATOR, false},
-    /* 0x6B */ {"ARR",AM_IMMEDIATE, true},
-    /* 0x6c */ {"JMP",AM_INDIRECT, false},
-    /* 0x6d */ {"ADC",AM_ABSOLUTE, false},
-    /* 0x6e */ {"ROR",AM_INDEXED_X, false},
-    /* 0x6F */ {"RRA",AM_ABSOLUTE, true},
-    /* 0x70 */ {"BVS",AM_RELATIVE, false},
-    /* 0x71 */ {"ADC",AM_INDIRECT_Y, false},
-    /* 0x72 */ {"JAM",AM_IMPLIED, true},
-    /* 0x73 */ {"RRA",AM_INDIRECT_Y, true},
-    /* 0x74 */ {"NOOP",AM_ZERO_PAGE_X, true},
-    /* 0x75 */ {"ADC",AM_ZERO_PAGE_X, false},
-    /* 0x76 */ {"ROR",AM_ZERO_PAGE_X, false},
-    /* 0x77 */ {"RRA",AM_ZERO_PAGE_X, true},
-    /* 0x78 */ {"SEI",AM_IMPLIED, false},
-    /* 0x79 */ {"ADC",AM_INDEXED_Y, false},
-    /* 0x7A */ {"NOOP",AM_IMPLIED, true},
-    /* 0x7B */ {"RRA",AM_INDEXED_Y, true},
-    /* 0x7C */ {"NOOP",AM_INDEXED_X, true},
-    /* 0x7d */ {"ADC",AM_INDEXED_X, false},
-    /* 0x7e */ {"ROR",AM_ABSOLUTE, false},
-    /* 0x7F */ {"RRA",AM_INDEXED_X, true},
-    /* 0x80 */ {"NOOP",AM_IMMEDIATE, true},
-    /* 0x81 */ {"STA",AM_INDIRECT_X, false},
-    /* 0x82 */ {"NOOP",AM_IMMEDIATE, true},
-    /* 0x83 */ {"SAX",AM_INDIRECT_X, true},
-    /* 0x84 */ {"STY",AM_ZERO_PAGE, false},
-    /* 0x85 */ {"STA",AM_ZERO_PAGE, false},
-    /* 0x86 */ {"STX",AM_ZERO_PAGE, false},
-    /* 0x87 */ {"SAX",AM_ZERO_PAGE, true},
-    /* 0x88 */ {"DEY",AM_IMPLIED, false},
-    /* 0x89 */ {"NOOP",AM_IMMEDIATE, true},
-    /* 0x8a */ {"TXA",AM_IMPLIED, false},
-    /* 0x8B */ {"ANE",AM_IMMEDIATE, true},
-    /* 0x8c */ {"STY",AM_ABSOLUTE, false},
-    /* 0x8d */ {"STA",AM_ABSOLUTE, false},
-    /* 0x8e */ {"STX",AM_ABSOLUTE, false},
-    /* 0x8F */ {"SAX",AM_ABSOLUTE, true},
-    /* 0x90 */ {"BCC",AM_RELATIVE, false},
-    /* 0x91 */ {"STA",AM_INDIRECT_Y, false},
-    /* 0x92 */ {"JAM",AM_IMPLIED, true},
-    /* 0x93 */ {"SHA",AM_INDIRECT_Y, true},
-    /* 0x94 */ {"STY",AM_ZERO_PAGE_X, false},
-    /* 0x95 */ {"STA",AM_ZERO_PAGE_X, false},
-    /* 0x96 */ {"STX",AM_ZERO_PAGE_Y, false},
-    /* 0x97 */ {"SAX",AM_ZERO_PAGE_Y, true},
-    /* 0x98 */ {"TYA",AM_IMPLIED, false},
-    /* 0x99 */ {"STA",AM_INDEXED_Y, false},
-    /* 0x9a */ {"TXS",AM_IMPLIED, false},
-    /* 0x9B */ {"TAS",AM_INDEXED_Y, true},
-    /* 0x9C */ {"SHY",AM_INDEXED_X, true},
-    /* 0x9d */ {"STA",AM_INDEXED_X, false},
-    /* 0x9E */ {"SHX",AM_INDEXED_Y, true},
-    /* 0x9F */ {"SHA",AM_INDEXED_Y, true},
-    /* 0xa0 */ {"LDY",AM_IMMEDIATE, false},
-    /* 0xa1 */ {"LDA",AM_INDIRECT_X, false},
-    /* 0xa2 */ {"LDX",AM_IMMEDIATE, false},
-    /* 0xA3 */ {"LAX",AM_INDIRECT_X, true},
-    /* 0xa4 */ {"LDY",AM_ZERO_PAGE, false},
-    /* 0xa5 */ {"LDA",AM_ZERO_PAGE, false},
-    /* 0xa6 */ {"LDX",AM_ZERO_PAGE, false},
-    /* 0xA7 */ {"LAX",AM_ZERO_PAGE, true},
-    /* 0xa8 */ {"TAY",AM_IMPLIED, false},
-    /* 0xa9 */ {"LDA",AM_IMMEDIATE, false},
-    /* 0xaa */ {"TAX",AM_IMPLIED, false},
-    /* 0xAB */ {"LXA",AM_IMMEDIATE, true},
-    /* 0xac */ {"LDY",AM_ABSOLUTE, false},
-    /* 0xad */ {"LDA",AM_ABSOLUTE, false},
-    /* 0xae */ {"LDX",AM_ABSOLUTE, false},
-    /* 0xAF */ {"LAX",AM_ABSOLUTE, true},
-    /* 0xB0 */ {"BCS",AM_RELATIVE, false},
-    /* 0xb1 */ {"LDA",AM_INDIRECT_Y, false},
-    /* 0xB2 */ {"JAM",AM_IMPLIED, true},
-    /* 0xB3 */ {"LAX",AM_INDIRECT_Y, true},
-    /* 0xb4 */ {"LDY",AM_ZERO_PAGE_X, false},
-    /* 0xb5 */ {"LDA",AM_ZERO_PAGE_X, false},
-    /* 0xb6 */ {"LDX",AM_ZERO_PAGE_Y, false},
-    /* 0xB7 */ {"LAX",AM_ZERO_PAGE_Y, true},
-    /* 0xb8 */ {"CLV",AM_IMPLIED, false},
-    /* 0xb9 */ {"LDA",AM_INDEXED_Y, false},
-    /* 0xba */ {"TSX",AM_IMPLIED, false},
-    /* 0xBB */ {"LAS",AM_INDEXED_Y, true},
-    /* 0xbc */ {"LDY",AM_INDEXED_X, false},
-    /* 0xbd */ {"LDA",AM_INDEXED_X, false},
-    /* 0xbe */ {"LDX",AM_INDEXED_Y, false},
-    /* 0xBF */ {"LAX",AM_INDEXED_Y, true},
-    /* 0xc0 */ {"CPY",AM_IMMEDIATE, false},
-    /* 0xc1 */ {"CMP",AM_INDIRECT_X, false},
-    /* 0xC2 */ {"NOOP",AM_IMMEDIATE, true},
-    /* 0xC3 */ {"DCP",AM_INDIRECT_X, true},
-    /* 0xc4 */ {"CPY",AM_ZERO_PAGE, false},
-    /* 0xc5 */ {"CMP",AM_ZERO_PAGE, false},
-    /* 0xc6 */ {"DEC",AM_ZERO_PAGE, false},
-    /* 0xC7 */ {"DCP",AM_ZERO_PAGE, true},
-    /* 0xc8 */ {"INY",AM_IMPLIED, false},
-    /* 0xc9 */ {"CMP",AM_IMMEDIATE, false},
-    /* 0xca */ {"DEX",AM_IMPLIED, false},
-    /* 0xCB */ {"SBX",AM_IMMEDIATE, true},
-    /* 0xcc */ {"CPY",AM_ABSOLUTE, false},
-    /* 0xcd */ {"CMP",AM_ABSOLUTE, false},
-    /* 0xce */ {"DEC",AM_ABSOLUTE, false},
-    /* 0xCF */ {"DCP",AM_ABSOLUTE, true},
-    /* 0xD0 */ {"BNE",AM_RELATIVE, false},
-    /* 0xd1 */ {"CMP",AM_INDIRECT_Y, false},
-    /* 0xD2 */ {"JAM",AM_IMPLIED, true},
-    /* 0xD3 */ {"DCP",AM_INDIRECT_Y, true},
-    /* 0xD4 */ {"NOOP",AM_ZERO_PAGE_X, true},
-    /* 0xd5 */ {"CMP",AM_ZERO_PAGE_X, false},
-    /* 0xd6 */ {"DEC",AM_ZERO_PAGE_X, false},
-    /* 0xD7 */ {"DCP",AM_ZERO_PAGE_X, true},
-    /* 0xd8 */ {"CLD",AM_IMPLIED, false},
-    /* 0xd9 */ {"CMP",AM_INDEXED_Y, false},
-    /* 0xDA */ {"NOOP",AM_IMPLIED, true},
-    /* 0xDB */ {"DCP",AM_INDEXED_Y, true},
-    /* 0xDC */ {"NOOP",AM_INDEXED_X, true},
-    /* 0xdd */ {"CMP",AM_INDEXED_X, false},
-    /* 0xde */ {"DEC",AM_INDEXED_X, false},
-    /* 0xDF */ {"DCP",AM_INDEXED_X, true},
-    /* 0xe0 */ {"CPX",AM_IMMEDIATE, false},
-    /* 0xe1 */ {"SBC",AM_INDIRECT_X, false},
-    /* 0xE2 */ {"NOOP",AM_IMMEDIATE, true},
-    /* 0xE3 */ {"ISC",AM_INDIRECT_X, true},
-    /* 0xe4 */ {"CPX",AM_ZERO_PAGE, false},
-    /* 0xe5 */ {"SBC",AM_ZERO_PAGE, false},
-    /* 0xe6 */ {"INC",AM_ZERO_PAGE, false},
-    /* 0xE7 */ {"ISC",AM_ZERO_PAGE, true},
-    /* 0xe8 */ {"INX",AM_IMPLIED, false},
-    /* 0xe9 */ {"SBC",AM_IMMEDIATE, false},
-    /* 0xea */ {"NOP",AM_IMPLIED, false},
-    /* 0xEB */ {"USBC",AM_IMMEDIATE, true},
-    /* 0xec */ {"CPX",AM_ABSOLUTE, false},
-    /* 0xed */ {"SBC",AM_ABSOLUTE, false},
-    /* 0xee */ {"INC",AM_ABSOLUTE, false},
-    /* 0xEF */ {"ISC",AM_ABSOLUTE, true},
-    /* 0xF0 */ {"BEQ",AM_RELATIVE, false},
-    /* 0xf1 */ {"SBC",AM_INDIRECT_Y, false},
-    /* 0xF2 */ {"JAM",AM_IMPLIED, true},
-    /* 0xF3 */ {"ISC",AM_INDIRECT_Y, true},
-    /* 0xF4 */ {"NOOP",AM_ZERO_PAGE_X, true},
-    /* 0xf5 */ {"SBC",AM_ZERO_PAGE_X, false},
-    /* 0xf6 */ {"INC",AM_ZERO_PAGE_X, false},
-    /* 0xF7 */ {"ISC",AM_ZERO_PAGE_X, true},
-    /* 0xf8 */ {"SED",AM_IMPLIED, false},
-    /* 0xf9 */ {"SBC",AM_INDEXED_Y, false},
-    /* 0xFA */ {"NOOP",AM_IMPLIED, true},
-    /* 0xFB */ {"ISC",AM_INDEXED_Y, true},
-    /* 0xFC */ {"NOOP",AM_INDEXED_X, true},
-    /* 0xfd */ {"SBC",AM_INDEXED_X, false},
-    /* 0xfe */ {"INC",AM_INDEXED_X, false},
-    /* 0xFF */ {"ISC",AM_INDEXED_X, true}
+    /* 0x00 */ {"BRK",AM_IMPLIED, false, 7, false},
+    /* 0x01 */ {"ORA",AM_INDIRECT_X, false, 6, false},
+    /* 0x02 */ {"JAM",AM_IMPLIED, true, 0, false},
+    /* 0x03 */ {"SLO",AM_INDIRECT_X, true, 8, false},
+    /* 0x04 */ {"NOOP",AM_ZERO_PAGE, true, 3, false},
+    /* 0x05 */ {"ORA",AM_ZERO_PAGE, false, 3, false},
+    /* 0x06 */ {"ASL",AM_ZERO_PAGE, false, 5, false},
+    /* 0x07 */ {"SLO",AM_ZERO_PAGE, true, 5, false},
+    /* 0x08 */ {"PHP",AM_IMPLIED, false, 3, false},
+    /* 0x09 */ {"ORA",AM_IMMEDIATE, false, 2, false},
+    /* 0x0a */ {"ASL",AM_ACCUMULATOR, false, 2, false},
+    /* 0x0B */ {"ANC",AM_IMMEDIATE, true, 2, false},
+    /* 0x0C */ {"NOOP",AM_ABSOLUTE, true, 4, false},
+    /* 0x0d */ {"ORA",AM_ABSOLUTE, false, 4, false},
+    /* 0x0e */ {"ASL",AM_ABSOLUTE, false, 6, false},
+    /* 0x0F */ {"SLO",AM_ABSOLUTE, true, 6, false},
+    /* 0x10 */ {"BPL",AM_RELATIVE, false, 2, false},
+    /* 0x11 */ {"ORA",AM_INDIRECT_Y, false, 5, true},
+    /* 0x12 */ {"JAM",AM_IMPLIED, true, 0, false},
+    /* 0x13 */ {"SLO",AM_INDIRECT_Y, true, 8, false},
+    /* 0x14 */ {"NOOP",AM_ZERO_PAGE_X, true, 4, false},
+    /* 0x15 */ {"ORA",AM_ZERO_PAGE_X, false, 4, false},
+    /* 0x16 */ {"ASL",AM_ZERO_PAGE_X, false, 6, false},
+    /* 0x17 */ {"SLO",AM_ZERO_PAGE_X, true, 6, false},
+    /* 0x18 */ {"CLC",AM_IMPLIED, false, 2, false},
+    /* 0x19 */ {"ORA",AM_INDEXED_Y, false, 4, true},
+    /* 0x1A */ {"NOOP",AM_IMPLIED, true, 2, false},
+    /* 0x1B */ {"SLO",AM_INDEXED_Y, true, 7, false},
+    /* 0x1C */ {"NOOP",AM_INDEXED_X, true, 4, true},
+    /* 0x1d */ {"ORA",AM_INDEXED_X, false, 4, true},
+    /* 0x1e */ {"ASL",AM_INDEXED_X, false, 7, false},
+    /* 0x1F */ {"SLO",AM_INDEXED_X, true, 7, false},
+    /* 0x20 */ {"JSR",AM_ABSOLUTE, false, 6, false},
+    /* 0x21 */ {"AND",AM_INDIRECT_X, false, 6, false},
+    /* 0x22 */ {"JAM",AM_IMPLIED, true, 0, false},
+    /* 0x23 */ {"RLA",AM_INDIRECT_X, true, 8, false},
+    /* 0x24 */ {"BIT",AM_ZERO_PAGE, false, 3, false},
+    /* 0x25 */ {"AND",AM_ZERO_PAGE, false, 3, false},
+    /* 0x26 */ {"ROL",AM_ZERO_PAGE, false, 5, false},
+    /* 0x27 */ {"RLA",AM_ZERO_PAGE, true, 5, false},
+    /* 0x28 */ {"PLP",AM_IMPLIED, false, 4, false},
+    /* 0x29 */ {"AND",AM_IMMEDIATE, false, 2, false},
+    /* 0x2a */ {"ROL",AM_ACCUMULATOR, false, 2, false},
+    /* 0x2B */ {"ANC",AM_IMMEDIATE, true, 2, false},
+    /* 0x2c */ {"BIT",AM_ABSOLUTE, false, 4, false},
+    /* 0x2d */ {"AND",AM_ABSOLUTE, false, 4, false},
+    /* 0x2e */ {"ROL",AM_ABSOLUTE, false, 6, false},
+    /* 0x2F */ {"RLA",AM_ABSOLUTE, true, 6, false},
+    /* 0x30 */ {"BMI",AM_RELATIVE, false, 2, false},
+    /* 0x31 */ {"AND",AM_INDIRECT_Y, false, 5, true},
+    /* 0x32 */ {"JAM",AM_IMPLIED, true, 0, false},
+    /* 0x33 */ {"RLA",AM_INDIRECT_Y, true, 8, false},
+    /* 0x34 */ {"NOOP",AM_ZERO_PAGE_X, true, 4, false},
+    /* 0x35 */ {"AND",AM_ZERO_PAGE_X, false, 4, false},
+    /* 0x36 */ {"ROL",AM_ZERO_PAGE_X, false, 6, false},
+    /* 0x37 */ {"RLA",AM_ZERO_PAGE_X, true, 6, false},
+    /* 0x38 */ {"SEC",AM_IMPLIED, false, 2, false},
+    /* 0x39 */ {"AND",AM_INDEXED_Y, false, 4, true},
+    /* 0x3A */ {"NOOP",AM_IMPLIED, true, 2, false},
+    /* 0x3B */ {"RLA",AM_INDEXED_Y, true, 7, false},
+    /* 0x3C */ {"NOOP",AM_INDEXED_X, true, 4, true},
+    /* 0x3d */ {"AND",AM_INDEXED_X, false, 4, true},
+    /* 0x3e */ {"ROL",AM_INDEXED_X, false, 7, false},
+    /* 0x3F */ {"RLA",AM_INDEXED_X, true, 7, false},
+    /* 0x40 */ {"RTI",AM_IMPLIED, false, 6, false},
+    /* 0x41 */ {"EOR",AM_INDIRECT_X, false, 6, false},
+    /* 0x42 */ {"JAM",AM_IMPLIED, true, 0, false},
+    /* 0x43 */ {"SRE",AM_INDIRECT_X, true, 8, false},
+    /* 0x44 */ {"NOOP",AM_ZERO_PAGE, true, 3, false},
+    /* 0x45 */ {"EOR",AM_ZERO_PAGE, false, 3, false},
+    /* 0x46 */ {"LSR",AM_ZERO_PAGE, false, 5, false},
+    /* 0x47 */ {"SRE",AM_ZERO_PAGE, true, 5, false},
+    /* 0x48 */ {"PHA",AM_IMPLIED, false, 3, false},
+    /* 0x49 */ {"EOR",AM_IMMEDIATE, false, 2, false},
+    /* 0x4a */ {"LSR",AM_ACCUMULATOR, false, 2, false},
+    /* 0x4B */ {"ALR",AM_IMMEDIATE, true, 2, false},
+    /* 0x4c */ {"JMP",AM_ABSOLUTE, false, 3, false},
+    /* 0x4d */ {"EOR",AM_ABSOLUTE, false, 4, false},
+    /* 0x4e */ {"LSR",AM_ABSOLUTE, false, 6, false},
+    /* 0x4F */ {"SRE",AM_ABSOLUTE, true, 6, false},
+    /* 0x50 */ {"BVC",AM_RELATIVE, false, 2, false},
+    /* 0x51 */ {"EOR",AM_INDIRECT_Y, false, 5, true},
+    /* 0x52 */ {"JAM",AM_IMPLIED, true, 0, false},
+    /* 0x53 */ {"SRE",AM_INDIRECT_Y, true, 8, false},
+    /* 0x54 */ {"NOOP",AM_ZERO_PAGE_X, true, 4, false},
+    /* 0x55 */ {"EOR",AM_ZERO_PAGE_X, false, 4, false},
+    /* 0x56 */ {"LSR",AM_ZERO_PAGE_X, false, 6, false},
+    /* 0x57 */ {"SRE",AM_ZERO_PAGE_X, true, 6, false},
+    /* 0x58 */ {"CLI",AM_IMPLIED, false, 2, false},
+    /* 0x59 */ {"EOR",AM_INDEXED_Y, false, 4, true},
+    /* 0x5A */ {"NOOP",AM_IMPLIED, true, 2, false},
+    /* 0x5B */ {"SRE",AM_INDEXED_Y, true, 7, false},
+    /* 0x5C */ {"NOOP",AM_INDEXED_X, true, 4, true},
+    /* 0x5d */ {"EOR",AM_INDEXED_X, false, 4, true},
+    /* 0x5e */ {"LSR",AM_INDEXED_X, false, 7, false},
+    /* 0x5F */ {"SRE",AM_INDEXED_X, true, 7, false},
+    /* 0x60 */ {"RTS",AM_IMPLIED, false, 6, false},
+    /* 0x61 */ {"ADC",AM_INDIRECT_X, false, 6, false},
+    /* 0x62 */ {"JAM",AM_IMPLIED, true, 0, false},
+    /* 0x63 */ {"RRA",AM_INDIRECT_X, true, 8, false},
+    /* 0x64 */ {"NOOP",AM_ZERO_PAGE, true, 3, false},
+    /* 0x65 */ {"ADC",AM_ZERO_PAGE, false, 3, false},
+    /* 0x66 */ {"ROR",AM_ZERO_PAGE, false, 5, false},
+    /* 0x67 */ {"RRA",AM_ZERO_PAGE, true, 5, false},
+    /* 0x68 */ {"PLA",AM_IMPLIED, false, 4, false},
+    /* 0x69 */ {"ADC",AM_IMMEDIATE, false, 2, false},
+    /* 0x6a */ {"ROR",AM_ACCUMULATOR, false, 2, false},
+    /* 0x6B */ {"ARR",AM_IMMEDIATE, true, 2, false},
+    /* 0x6c */ {"JMP",AM_INDIRECT, false, 5, false},
+    /* 0x6d */ {"ADC",AM_ABSOLUTE, false, 4, false},
+    /* 0x6e */ {"ROR",AM_INDEXED_X, false, 6, false},
+    /* 0x6F */ {"RRA",AM_ABSOLUTE, true, 6, false},
+    /* 0x70 */ {"BVS",AM_RELATIVE, false, 2, false},
+    /* 0x71 */ {"ADC",AM_INDIRECT_Y, false, 5, true},
+    /* 0x72 */ {"JAM",AM_IMPLIED, true, 0, false},
+    /* 0x73 */ {"RRA",AM_INDIRECT_Y, true, 8, false},
+    /* 0x74 */ {"NOOP",AM_ZERO_PAGE_X, true, 4, false},
+    /* 0x75 */ {"ADC",AM_ZERO_PAGE_X, false, 4, false},
+    /* 0x76 */ {"ROR",AM_ZERO_PAGE_X, false, 6, false},
+    /* 0x77 */ {"RRA",AM_ZERO_PAGE_X, true, 6, false},
+    /* 0x78 */ {"SEI",AM_IMPLIED, false, 2, false},
+    /* 0x79 */ {"ADC",AM_INDEXED_Y, false, 4, true},
+    /* 0x7A */ {"NOOP",AM_IMPLIED, true, 2, false},
+    /* 0x7B */ {"RRA",AM_INDEXED_Y, true, 7, false},
+    /* 0x7C */ {"NOOP",AM_INDEXED_X, true, 4, true},
+    /* 0x7d */ {"ADC",AM_INDEXED_X, false, 4, true},
+    /* 0x7e */ {"ROR",AM_ABSOLUTE, false, 7, false},
+    /* 0x7F */ {"RRA",AM_INDEXED_X, true, 7, false},
+    /* 0x80 */ {"NOOP",AM_IMMEDIATE, true, 2, false},
+    /* 0x81 */ {"STA",AM_INDIRECT_X, false, 6, false},
+    /* 0x82 */ {"NOOP",AM_IMMEDIATE, true, 2, false},
+    /* 0x83 */ {"SAX",AM_INDIRECT_X, true, 6, false},
+    /* 0x84 */ {"STY",AM_ZERO_PAGE, false, 3, false},
+    /* 0x85 */ {"STA",AM_ZERO_PAGE, false, 3, false},
+    /* 0x86 */ {"STX",AM_ZERO_PAGE, false, 3, false},
+    /* 0x87 */ {"SAX",AM_ZERO_PAGE, true, 3, false},
+    /* 0x88 */ {"DEY",AM_IMPLIED, false, 2, false},
+    /* 0x89 */ {"NOOP",AM_IMMEDIATE, true, 2, false},
+    /* 0x8a */ {"TXA",AM_IMPLIED, false, 2, false},
+    /* 0x8B */ {"ANE",AM_IMMEDIATE, true, 2, false},
+    /* 0x8c */ {"STY",AM_ABSOLUTE, false, 4, false},
+    /* 0x8d */ {"STA",AM_ABSOLUTE, false, 4, false},
+    /* 0x8e */ {"STX",AM_ABSOLUTE, false, 4, false},
+    /* 0x8F */ {"SAX",AM_ABSOLUTE, true, 4, false},
+    /* 0x90 */ {"BCC",AM_RELATIVE, false, 2, false},
+    /* 0x91 */ {"STA",AM_INDIRECT_Y, false, 6, false},
+    /* 0x92 */ {"JAM",AM_IMPLIED, true, 0, false},
+    /* 0x93 */ {"SHA",AM_INDIRECT_Y, true, 6, false},
+    /* 0x94 */ {"STY",AM_ZERO_PAGE_X, false, 4, false},
+    /* 0x95 */ {"STA",AM_ZERO_PAGE_X, false, 4, false},
+    /* 0x96 */ {"STX",AM_ZERO_PAGE_Y, false, 4, false},
+    /* 0x97 */ {"SAX",AM_ZERO_PAGE_Y, true, 4, false},
+    /* 0x98 */ {"TYA",AM_IMPLIED, false, 2, false},
+    /* 0x99 */ {"STA",AM_INDEXED_Y, false, 5, false},
+    /* 0x9a */ {"TXS",AM_IMPLIED, false, 2, false},
+    /* 0x9B */ {"TAS",AM_INDEXED_Y, true, 5, false},
+    /* 0x9C */ {"SHY",AM_INDEXED_X, true, 5, false},
+    /* 0x9d */ {"STA",AM_INDEXED_X, false, 5, false},
+    /* 0x9E */ {"SHX",AM_INDEXED_Y, true, 5, false},
+    /* 0x9F */ {"SHA",AM_INDEXED_Y, true, 5, false},
+    /* 0xa0 */ {"LDY",AM_IMMEDIATE, false, 2, false},
+    /* 0xa1 */ {"LDA",AM_INDIRECT_X, false, 6, false},
+    /* 0xa2 */ {"LDX",AM_IMMEDIATE, false, 2, false},
+    /* 0xA3 */ {"LAX",AM_INDIRECT_X, true, 6, false},
+    /* 0xa4 */ {"LDY",AM_ZERO_PAGE, false, 3, false},
+    /* 0xa5 */ {"LDA",AM_ZERO_PAGE, false, 3, false},
+    /* 0xa6 */ {"LDX",AM_ZERO_PAGE, false, 3, false},
+    /* 0xA7 */ {"LAX",AM_ZERO_PAGE, true, 3, false},
+    /* 0xa8 */ {"TAY",AM_IMPLIED, false, 2, false},
+    /* 0xa9 */ {"LDA",AM_IMMEDIATE, false, 2, false},
+    /* 0xaa */ {"TAX",AM_IMPLIED, false, 2, false},
+    /* 0xAB */ {"LXA",AM_IMMEDIATE, true, 2, false},
+    /* 0xac */ {"LDY",AM_ABSOLUTE, false, 4, false},
+    /* 0xad */ {"LDA",AM_ABSOLUTE, false, 4, false},
+    /* 0xae */ {"LDX",AM_ABSOLUTE, false, 4, false},
+    /* 0xAF */ {"LAX",AM_ABSOLUTE, true, 4, false},
+    /* 0xB0 */ {"BCS",AM_RELATIVE, false, 2, false},
+    /* 0xb1 */ {"LDA",AM_INDIRECT_Y, false, 5, true},
+    /* 0xB2 */ {"JAM",AM_IMPLIED, true, 0, false},
+    /* 0xB3 */ {"LAX",AM_INDIRECT_Y, true, 5, true},
+    /* 0xb4 */ {"LDY",AM_ZERO_PAGE_X, false, 4, false},
+    /* 0xb5 */ {"LDA",AM_ZERO_PAGE_X, false, 4, false},
+    /* 0xb6 */ {"LDX",AM_ZERO_PAGE_Y, false, 4, false},
+    /* 0xB7 */ {"LAX",AM_ZERO_PAGE_Y, true, 4, false},
+    /* 0xb8 */ {"CLV",AM_IMPLIED, false, 2, false},
+    /* 0xb9 */ {"LDA",AM_INDEXED_Y, false, 4, true},
+    /* 0xba */ {"TSX",AM_IMPLIED, false, 2, false},
+    /* 0xBB */ {"LAS",AM_INDEXED_Y, true, 4, true},
+    /* 0xbc */ {"LDY",AM_INDEXED_X, false, 4, true},
+    /* 0xbd */ {"LDA",AM_INDEXED_X, false, 4, true},
+    /* 0xbe */ {"LDX",AM_INDEXED_Y, false, 4, true},
+    /* 0xBF */ {"LAX",AM_INDEXED_Y, true, 4, true},
+    /* 0xc0 */ {"CPY",AM_IMMEDIATE, false, 2, false},
+    /* 0xc1 */ {"CMP",AM_INDIRECT_X, false, 6, false},
+    /* 0xC2 */ {"NOOP",AM_IMMEDIATE, true, 2, false},
+    /* 0xC3 */ {"DCP",AM_INDIRECT_X, true, 8, false},
+    /* 0xc4 */ {"CPY",AM_ZERO_PAGE, false, 3, false},
+    /* 0xc5 */ {"CMP",AM_ZERO_PAGE, false, 3, false},
+    /* 0xc6 */ {"DEC",AM_ZERO_PAGE, false, 5, false},
+    /* 0xC7 */ {"DCP",AM_ZERO_PAGE, true, 5, false},
+    /* 0xc8 */ {"INY",AM_IMPLIED, false, 2, false},
+    /* 0xc9 */ {"CMP",AM_IMMEDIATE, false, 2, false},
+    /* 0xca */ {"DEX",AM_IMPLIED, false, 2, false},
+    /* 0xCB */ {"SBX",AM_IMMEDIATE, true, 2, false},
+    /* 0xcc */ {"CPY",AM_ABSOLUTE, false, 4, false},
+    /* 0xcd */ {"CMP",AM_ABSOLUTE, false, 4, false},
+    /* 0xce */ {"DEC",AM_ABSOLUTE, false, 6, false},
+    /* 0xCF */ {"DCP",AM_ABSOLUTE, true, 6, false},
+    /* 0xD0 */ {"BNE",AM_RELATIVE, false, 2, false},
+    /* 0xd1 */ {"CMP",AM_INDIRECT_Y, false, 5, true},
+    /* 0xD2 */ {"JAM",AM_IMPLIED, true, 0, false},
+    /* 0xD3 */ {"DCP",AM_INDIRECT_Y, true, 8, false},
+    /* 0xD4 */ {"NOOP",AM_ZERO_PAGE_X, true, 4, false},
+    /* 0xd5 */ {"CMP",AM_ZERO_PAGE_X, false, 4, false},
+    /* 0xd6 */ {"DEC",AM_ZERO_PAGE_X, false, 6, false},
+    /* 0xD7 */ {"DCP",AM_ZERO_PAGE_X, true, 6, false},
+    /* 0xd8 */ {"CLD",AM_IMPLIED, false, 2, false},
+    /* 0xd9 */ {"CMP",AM_INDEXED_Y, false, 4, true},
+    /* 0xDA */ {"NOOP",AM_IMPLIED, true, 2, false},
+    /* 0xDB */ {"DCP",AM_INDEXED_Y, true, 7, false},
+    /* 0xDC */ {"NOOP",AM_INDEXED_X, true, 4, true},
+    /* 0xdd */ {"CMP",AM_INDEXED_X, false, 4, true},
+    /* 0xde */ {"DEC",AM_INDEXED_X, false, 7, false},
+    /* 0xDF */ {"DCP",AM_INDEXED_X, true, 7, false},
+    /* 0xe0 */ {"CPX",AM_IMMEDIATE, false, 2, false},
+    /* 0xe1 */ {"SBC",AM_INDIRECT_X, false, 6, false},
+    /* 0xE2 */ {"NOOP",AM_IMMEDIATE, true, 2, false},
+    /* 0xE3 */ {"ISC",AM_INDIRECT_X, true, 8, false},
+    /* 0xe4 */ {"CPX",AM_ZERO_PAGE, false, 3, false},
+    /* 0xe5 */ {"SBC",AM_ZERO_PAGE, false, 3, false},
+    /* 0xe6 */ {"INC",AM_ZERO_PAGE, false, 5, false},
+    /* 0xE7 */ {"ISC",AM_ZERO_PAGE, true, 5, false},
+    /* 0xe8 */ {"INX",AM_IMPLIED, false, 2, false},
+    /* 0xe9 */ {"SBC",AM_IMMEDIATE, false, 2, false},
+    /* 0xea */ {"NOP",AM_IMPLIED, false, 2, false},
+    /* 0xEB */ {"USBC",AM_IMMEDIATE, true, 2, false},
+    /* 0xec */ {"CPX",AM_ABSOLUTE, false, 4, false},
+    /* 0xed */ {"SBC",AM_ABSOLUTE, false, 4, false},
+    /* 0xee */ {"INC",AM_ABSOLUTE, false, 6, false},
+    /* 0xEF */ {"ISC",AM_ABSOLUTE, true, 6, false},
+    /* 0xF0 */ {"BEQ",AM_RELATIVE, false, 2, false},
+    /* 0xf1 */ {"SBC",AM_INDIRECT_Y, false, 5, true},
+    /* 0xF2 */ {"JAM",AM_IMPLIED, true, 0, false},
+    /* 0xF3 */ {"ISC",AM_INDIRECT_Y, true, 8, false},
+    /* 0xF4 */ {"NOOP",AM_ZERO_PAGE_X, true, 4, false},
+    /* 0xf5 */ {"SBC",AM_ZERO_PAGE_X, false, 4, false},
+    /* 0xf6 */ {"INC",AM_ZERO_PAGE_X, false, 6, false},
+    /* 0xF7 */ {"ISC",AM_ZERO_PAGE_X, true, 6, false},
+    /* 0xf8 */ {"SED",AM_IMPLIED, false, 2, false},
+    /* 0xf9 */ {"SBC",AM_INDEXED_Y, false, 4, true},
+    /* 0xFA */ {"NOOP",AM_IMPLIED, true, 2, false},
+    /* 0xFB */ {"ISC",AM_INDEXED_Y, true, 7, false},
+    /* 0xFC */ {"NOOP",AM_INDEXED_X, true, 4, true},
+    /* 0xfd */ {"SBC",AM_INDEXED_X, false, 4, true},
+    /* 0xfe */ {"INC",AM_INDEXED_X, false, 7, false},
+    /* 0xFF */ {"ISC",AM_INDEXED_X, true, 7, false}
 };
 
+// Scores of the instructions in backward disassembly. The chain of instructions
+// with the highest total is taken as the code before an address.
+const int kLegalScore = 2;
+const int kIllegalScore = -3;
+const int kJamScore = -12; // Stops the CPU, so it is rarely part of running code
+const int kLabelScore = 4;
+const int kBranchTargetScore = 3;
+const int kKnownInstructionScore = 32; // Learned from forward disassembly
+
+// Bytes decoded before the lines that are asked for, so that the chains have
+// room to agree on the instruction boundaries.
+const int kLookbehind = 32;
+
+const int kNoChain = std::numeric_limits<int>::min();
+
+int instructionLength(std::uint8_t opcode) {
+    return additionalBytes[instructions[opcode].mode] + 1;
 }
 
-bool Disassembler6502::checkValidInstr(int depth, std::uint16_t pos, const std::vector<std::uint8_t>& memory, int len, bool illegalAllowed) {
-    if (pos < 0 || pos+len >= memory.size()) {
-        // out of range
-        return false;
-    }
-    const InstrDesc& desc = instructions[memory[pos]];
-    if (len != additionalBytes[desc.mode]+1) {
-        // length is not matching
-        return false;
-    }
-    if (!illegalAllowed && desc.illegal) {
-        // illegal instructions not allowed
-        return false;
-    }
-    if (depth < 2) {
-        // Check there is also a valid instr before this one before we report success.
-        // We do this to have better stability in backward disassembly.
-        return
-                checkValidInstr(depth+1, pos - 3, memory, 3, illegalAllowed) ||
-                checkValidInstr(depth+1, pos - 2, memory, 2, illegalAllowed) ||
-                checkValidInstr(depth+1, pos - 1, memory, 1, illegalAllowed);
+int instructionScore(std::uint16_t addr, int len, const std::vector<std::uint8_t>& memory, const InstructionBoundaryMap* boundaries) {
+    const InstrDesc& desc = instructions[memory[addr]];
+    int score = desc.cycles == 0 ? kJamScore : desc.illegal ? kIllegalScore : kLegalScore;
+    if (boundaries != nullptr) {
+        if (boundaries->lengthAt(addr) == len) {
+            score += kKnownInstructionScore;
+        }
+        for (int i = 1; i < len; i++) {
+            if (boundaries->lengthAt(addr + i) != 0) {
+                // Overlaps a known instruction
+                score -= kKnownInstructionScore;
+            }
+        }
     }
-    return true;
+    return score;
 }
- 
-std::vector<Disassembler::Line> Disassembler6502::disassembleBackward(std::uint16_t pos, const std::vector<std::uint8_t>& memory, int lines, const std::vector<Disassembler::Line>& disassemblyHint) {
-    std::vector<Line> res;
 
-    while(lines-- > 0 && (0 < pos && pos < memory.size())) {
-        std::uint16_t p = pos;
-        std::uint16_t tmp;
-//        // Go for the longest non-illegal sequence before pos
-//        if (checkValidInstr(pos - 3, memory, 3, /* illegalAllowed= */false)) {
-//            tmp = pos - 3;
-//            res.push_back(disassembleLine(tmp, memory));
-//            pos = p - 3;
-//        } else if (checkValidInstr(pos - 2, memory, 2, /* illegalAllowed= */false)) {
-//            tmp = pos - 2;
-//            res.push_back(disassembleLine(tmp, memory));
-//            pos = p - 2;
-//        } else if (checkValidInstr(pos - 1, memory, 1, /* ilelgalAllowed= */false)) {
-//            tmp = pos - 1;
-//            res.push_back(disassembleLine(tmp, memory));
-//            pos = p - 1;
-//        } else
-        if (checkValidInstr(0, pos - 3, memory, 3, /* illegalAllowed= */true)) {
-            tmp = pos - 3;
-            res.push_back(disassembleLine(tmp, memory));
-            pos = p - 3;
-        } else if (checkValidInstr(0, pos - 2, memory, 2, /* illegalAllowed= */true)) {
-            tmp = pos - 2;
-            res.push_back(disassembleLine(tmp, memory));
-            pos = p - 2;
-        } else if (checkValidInstr(0, pos - 1, memory, 1, /* illegalAllowed= */true)) {
-            tmp = pos - 1;
-            res.push_back(disassembleLine(tmp, memory));
-            pos = p - 1;
+// Marks the addresses in [lo, hi) that a branch, JMP or JSR at any address in
+// [lo, hi) leads to.
+std::vector<bool> branchTargets(int lo, int hi, const std::vector<std::uint8_t>& memory) {
+    std::vector<bool> res(hi - lo);
+    for (int addr = lo; addr < hi && addr + 2 < (int)memory.size(); addr++) {
+        std::uint8_t opcode = memory[addr];
+        int target;
+        if (instructions[opcode].mode == AM_RELATIVE) {
+            target = addr + 2 + (std::int8_t)memory[addr + 1];
+        } else if (opcode == 0x20 || opcode == 0x4c) { // JSR, JMP abs
+            target = memory[addr + 2] << 8 | memory[addr + 1];
         } else {
-            // No valid instruction?
-            pos--;
-            Line l;
-            l.addr = pos;
-            std::uint8_t b = memory[pos % 0xffff];
-            l.bytes.push_back(b);
-            l.disassembly = "???";
-            res.push_back(l);
+            continue;
+        }
+        if (lo <= target && target < hi) {
+            res[target - lo] = true;
         }
     }
-    std::reverse(res.begin(), res.end());
     return res;
 }
 
+}
+
+Disassembler::Instructions Disassembler6502::decodeBackward(std::uint16_t pos, const std::vector<std::uint8_t>& memory, int lines, const InstructionBoundaryMap* boundaries) const {
+    Instructions res;
+    if (lines <= 0 || pos == 0 || pos >= memory.size()) {
+        return res;
+    }
+
+    // Every address decodes to exactly one instruction, so the instructions
+    // from an address up to pos form a single chain, if they end at pos at
+    // all. The chains of all addresses in the window are scored in one pass
+    // from right to left, reusing the score of the rest of the chain.
+    int lo = std::max(pos - 3 * lines - kLookbehind, 0);
+    int n = pos - lo;
+    std::vector<bool> targets = branchTargets(lo, pos, memory);
+    std::vector<bool> labels(n);
+    for (const auto& [label, addr] : symtab_->elements()) {
+        if (lo <= addr && addr < pos) {
+            labels[addr - lo] = true;
+        }
+    }
+    std::vector<int> score(n + 1, kNoChain);
+    std::vector<int> count(n + 1, 0);
+    score[n] = 0;
+    int best = -1;
+    for (int i = n - 1; i >= 0; i--) {
+        int len = instructionLength(memory[lo + i]);
+        if (i + len > n || score[i + len] == kNoChain) {
+            continue;
+        }
+        score[i] = score[i + len] + instructionScore(lo + i, len, memory, boundaries)
+                + (targets[i] ? kBranchTargetScore : 0) + (labels[i] ? kLabelScore : 0);
+        count[i] = count[i + len] + 1;
+        // Prefer chains with enough lines, then the highest score.
+        if (best < 0
+                || std::min(count[i], lines) > std::min(count[best], lines)
+                || (std::min(count[i], lines) == std::min(count[best], lines) && score[i] > score[best])) {
+            best = i;
+        }
+    }
+
+    std::vector<std::uint16_t> starts;
+    for (int i = best; i >= 0 && i < n; i += instructionLength(memory[lo + i])) {
+        starts.push_back(lo + i);
+    }
+    if ((int)starts.size() > lines) {
+        starts.erase(starts.begin(), starts.end() - lines);
+    }
+
+    // Not enough instructions end at pos: show the bytes before them as such.
+    std::uint16_t first = starts.empty() ? pos : starts.front();
+    for (int addr = std::max(first - (lines - (int)starts.size()), 0); addr < first; addr++) {
+        Decoded undecoded;
+        undecoded.addr = addr;
+        undecoded.operand = memory[addr];
+        res.push_back(undecoded);
+    }
+    for (std::uint16_t start : starts) {
+        res.push_back(decode(start, memory));
+    }
+    return res;
+}
+
+bool Disassembler6502::isControlTransfer(const Decoded& instr) const {
+    if (instr.opcode == kUndecoded) {
+        return false;
+    }
+    switch (instr.opcode) {
+    case 0x00: // BRK
+    case 0x20: // JSR
+    case 0x40: // RTI
+    case 0x4c: // JMP abs
+    case 0x60: // RTS
+    case 0x6c: // JMP (ind)
+        return true;
+    default:
+        // Branches are xxx10000
+        return (instr.opcode & 0x1f) == 0x10;
+    }
+}
+
 std::string Disassembler6502::labelOrAddr(std::uint16_t addr, int len) const {
     std::string label = symtab_->labelForAddress(addr);
     if (label.empty()) {
@@ -406,79 +474,71 @@ std::string Disassembler6502::labelOrAddr(std::uint16_t addr, int len) const {
     return label;
 }
 
-Disassembler::Line Disassembler6502::disassembleLine(std::uint16_t& pos, const std::vector<std::uint8_t>& memory) {
-    Line res;
+Disassembler::Decoded Disassembler6502::decode(std::uint16_t pos, const std::vector<std::uint8_t>& memory) const {
+    Decoded res;
     res.addr = pos;
 
     std::uint8_t b = memory[pos++ % 0xffff];
-    res.bytes.push_back(b);
-
     const InstrDesc& desc = instructions[b];
-    res.disassembly = desc.mnemo;
+    res.opcode = b;
+    res.mode = desc.mode;
+    res.length = additionalBytes[desc.mode] + 1;
+    res.minCycles = desc.cycles;
+    res.maxCycles = desc.cycles + (desc.pageCrossPenalty ? 1 : 0);
+
+    if (res.length == 2) {
+        res.operand = memory[pos++ % 0xffff];
+    } else if (res.length == 3) {
+        std::uint8_t lo = memory[pos++ % 0xffff];
+        std::uint8_t hi = memory[pos++ % 0xffff];
+        res.operand = hi << 8 | lo;
+    }
+    if (desc.mode == AM_RELATIVE) {
+        // Taken branches need one more cycle, and another one if the target is in a different page.
+        std::uint16_t target = pos + (std::int8_t)res.operand;
+        res.maxCycles = desc.cycles + ((target & 0xff00) != (pos & 0xff00) ? 2 : 1);
+    }
+    return res;
+}
 
-    std::string label;
-    std::uint8_t t1,t2;
-    std::uint16_t t3;
+std::string Disassembler6502::format(const Decoded& instr) const {
+    if (instr.opcode == kUndecoded) {
+        return "???";
+    }
+    const InstrDesc& desc = instructions[instr.opcode];
+    std::string res = desc.mnemo;
+    std::uint16_t op = instr.operand;
     switch(desc.mode) {
     case AM_ABSOLUTE:
-        t1 = memory[pos++ % 0xffff];
-        t2 = memory[pos++ % 0xffff];
-        res.bytes.push_back(t1);
-        res.bytes.push_back(t2);
-        res.disassembly += " " + labelOrAddr(t2 << 8 | t1, 4);
+        res += " " + labelOrAddr(op, 4);
         break;
     case AM_ZERO_PAGE:
-        t1 = memory[pos++ % 0xffff];
-        res.bytes.push_back(t1);
-        res.disassembly += " " + labelOrAddr(t1, 2);
+        res += " " + labelOrAddr(op, 2);
         break;
     case AM_ZERO_PAGE_X:
     case AM_ZERO_PAGE_Y:
-        t1 = memory[pos++ % 0xffff];
-        res.bytes.push_back(t1);
-        label = labelOrAddr(t1, 2);
-        res.disassembly += QString::asprintf(" %s,%s", label.c_str(), desc.mode==AM_ZERO_PAGE_X ? "X":"Y").toStdString();
+        res += QString::asprintf(" %s,%s", labelOrAddr(op, 2).c_str(), desc.mode==AM_ZERO_PAGE_X ? "X":"Y").toStdString();
         break;
     case AM_ACCUMULATOR:
         break;
     case AM_IMMEDIATE:
-        t1 = memory[pos++ % 0xffff];
-        res.bytes.push_back(t1);
-        res.disassembly += QString::asprintf(" #$%02X", t1).toStdString();
+        res += QString::asprintf(" #$%02X", op).toStdString();
         break;
     case AM_INDIRECT:
-        t1 = memory[pos++ % 0xffff];
-        t2 = memory[pos++ % 0xffff];
-        res.bytes.push_back(t1);
-        res.bytes.push_back(t2);
-        res.disassembly += " (" + labelOrAddr(t2 << 8 | t1,4) +")";
+        res += " (" + labelOrAddr(op, 4) +")";
         break;
     case AM_INDIRECT_X:
-        t1 = memory[pos++ % 0xffff];
-        res.bytes.push_back(t1);
-        label = labelOrAddr(t1, 2);
-        res.disassembly += QString::asprintf(" (%s,X)", label.c_str()).toStdString();
+        res += QString::asprintf(" (%s,X)", labelOrAddr(op, 2).c_str()).toStdString();
         break;
     case AM_INDIRECT_Y:
-        t1 = memory[pos++ % 0xffff];
-        res.bytes.push_back(t1);
-        label = labelOrAddr(t1, 2);
-        res.disassembly += QString::asprintf(" (%s),Y", label.c_str()).toStdString();
+        res += QString::asprintf(" (%s),Y", labelOrAddr(op, 2).c_str()).toStdString();
         break;
     case AM_INDEXED_X:
     case AM_INDEXED_Y:
-        t1 = memory[pos++ % 0xffff];
-        t2 = memory[pos++ % 0xffff];
-        res.bytes.push_back(t1);
-        res.bytes.push_back(t2);
-        label = labelOrAddr(t2 << 8 | t1, 4);
-        res.disassembly += QString::asprintf(" %s,%s", label.c_str(), desc.mode==AM_INDEXED_X ? "X":"Y").toStdString();
+        res += QString::asprintf(" %s,%s", labelOrAddr(op, 4).c_str(), desc.mode==AM_INDEXED_X ? "X":"Y").toStdString();
         break;
     case AM_RELATIVE:
-        t1 = memory[pos++ % 0xffff];
-        res.bytes.push_back(t1);
-        t3 = pos + (std::int8_t)t1;
-        res.disassembly += " " + labelOrAddr(t3, 4);
+        res += " " + labelOrAddr(instr.addr + 2 + (std::int8_t)op, 4);
         break;
     case AM_IMPLIED:
         break;
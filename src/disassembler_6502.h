@@ -30,14 +30,16 @@ namespace vicedebug {
 class Disassembler6502 : public Disassembler {
 public:
     Disassembler6502(SymTable* symtab) : Disassembler(symtab) {}
-    virtual std::vector<Line> disassembleBackward(std::uint16_t pos, const std::vector<std::uint8_t>& memory, int lines, const std::vector<Disassembler::Line>& disassemblyHint) override;
+    Instructions decodeBackward(std::uint16_t pos, const std::vector<std::uint8_t>& memory, int lines, const InstructionBoundaryMap* boundaries) const override;
+    std::string format(const Decoded& instr) const override;
+    using Disassembler::isControlTransfer;
+    bool isControlTransfer(const Decoded& instr) const override;
 
 protected:
-    Line disassembleLine(std::uint16_t& pos, const std::vector<std::uint8_t>& memory) override;
+    Decoded decode(std::uint16_t pos, const std::vector<std::uint8_t>& memory) const override;
 
 private:
     std::string labelOrAddr(std::uint16_t addr, int len) const;
-    bool checkValidInstr(int depth, std::uint16_t pos, const std::vector<std::uint8_t>& memory, int len, bool illegalAllowed);
 };
 
 }
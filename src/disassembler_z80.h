@@ -30,11 +30,14 @@ namespace vicedebug {
 class DisassemblerZ80 : public Disassembler {
 public:
     DisassemblerZ80(SymTable* symtab) : Disassembler(symtab) {}
-    std::vector<Line> disassembleBackward(std::uint16_t pos, const std::vector<std::uint8_t>& memory, int lines, const std::vector<Line>& disassemblyHint) override;
+    Instructions decodeBackward(std::uint16_t pos, const std::vector<std::uint8_t>& memory, int lines, const InstructionBoundaryMap* boundaries) const override;
+    std::string format(const Decoded& instr) const override;
+    using Disassembler::isControlTransfer;
+    bool isControlTransfer(const Decoded& instr) const override;
 
 protected:
     QString labelOrAddr(std::uint16_t addr, int len) const;
-    Line disassembleLine(std::uint16_t& pos, const std::vector<std::uint8_t>& memory) override;
+    Decoded decode(std::uint16_t pos, const std::vector<std::uint8_t>& memory) const override;
 };
 
 }
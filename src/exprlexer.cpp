@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "exprlexer.h"
+
+#include <cctype>
+
+namespace vicedebug {
+
+namespace {
+
+int digitValue(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    c = std::tolower(c);
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    return -1;
+}
+
+}
+
+void ExprLexer::skipSpaces() {
+    while (pos_ < text_.size() && std::isspace((unsigned char)text_[pos_])) {
+        pos_++;
+    }
+}
+
+bool ExprLexer::consume(const char* token) {
+    skipSpaces();
+    std::size_t len = std::char_traits<char>::length(token);
+    if (text_.compare(pos_, len, token) != 0) {
+        return false;
+    }
+    pos_ += len;
+    return true;
+}
+
+bool ExprLexer::consumeWord(const char* word) {
+    std::size_t len = std::char_traits<char>::length(word);
+    if (pos_ + len > text_.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < len; i++) {
+        if (std::toupper((unsigned char)text_[pos_ + i]) != word[i]) {
+            return false;
+        }
+    }
+    std::size_t end = pos_ + len;
+    if (end < text_.size() && (std::isalnum((unsigned char)text_[end]) || text_[end] == '_')) {
+        return false;
+    }
+    pos_ = end;
+    return true;
+}
+
+bool ExprLexer::consumeRegister(Registers::ID& id) {
+    for (const auto& reg : kRegisterNames) {
+        if (consumeWord(reg.name)) {
+            id = reg.id;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::uint16_t ExprLexer::parseNumber(const char* expected) {
+    skipSpaces();
+    int base = 10;
+    if (consume("$")) {
+        base = 16;
+    } else if (consume("0x") || consume("0X")) {
+        base = 16;
+    } else if (consume("%")) {
+        base = 2;
+    }
+    std::uint32_t value = 0;
+    std::size_t start = pos_;
+    while (pos_ < text_.size()) {
+        int digit = digitValue(text_[pos_]);
+        if (digit < 0 || digit >= base) {
+            break;
+        }
+        value = value * base + digit;
+        if (value > 0xffff) {
+            fail("Number out of range");
+            return 0;
+        }
+        pos_++;
+    }
+    if (pos_ == start) {
+        fail(expected);
+    }
+    return value;
+}
+
+void ExprLexer::fail(const std::string& message) {
+    if (error_.empty()) {
+        error_ = message + " at position " + std::to_string(pos_ + 1);
+    }
+}
+
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "machinestate.h"
+
+namespace vicedebug {
+
+struct RegisterName {
+    const char* name;
+    Registers::ID id;
+};
+
+// Longest names first, so that "AF'" isn't read as "AF". The first entry of
+// each register is the one used for output.
+inline constexpr const RegisterName kRegisterNames[] = {
+    { "AF'", Registers::AFPrime },
+    { "BC'", Registers::BCPrime },
+    { "DE'", Registers::DEPrime },
+    { "HL'", Registers::HLPrime },
+    { "FLAGS", Registers::Flags },
+    { "FL", Registers::Flags },
+    { "PC", Registers::PC },
+    { "SP", Registers::SP },
+    { "AF", Registers::AF },
+    { "BC", Registers::BC },
+    { "DE", Registers::DE },
+    { "HL", Registers::HL },
+    { "IX", Registers::IX },
+    { "IY", Registers::IY },
+    { "A", Registers::A },
+    { "X", Registers::X },
+    { "Y", Registers::Y },
+    { "I", Registers::I },
+    { "R", Registers::R },
+};
+
+// The tokens shared by the parsers of step conditions and trace specs. The
+// first error sticks, together with the position it was found at.
+class ExprLexer {
+protected:
+    explicit ExprLexer(const std::string& text) : text_(text), pos_(0) {}
+
+    void skipSpaces();
+
+    // Skips spaces, then consumes token if it comes next.
+    bool consume(const char* token);
+
+    // Like consume(), but case insensitive, and the word must end there.
+    // Doesn't skip spaces.
+    bool consumeWord(const char* word);
+
+    // Consumes a register name, see kRegisterNames.
+    bool consumeRegister(Registers::ID& id);
+
+    // A number in decimal, hex ($ff or 0xff) or binary (%1010), up to $ffff.
+    // Fails with expected if there is none.
+    std::uint16_t parseNumber(const char* expected);
+
+    void fail(const std::string& message);
+
+    const std::string& text_;
+    std::size_t pos_;
+    std::string error_;
+};
+
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "instructionboundarymap.h"
+
+#include <algorithm>
+
+namespace vicedebug {
+
+InstructionBoundaryMap::InstructionBoundaryMap() : lengths_(0x10000), bytes_(0x10000), size_(0) {
+}
+
+void InstructionBoundaryMap::mark(std::uint16_t addr, std::span<const std::uint8_t> bytes) {
+    int len = bytes.size();
+    if (len == 0 || len > kMaxInstructionLength || addr + len > 0x10000) {
+        return;
+    }
+    if (lengths_[addr] == len && std::equal(bytes.begin(), bytes.end(), bytes_.begin() + addr)) {
+        // Known already
+        return;
+    }
+    for (int start = std::max(addr - kMaxInstructionLength + 1, 0); start < addr + len; start++) {
+        if (start + lengths_[start] > addr) {
+            forget(start);
+        }
+    }
+    lengths_[addr] = len;
+    std::copy(bytes.begin(), bytes.end(), bytes_.begin() + addr);
+    size_++;
+}
+
+void InstructionBoundaryMap::update(std::uint16_t addr, std::span<const std::uint8_t> data) {
+    if (size_ == 0) {
+        return;
+    }
+    int end = std::min(addr + (int)data.size(), 0x10000);
+    for (int start = std::max(addr - kMaxInstructionLength + 1, 0); start < end; start++) {
+        int len = lengths_[start];
+        if (len == 0) {
+            continue;
+        }
+        // Compare the bytes of the instruction that are in data.
+        int from = std::max(start, (int)addr);
+        int to = std::min(start + len, end);
+        if (from < to && !std::equal(bytes_.begin() + from, bytes_.begin() + to, data.begin() + (from - addr))) {
+            forget(start);
+        }
+    }
+}
+
+void InstructionBoundaryMap::clear() {
+    std::fill(lengths_.begin(), lengths_.end(), 0);
+    size_ = 0;
+}
+
+void InstructionBoundaryMap::forget(int addr) {
+    if (lengths_[addr] != 0) {
+        lengths_[addr] = 0;
+        size_--;
+    }
+}
+
+}
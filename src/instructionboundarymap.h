@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace vicedebug {
+
+// Where instructions start in the memory of a bank, as learned from forward
+// disassembly, together with the bytes each instruction was decoded from.
+// An instruction is forgotten as soon as one of its bytes changes, so the
+// starts stay valid for the current memory. Backward disassembly uses them
+// instead of guessing where the instruction before an address starts.
+class InstructionBoundaryMap {
+public:
+    // The longest instruction of all CPUs.
+    static constexpr const int kMaxInstructionLength = 4;
+
+    InstructionBoundaryMap();
+
+    // Remembers that the instruction of bytes starts at addr. Instructions
+    // that overlap it are forgotten.
+    void mark(std::uint16_t addr, std::span<const std::uint8_t> bytes);
+
+    // Length of the instruction known to start at addr, or 0.
+    int lengthAt(std::uint16_t addr) const {
+        return lengths_[addr];
+    }
+
+    // Forgets the instructions whose bytes differ from data, which starts at addr.
+    void update(std::uint16_t addr, std::span<const std::uint8_t> data);
+
+    void clear();
+
+    // Number of known instructions.
+    std::size_t size() const {
+        return size_;
+    }
+
+private:
+    void forget(int addr);
+
+    std::vector<std::uint8_t> lengths_; // Per address
+    std::vector<std::uint8_t> bytes_; // Per address, valid for the bytes of known instructions
+    std::size_t size_;
+};
+
+}
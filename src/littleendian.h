@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2022 Andreas Signer <asigner@gmail.com>
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
  *
  * This file is part of vicedebug.
  *
@@ -17,28 +17,20 @@
  * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include "vectorutils.h"
+#pragma once
 
-namespace vicedebug {
-
-std::vector<std::uint8_t>& operator<<(std::vector<std::uint8_t>& vec, std::uint8_t val) {
-    vec.push_back(val);
-    return vec;
-}
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
 
-std::vector<std::uint8_t>& operator<<(std::vector<std::uint8_t>& vec, std::uint16_t val) {
-    vec.push_back(val & 0xff);
-    vec.push_back((val >> 8) & 0xff);
-    return vec;
-}
+namespace vicedebug {
 
-std::vector<std::uint8_t>& operator<<(std::vector<std::uint8_t>& vec, std::uint32_t val) {
-    vec.push_back(val & 0xff);
-    vec.push_back((val >> 8) & 0xff);
-    vec.push_back((val >> 16) & 0xff);
-    vec.push_back((val >> 24) & 0xff);
-    return vec;
+// Writes value to os, lowest byte first, as the export formats store numbers.
+template<typename T>
+void writeLittleEndian(std::ostream& os, T value) {
+    for (std::size_t i = 0; i < sizeof(T); i++) {
+        os.put((char)((std::uint64_t)value >> (8 * i)));
+    }
 }
 
 }
-
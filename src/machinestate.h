@@ -19,11 +19,14 @@
 
 #pragma once
 
+#include <array>
 #include <vector>
 #include <cstdint>
 #include <string>
 #include <unordered_map>
 
+#include "memoryimage.h"
+
 namespace vicedebug {
 
 enum class Cpu {
@@ -49,6 +52,13 @@ struct Bank {
 };
 
 typedef std::vector<Bank> Banks;
+
+// An inclusive address range in a bank.
+struct MemoryRange {
+    std::uint16_t bankId;
+    std::uint16_t start;
+    std::uint16_t end;
+};
 typedef std::vector<Cpu> Cpus;
 
 class Registers {
@@ -79,26 +89,35 @@ public:
         SP
     };
 
+    static constexpr const int kNofRegisters = SP + 1;
+
     bool contains(ID id) const {
-        return values.contains(id);
+        return (present_ >> id) & 1;
     }
 
+    // Registers that are not present read as 0.
     std::uint16_t operator[](ID id) const {
-        return values[id];
+        return values_[id];
     }
 
+    // Marks the register as present.
     std::uint16_t& operator[](ID id) {
-        return values[id];
+        present_ |= 1u << id;
+        return values_[id];
     }
 
 private:
-    mutable std::unordered_map<ID, std::uint16_t> values;
+    std::array<std::uint16_t, kNofRegisters> values_{};
+    std::uint32_t present_ = 0;
+
+    static_assert(kNofRegisters <= 32);
 };
 
 struct MachineState {
     System system;
     std::uint16_t cpuBankId;
-    std::unordered_map<std::uint16_t, std::vector<std::uint8_t>> memory;
+    // Copies share the pages, so views keep their own copy of the state.
+    std::unordered_map<std::uint16_t, MemoryImage> memory;
     Registers regs;
     Cpu activeCpu;
     Cpus availableCpus;
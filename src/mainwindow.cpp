@@ -30,6 +30,9 @@
 #include <QMessageBox>
 #include <QShortcut>
 #include <QFileDialog>
+#include <QInputDialog>
+#include <QLineEdit>
+#include <QStatusBar>
 
 #include "resources.h"
 #include "symtab.h"
@@ -57,6 +60,11 @@ namespace vicedebug {
 
 MainWindow::MainWindow(Controller* controller, QWidget* parent)
     : QMainWindow(parent),
+      latencyWidget_(nullptr),
+      profilerWidget_(nullptr),
+      coverageWidget_(nullptr),
+      rasterProfilerWidget_(nullptr),
+      lastStepCount_(100),
       controller_(controller)
 {       
     createActions();
@@ -72,6 +80,7 @@ MainWindow::MainWindow(Controller* controller, QWidget* parent)
     connect(controller_, &Controller::disconnected, this, &MainWindow::onDisconnected);
     connect(controller_, &Controller::executionPaused, this, &MainWindow::onExecutionPaused);
     connect(controller_, &Controller::executionResumed, this, &MainWindow::onExecutionResumed);
+    connect(controller_, &Controller::steppingFinished, this, &MainWindow::onSteppingFinished);
 
     updateUiState();
 }
@@ -100,6 +109,7 @@ void MainWindow::createActions() {
     loadSymbolsAction_ = a;
 
     emulatorRunning_ = false;
+    stepping_ = false;
     connected_ = false;
     a = new QAction(Resources::loadColoredIcon(kCol2, ":/images/codicons/debug-continue.svg"), tr("Continue"));
     a->setShortcut(Qt::Key_F5);
@@ -137,6 +147,38 @@ void MainWindow::createActions() {
     stepOverAction_ = a;
     connect(stepOverAction_, &QAction::triggered, this, &MainWindow::onStepOverClicked);
 
+    a = new QAction(tr("Step N..."));
+    a->setEnabled(false);
+    a->setToolTip(tr("Execute a number of instructions at once"));
+    stepNAction_ = a;
+    connect(stepNAction_, &QAction::triggered, this, &MainWindow::onStepNClicked);
+
+    a = new QAction(tr("Step until..."));
+    a->setEnabled(false);
+    a->setToolTip(tr("Step until a condition on registers and memory holds"));
+    stepUntilAction_ = a;
+    connect(stepUntilAction_, &QAction::triggered, this, &MainWindow::onStepUntilClicked);
+
+    a = new QAction(tr("Latency..."));
+    a->setToolTip(tr("Show where the time between a step and the repaint goes"));
+    showLatencyAction_ = a;
+    connect(showLatencyAction_, &QAction::triggered, this, &MainWindow::onShowLatencyClicked);
+
+    a = new QAction(tr("Profiler..."));
+    a->setToolTip(tr("Count how often routines or address blocks are executed"));
+    showProfilerAction_ = a;
+    connect(showProfilerAction_, &QAction::triggered, this, &MainWindow::onShowProfilerClicked);
+
+    a = new QAction(tr("Code coverage..."));
+    a->setToolTip(tr("Record which code runs"));
+    showCoverageAction_ = a;
+    connect(showCoverageAction_, &QAction::triggered, this, &MainWindow::onShowCoverageClicked);
+
+    a = new QAction(tr("Raster profiler..."));
+    a->setToolTip(tr("Measure the raster time of routines"));
+    showRasterProfilerAction_ = a;
+    connect(showRasterProfilerAction_, &QAction::triggered, this, &MainWindow::onShowRasterProfilerClicked);
+
     // We start with only "continue" visible
     pauseAction_->setVisible(false);
 
@@ -186,6 +228,13 @@ void MainWindow::createMenuBar() {
     debugMenu->addAction(stepOverAction_);
     debugMenu->addAction(stepInAction_);
     debugMenu->addAction(stepOutAction_);
+    debugMenu->addAction(stepNAction_);
+    debugMenu->addAction(stepUntilAction_);
+    debugMenu->addSeparator();
+    debugMenu->addAction(showLatencyAction_);
+    debugMenu->addAction(showProfilerAction_);
+    debugMenu->addAction(showCoverageAction_);
+    debugMenu->addAction(showRasterProfilerAction_);
 
 
 
@@ -304,18 +353,53 @@ void MainWindow::onLoadSymbolsClicked() {
 }
 
 void MainWindow::onStepInClicked() {
+    stepping_ = true;
     controller_->stepIn();
 }
 
 void MainWindow::onStepOutClicked() {
+    stepping_ = true;
     controller_->stepOut();
 }
 
 void MainWindow::onStepOverClicked() {
+    stepping_ = true;
     controller_->stepOver();
 }
 
+void MainWindow::onStepNClicked() {
+    bool ok;
+    int count = QInputDialog::getInt(this, tr("Step N"), tr("Number of instructions:"), lastStepCount_, 1, 0xffff, 1, &ok);
+    if (!ok) {
+        return;
+    }
+    lastStepCount_ = count;
+    controller_->stepN(count, false);
+}
+
+void MainWindow::onStepUntilClicked() {
+    bool ok;
+    QString text = QInputDialog::getText(this, tr("Step until"),
+        tr("Condition, e.g. \"PC == $c000\" or \"A != 0 && [$d020] == $0e\":"), QLineEdit::Normal, lastStepCondition_, &ok);
+    if (!ok || text.trimmed().isEmpty()) {
+        return;
+    }
+    std::string error;
+    auto condition = StepCondition::parse(text.toStdString(), error);
+    if (!condition.has_value()) {
+        QMessageBox::warning(this, tr("Invalid condition"), QString::fromStdString(error));
+        return;
+    }
+    lastStepCondition_ = text;
+    controller_->stepUntil(condition.value(), false);
+}
+
+void MainWindow::onSteppingFinished(int steps, double stepsPerSecond) {
+    statusBar()->showMessage(tr("%1 steps, %2 steps/s").arg(steps).arg(stepsPerSecond, 0, 'f', 1), 10000);
+}
+
 void MainWindow::onContinueClicked() {
+    stepping_ = false;
     continueAction_->setEnabled(false); // Will be re-enabled in the response from the emulator
     controller_->resumeExecution();
 }
@@ -325,6 +409,38 @@ void MainWindow::onPauseClicked() {
     controller_->pauseExecution();
 }
 
+void MainWindow::onShowLatencyClicked() {
+    if (latencyWidget_ == nullptr) {
+        latencyWidget_ = new LatencyWidget(this);
+    }
+    latencyWidget_->show();
+    latencyWidget_->raise();
+}
+
+void MainWindow::onShowProfilerClicked() {
+    if (profilerWidget_ == nullptr) {
+        profilerWidget_ = new ProfilerWidget(controller_, &symtab_, this);
+    }
+    profilerWidget_->show();
+    profilerWidget_->raise();
+}
+
+void MainWindow::onShowCoverageClicked() {
+    if (coverageWidget_ == nullptr) {
+        coverageWidget_ = new CoverageWidget(controller_, this);
+    }
+    coverageWidget_->show();
+    coverageWidget_->raise();
+}
+
+void MainWindow::onShowRasterProfilerClicked() {
+    if (rasterProfilerWidget_ == nullptr) {
+        rasterProfilerWidget_ = new RasterProfilerWidget(controller_, &symtab_, this);
+    }
+    rasterProfilerWidget_->show();
+    rasterProfilerWidget_->raise();
+}
+
 void MainWindow::onAboutClicked() {
     AboutDialog dlg(this);
     dlg.exec();
@@ -376,13 +492,18 @@ void MainWindow::onDisconnected() {
 
     connected_ = false;
     emulatorRunning_ = true;
+    stepping_ = false;
     updateDebugControlButtons();
 }
 
 void MainWindow::updateDebugControlButtons() {
-    stepInAction_->setEnabled(connected_ && !emulatorRunning_);
-    stepOutAction_->setEnabled(connected_ && !emulatorRunning_);
-    stepOverAction_->setEnabled(connected_ && !emulatorRunning_);
+    // Holding a step key keeps stepping, the controller queues the steps.
+    bool canStep = connected_ && (!emulatorRunning_ || stepping_);
+    stepInAction_->setEnabled(canStep);
+    stepOutAction_->setEnabled(canStep);
+    stepOverAction_->setEnabled(canStep);
+    stepNAction_->setEnabled(connected_ && !emulatorRunning_);
+    stepUntilAction_->setEnabled(connected_ && !emulatorRunning_);
     continueAction_->setEnabled(connected_ && !emulatorRunning_);
     continueAction_->setVisible(connected_ && !emulatorRunning_);
     pauseAction_->setEnabled(connected_ && emulatorRunning_);
@@ -396,6 +517,7 @@ void MainWindow::onExecutionResumed() {
 
 void MainWindow::onExecutionPaused(const MachineState& state) {
     emulatorRunning_ = false;
+    stepping_ = false;
     updateDebugControlButtons();
 }
 
@@ -26,6 +26,10 @@
 
 #include "widgets/disassemblywidget.h"
 #include "widgets/memorywidget.h"
+#include "widgets/latencywidget.h"
+#include "widgets/coveragewidget.h"
+#include "widgets/profilerwidget.h"
+#include "widgets/rasterprofilerwidget.h"
 #include "controller.h"
 #include "symtab.h"
 
@@ -52,11 +56,18 @@ private slots:
     void onStepInClicked();
     void onStepOutClicked();
     void onStepOverClicked();
+    void onStepNClicked();
+    void onStepUntilClicked();
     void onAboutClicked();
+    void onShowLatencyClicked();
+    void onShowProfilerClicked();
+    void onShowCoverageClicked();
+    void onShowRasterProfilerClicked();
 
     // Other slots
     void onExecutionResumed();
     void onExecutionPaused(const MachineState& state);
+    void onSteppingFinished(int steps, double stepsPerSecond);
 
     void onConnected(const MachineState& state);
     void onConnectionFailed();
@@ -74,6 +85,10 @@ private:
     SymTable symtab_;
 
     MemoryWidget* memoryWidget_;
+    LatencyWidget* latencyWidget_;
+    ProfilerWidget* profilerWidget_;
+    CoverageWidget* coverageWidget_;
+    RasterProfilerWidget* rasterProfilerWidget_;
 
     QAction* connectAction_;
     QAction* disconnectAction_;
@@ -85,6 +100,12 @@ private:
     QAction* stepInAction_;
     QAction* stepOutAction_;
     QAction* stepOverAction_;
+    QAction* stepNAction_;
+    QAction* stepUntilAction_;
+    QAction* showLatencyAction_;
+    QAction* showProfilerAction_;
+    QAction* showCoverageAction_;
+    QAction* showRasterProfilerAction_;
 
     // Find actions
     QAction* findTextAction_;
@@ -92,6 +113,10 @@ private:
 
     bool connected_;
     bool emulatorRunning_;
+    bool stepping_; // Running because of a single step
+
+    int lastStepCount_;
+    QString lastStepCondition_;
 
     Controller* controller_;
 };
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "memoryedittransaction.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace vicedebug {
+
+namespace {
+
+int hexValue(char c) {
+    if ('0' <= c && c <= '9') {
+        return c - '0';
+    } else if ('a' <= c && c <= 'f') {
+        return 10 + c - 'a';
+    } else if ('A' <= c && c <= 'F') {
+        return 10 + c - 'A';
+    }
+    return -1;
+}
+
+}
+
+void MemoryEditTransaction::mark(std::uint16_t addr, std::uint8_t value) {
+    if (values_.empty()) {
+        values_.resize(0x10000);
+    }
+    values_[addr] = value;
+    if (!dirty_[addr]) {
+        dirty_[addr] = true;
+        size_++;
+    }
+    first_ = std::min(first_, (int)addr);
+    last_ = std::max(last_, (int)addr);
+}
+
+void MemoryEditTransaction::set(std::uint16_t addr, std::uint8_t value) {
+    mark(addr, value);
+}
+
+void MemoryEditTransaction::write(std::uint16_t addr, const std::vector<std::uint8_t>& data) {
+    for (std::size_t i = 0; i < data.size() && addr + i <= 0xffff; i++) {
+        mark(addr + i, data[i]);
+    }
+}
+
+void MemoryEditTransaction::fill(std::uint16_t start, std::uint16_t end, std::uint8_t value) {
+    for (int addr = start; addr <= end; addr++) {
+        mark(addr, value);
+    }
+}
+
+std::vector<MemoryEditTransaction::Run> MemoryEditTransaction::runs() const {
+    std::vector<Run> res;
+    int addr = first_;
+    while (addr <= last_) {
+        if (!dirty_[addr]) {
+            addr++;
+            continue;
+        }
+        int end = addr;
+        while (end < last_ && dirty_[end + 1]) {
+            end++;
+        }
+        res.push_back(Run{(std::uint16_t)addr, std::vector<std::uint8_t>(values_.begin() + addr, values_.begin() + end + 1)});
+        addr = end + 1;
+    }
+    return res;
+}
+
+std::optional<std::vector<std::uint8_t>> parseHexBytes(const std::string& text) {
+    std::vector<std::uint8_t> res;
+    std::size_t pos = 0;
+    while (pos < text.size()) {
+        if (std::isspace((unsigned char)text[pos]) || text[pos] == ',') {
+            pos++;
+            continue;
+        }
+        // A token: optional prefix, then an even number of hex digits.
+        if (text[pos] == '$') {
+            pos++;
+        } else if (text.compare(pos, 2, "0x") == 0 || text.compare(pos, 2, "0X") == 0) {
+            pos += 2;
+        }
+        std::size_t start = pos;
+        while (pos < text.size() && hexValue(text[pos]) >= 0) {
+            pos++;
+        }
+        std::size_t len = pos - start;
+        if (len == 0 || len % 2 != 0) {
+            return std::nullopt;
+        }
+        for (std::size_t i = start; i < pos; i += 2) {
+            res.push_back(hexValue(text[i]) << 4 | hexValue(text[i + 1]));
+        }
+    }
+    return res;
+}
+
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <bitset>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace vicedebug {
+
+// Collects edits to the memory of one bank, so that they can be sent to VICE
+// together. Later edits of the same address overwrite earlier ones.
+class MemoryEditTransaction {
+public:
+    // Contiguous bytes starting at addr.
+    struct Run {
+        std::uint16_t addr;
+        std::vector<std::uint8_t> data;
+
+        std::uint16_t end() const {
+            return addr + data.size() - 1;
+        }
+    };
+
+    void set(std::uint16_t addr, std::uint8_t value);
+
+    // Bytes that would go beyond 0xffff are dropped.
+    void write(std::uint16_t addr, const std::vector<std::uint8_t>& data);
+
+    // Sets all bytes in [start, end] to value.
+    void fill(std::uint16_t start, std::uint16_t end, std::uint8_t value);
+
+    bool empty() const {
+        return size_ == 0;
+    }
+
+    // Number of edited bytes.
+    std::size_t size() const {
+        return size_;
+    }
+
+    // The edits, with adjacent bytes merged into runs, in ascending order.
+    std::vector<Run> runs() const;
+
+private:
+    void mark(std::uint16_t addr, std::uint8_t value);
+
+    // Values of the whole bank, allocated with the first edit. dirty_ tells
+    // which of them are edited, first_ and last_ bound the edited addresses.
+    std::vector<std::uint8_t> values_;
+    std::bitset<0x10000> dirty_;
+    std::size_t size_ = 0;
+    int first_ = 0x10000;
+    int last_ = -1;
+};
+
+// Parses bytes written as hex, like "a9 00 8d 20 d0", "A9008D20D0" or
+// "$a9, $00, 0x8d". Returns an empty optional if text is not valid.
+std::optional<std::vector<std::uint8_t>> parseHexBytes(const std::string& text);
+
+}
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "memoryimage.h"
+
+#include <algorithm>
+
+namespace vicedebug {
+
+MemoryImage::MemoryImage(std::size_t size)
+    : pages_(std::make_shared<PageTable>()), size_(std::min<std::size_t>(size, 0x10000)) {
+}
+
+const std::vector<std::uint8_t>& MemoryImage::bytes() const {
+    if (!pages_->flatValid) {
+        pages_->flat.assign(size_, 0);
+        for (std::size_t page = 0; page * kPageSize < size_; page++) {
+            const Page* p = pages_->pages[page].get();
+            if (p != nullptr) {
+                std::size_t len = std::min(kPageSize, size_ - page * kPageSize);
+                std::copy(p->begin(), p->begin() + len, pages_->flat.begin() + page * kPageSize);
+            }
+        }
+        pages_->flatValid = true;
+    }
+    return pages_->flat;
+}
+
+bool MemoryImage::isPresent(std::uint16_t start, std::uint16_t end) const {
+    if (end >= size_) {
+        return false;
+    }
+    for (int page = pageOf(start); page <= pageOf(end); page++) {
+        if (!present_[page]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<std::pair<std::uint16_t, std::uint16_t>> MemoryImage::missingRanges(std::uint16_t start, std::uint16_t end, const std::bitset<kMaxPages>& ignore) const {
+    std::vector<std::pair<std::uint16_t, std::uint16_t>> res;
+    if (size_ == 0) {
+        return res;
+    }
+    if (end >= size_) {
+        end = size_ - 1;
+    }
+    int runStart = -1;
+    for (int page = pageOf(start); page <= pageOf(end); page++) {
+        if (!present_[page] && !ignore[page]) {
+            if (runStart < 0) {
+                runStart = page;
+            }
+            continue;
+        }
+        if (runStart >= 0) {
+            res.push_back({runStart * kPageSize, page * kPageSize - 1});
+            runStart = -1;
+        }
+    }
+    if (runStart >= 0) {
+        res.push_back({runStart * kPageSize, (pageOf(end) + 1) * kPageSize - 1});
+    }
+    return res;
+}
+
+MemoryImage::Page& MemoryImage::writablePage(std::uint16_t page) {
+    if (pages_.use_count() > 1) {
+        // Copies the page pointers only, the pages stay shared.
+        auto table = std::make_shared<PageTable>();
+        table->pages = pages_->pages;
+        pages_ = table;
+    }
+    pages_->flatValid = false;
+    std::shared_ptr<Page>& p = pages_->pages[page];
+    if (p == nullptr) {
+        p = std::make_shared<Page>();
+        p->fill(0);
+    } else if (p.use_count() > 1) {
+        p = std::make_shared<Page>(*p);
+    }
+    return *p;
+}
+
+void MemoryImage::write(std::uint16_t addr, const std::vector<std::uint8_t>& data) {
+    std::size_t len = std::min(data.size(), size_ - std::min<std::size_t>(addr, size_));
+    if (len == 0) {
+        return;
+    }
+    std::size_t end = addr + len; // exclusive
+    for (std::size_t pos = addr; pos < end;) {
+        std::size_t page = pos / kPageSize;
+        std::size_t ofs = pos % kPageSize;
+        std::size_t n = std::min(kPageSize - ofs, end - pos);
+        Page& p = writablePage(page);
+        std::copy(data.begin() + (pos - addr), data.begin() + (pos - addr + n), p.begin() + ofs);
+        pos += n;
+    }
+
+    std::size_t firstFullPage = (addr + kPageSize - 1) / kPageSize;
+    std::size_t lastFullPage = end / kPageSize; // exclusive
+    for (std::size_t page = firstFullPage; page < lastFullPage; page++) {
+        present_[page] = true;
+    }
+}
+
+void MemoryImage::invalidate() {
+    present_.reset();
+}
+
+}
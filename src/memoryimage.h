@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace vicedebug {
+
+// The memory of one bank, as far as it is known.
+//
+// Memory is tracked in pages of kPageSize bytes. Pages are only fetched from
+// VICE when somebody needs them, so an image usually only contains a few
+// present pages. Bytes of absent pages read as 0.
+//
+// Images are cheap to copy: copies share the page table and the pages, and
+// write() only copies what is still shared (copy on write). The machine state
+// of a stop can therefore be handed to every view without copying memory.
+// Images are not thread safe.
+class MemoryImage {
+public:
+    static constexpr const std::size_t kPageSize = 256;
+    static constexpr const std::size_t kMaxPages = 0x10000 / kPageSize;
+
+    explicit MemoryImage(std::size_t size = 0x10000);
+
+    static constexpr std::uint16_t pageOf(std::uint16_t addr) {
+        return addr / kPageSize;
+    }
+
+    std::size_t size() const {
+        return size_;
+    }
+
+    std::uint8_t operator[](std::size_t addr) const {
+        const Page* page = pages_->pages[addr / kPageSize].get();
+        return page != nullptr ? (*page)[addr % kPageSize] : 0;
+    }
+
+    // All bytes of the image, including absent pages. The flat copy is made on
+    // the first call, and shared by all copies of the image until a write.
+    const std::vector<std::uint8_t>& bytes() const;
+
+    bool isPagePresent(std::uint16_t page) const {
+        return present_[page];
+    }
+
+    bool isPresent(std::uint16_t addr) const {
+        return present_[pageOf(addr)];
+    }
+
+    // Returns true if all bytes in [start, end] are present.
+    bool isPresent(std::uint16_t start, std::uint16_t end) const;
+
+    // Returns the absent parts of [start, end] as page aligned [start, end] ranges.
+    // Adjacent absent pages are merged into a single range. Pages in "ignore" are
+    // treated as if they were present.
+    std::vector<std::pair<std::uint16_t, std::uint16_t>> missingRanges(std::uint16_t start, std::uint16_t end, const std::bitset<kMaxPages>& ignore = {}) const;
+
+    // Writes data starting at addr. Pages that are covered completely become present.
+    void write(std::uint16_t addr, const std::vector<std::uint8_t>& data);
+
+    // Forgets about all pages.
+    void invalidate();
+
+    // Returns true if both images share the storage of page. For tests.
+    bool sharesPageWith(const MemoryImage& other, std::uint16_t page) const {
+        return pages_->pages[page] != nullptr && pages_->pages[page] == other.pages_->pages[page];
+    }
+
+private:
+    using Page = std::array<std::uint8_t, kPageSize>;
+
+    struct PageTable {
+        // nullptr for pages that were never written.
+        std::array<std::shared_ptr<Page>, kMaxPages> pages;
+        // Cache for bytes(), built on demand.
+        mutable std::vector<std::uint8_t> flat;
+        mutable bool flatValid = false;
+    };
+
+    // Returns a page table and page that are not shared with any other image.
+    Page& writablePage(std::uint16_t page);
+
+    std::shared_ptr<PageTable> pages_;
+    std::bitset<kMaxPages> present_;
+    std::size_t size_;
+};
+
+}
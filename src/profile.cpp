@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "profile.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace vicedebug {
+
+std::vector<ProfileRegion> Profile::routineRegions(std::vector<std::pair<std::string, std::uint16_t>> symbols) {
+    std::sort(symbols.begin(), symbols.end(), [](const auto& s1, const auto& s2) {
+        if (s1.second == s2.second) {
+            return s1.first < s2.first;
+        }
+        return s1.second < s2.second;
+    });
+    std::vector<ProfileRegion> regions;
+    for (const auto& s : symbols) {
+        if (!regions.empty() && regions.back().start == s.second) {
+            // Several labels for the same address.
+            regions.back().name += ", " + s.first;
+            continue;
+        }
+        if (regions.size() == kMaxRegions) {
+            break;
+        }
+        regions.push_back(ProfileRegion{s.first, s.second, s.second});
+    }
+    return regions;
+}
+
+std::vector<ProfileRegion> Profile::bucketRegions(int bucketSize) {
+    bucketSize = std::clamp(bucketSize, (int)(0x10000 / kMaxRegions), 0x10000);
+    std::vector<ProfileRegion> regions;
+    char name[16];
+    for (int start = 0; start < 0x10000; start += bucketSize) {
+        int end = std::min(start + bucketSize - 1, 0xffff);
+        std::snprintf(name, sizeof(name), "$%04x-$%04x", start, end);
+        regions.push_back(ProfileRegion{name, (std::uint16_t)start, (std::uint16_t)end});
+    }
+    return regions;
+}
+
+void Profile::add(const ProfileRegion& region, std::uint32_t checkpointNumber) {
+    entries_.push_back(ProfileEntry{region, checkpointNumber, 0, 0});
+}
+
+void Profile::update(const std::unordered_map<std::uint32_t, std::uint32_t>& hitCounts) {
+    for (auto& e : entries_) {
+        auto it = hitCounts.find(e.checkpointNumber);
+        if (it == hitCounts.end()) {
+            e.delta = 0;
+            continue;
+        }
+        // VICE's counters are 32 bits wide; count on across a wrap around.
+        std::uint32_t delta = it->second - (std::uint32_t)e.hits;
+        e.delta = delta;
+        e.hits += delta;
+    }
+}
+
+std::uint64_t Profile::totalHits() const {
+    std::uint64_t total = 0;
+    for (const auto& e : entries_) {
+        total += e.hits;
+    }
+    return total;
+}
+
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace vicedebug {
+
+// An address range the profiler counts executed instructions in. For
+// routines, the range is just the entry point, so the count is the number
+// of calls.
+struct ProfileRegion {
+    std::string name;
+    std::uint16_t start;
+    std::uint16_t end;
+};
+
+struct ProfileEntry {
+    ProfileRegion region;
+    std::uint32_t checkpointNumber;
+    std::uint64_t hits; // Since the profiler was started
+    std::uint64_t delta; // Since the previous update
+};
+
+// Hit counts of the profiler's checkpoints. VICE counts the hits of
+// checkpoints that don't stop the emulation at full speed, so the profile
+// only needs to be refreshed from the checkpoint list now and then.
+class Profile {
+public:
+    // Every checkpoint slows VICE down a bit, so the number of regions is capped.
+    static constexpr const std::size_t kMaxRegions = 1024;
+
+    // One region per distinct symbol address, at most kMaxRegions.
+    static std::vector<ProfileRegion> routineRegions(std::vector<std::pair<std::string, std::uint16_t>> symbols);
+    // Consecutive blocks of bucketSize bytes, covering the whole address space.
+    static std::vector<ProfileRegion> bucketRegions(int bucketSize);
+
+    void add(const ProfileRegion& region, std::uint32_t checkpointNumber);
+
+    // Takes VICE's hit counts, by checkpoint number. Entries that are not in
+    // hitCounts keep their counts, and their delta is 0.
+    void update(const std::unordered_map<std::uint32_t, std::uint32_t>& hitCounts);
+
+    const std::vector<ProfileEntry>& entries() const {
+        return entries_;
+    }
+
+    std::uint64_t totalHits() const;
+
+private:
+    std::vector<ProfileEntry> entries_;
+};
+
+}
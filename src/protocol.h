@@ -0,0 +1,665 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <span>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+// Encoding and decoding of the messages of VICE's binary monitor protocol.
+//
+// Every message layout is described once, by listing the members that go on
+// the wire in a static kFields tuple:
+//
+//     struct CheckpointToggleCommand {
+//         static constexpr const BinaryCommand kCommand = CMD_CHECKPOINT_TOGGLE;
+//         std::uint32_t number;
+//         bool enabled;
+//         static constexpr auto kFields = std::make_tuple(&CheckpointToggleCommand::number, &CheckpointToggleCommand::enabled);
+//     };
+//
+// Members are encoded in order, little endian:
+//   - bool, std::uint8_t, std::uint16_t, std::uint32_t: 1, 1, 2, 4 bytes
+//   - std::string: 1 byte length, followed by the characters
+//   - std::vector<std::uint8_t>: 2 bytes length, followed by the bytes
+//   - std::span<const std::uint8_t>: the bytes, up to the end of the body.
+//     Decoding yields a view into the body.
+//   - std::map<K, V>: 2 bytes count, followed by one item per entry. Items are
+//     1 byte item size (excluding itself), the key, and the value. Decoding
+//     skips item bytes it doesn't know about.
+//   - Any other type with kFields, inline.
+//
+// Sizes of messages that consist of fixed size members only are known at
+// compile time (kEncodedSize). Encoding computes the size first and then
+// writes into a preallocated buffer; decoding is bounds checked and reports
+// truncated messages instead of reading past their end.
+
+namespace vicedebug {
+
+enum BinaryCommand {
+    // Copied from https://sourceforge.net/p/vice-emu/code/HEAD/tree/trunk/vice/src/monitor/monitor_binary.c
+    CMD_INVALID = 0x00,
+
+    CMD_MEM_GET = 0x01,
+    CMD_MEM_SET = 0x02,
+
+    CMD_CHECKPOINT_GET = 0x11,
+    CMD_CHECKPOINT_SET = 0x12,
+    CMD_CHECKPOINT_DELETE = 0x13,
+    CMD_CHECKPOINT_LIST = 0x14,
+    CMD_CHECKPOINT_TOGGLE = 0x15,
+
+    CMD_CONDITION_SET = 0x22,
+
+    CMD_REGISTERS_GET = 0x31,
+    CMD_REGISTERS_SET = 0x32,
+
+    CMD_DUMP = 0x41,
+    CMD_UNDUMP = 0x42,
+
+    CMD_RESOURCE_GET = 0x51,
+    CMD_RESOURCE_SET = 0x52,
+
+    CMD_ADVANCE_INSTRUCTIONS = 0x71,
+    CMD_KEYBOARD_FEED = 0x72,
+    CMD_EXECUTE_UNTIL_RETURN = 0x73,
+
+    CMD_PING = 0x81,
+    CMD_BANKS_AVAILABLE = 0x82,
+    CMD_REGISTERS_AVAILABLE = 0x83,
+    CMD_DISPLAY_GET = 0x84,
+    CMD_VICE_INFO = 0x85,
+
+    CMD_PALETTE_GET = 0x91,
+
+    CMD_JOYPORT_SET = 0xa2,
+
+    CMD_USERPORT_SET = 0xb2,
+
+    CMD_EXIT = 0xaa,
+    CMD_QUIT = 0xbb,
+    CMD_RESET = 0xcc,
+    CMD_AUTOSTART = 0xdd,
+};
+
+enum ResponseType {
+    // Copied from https://sourceforge.net/p/vice-emu/code/HEAD/tree/trunk/vice/src/monitor/monitor_binary.c
+
+    RESPONSE_INVALID = 0x00,
+    RESPONSE_MEM_GET = 0x01,
+    RESPONSE_MEM_SET = 0x02,
+
+    RESPONSE_CHECKPOINT_INFO = 0x11,
+
+    RESPONSE_CHECKPOINT_DELETE = 0x13,
+    RESPONSE_CHECKPOINT_LIST = 0x14,
+    RESPONSE_CHECKPOINT_TOGGLE = 0x15,
+
+    RESPONSE_CONDITION_SET = 0x22,
+
+    RESPONSE_REGISTER_INFO = 0x31,
+
+    RESPONSE_DUMP = 0x41,
+    RESPONSE_UNDUMP = 0x42,
+
+    RESPONSE_RESOURCE_GET = 0x51,
+    RESPONSE_RESOURCE_SET = 0x52,
+
+    RESPONSE_JAM = 0x61,
+    RESPONSE_STOPPED = 0x62,
+    RESPONSE_RESUMED = 0x63,
+
+    RESPONSE_ADVANCE_INSTRUCTIONS = 0x71,
+    RESPONSE_KEYBOARD_FEED = 0x72,
+    RESPONSE_EXECUTE_UNTIL_RETURN = 0x73,
+
+    RESPONSE_PING = 0x81,
+    RESPONSE_BANKS_AVAILABLE = 0x82,
+    RESPONSE_REGISTERS_AVAILABLE = 0x83,
+    RESPONSE_DISPLAY_GET = 0x84,
+    RESPONSE_VICE_INFO = 0x85,
+
+    RESPONSE_PALETTE_GET = 0x91,
+
+    RESPONSE_JOYPORT_SET = 0xa2,
+
+    RESPONSE_USERPORT_SET = 0xb2,
+
+    RESPONSE_EXIT = 0xaa,
+    RESPONSE_QUIT = 0xbb,
+    RESPONSE_RESET = 0xcc,
+    RESPONSE_AUTOSTART = 0xdd,
+};
+
+constexpr const std::uint8_t kProtocolStx = 0x02;
+constexpr const std::uint8_t kProtocolApiVersion = 0x02;
+constexpr const std::uint32_t kOobRequestId = 0xffffffff;
+
+template<typename T>
+concept Described = requires { T::kFields; };
+
+class ByteWriter {
+public:
+    explicit ByteWriter(std::span<std::uint8_t> out)
+        : out_(out), pos_(0), ok_(true) {}
+
+    void u8(std::uint8_t val) {
+        if (reserve(1)) {
+            out_[pos_++] = val;
+        }
+    }
+
+    void u16(std::uint16_t val) {
+        store(val);
+    }
+
+    void u32(std::uint32_t val) {
+        store(val);
+    }
+
+    void bytes(std::span<const std::uint8_t> data) {
+        if (!data.empty() && reserve(data.size())) {
+            std::memcpy(out_.data() + pos_, data.data(), data.size());
+            pos_ += data.size();
+        }
+    }
+
+    std::size_t written() const {
+        return pos_;
+    }
+
+    bool ok() const {
+        return ok_;
+    }
+
+private:
+    bool reserve(std::size_t n) {
+        if (!ok_ || out_.size() - pos_ < n) {
+            ok_ = false;
+            return false;
+        }
+        return true;
+    }
+
+    template<typename U>
+    void store(U val) {
+        if (!reserve(sizeof(U))) {
+            return;
+        }
+        if constexpr (std::endian::native == std::endian::little) {
+            std::memcpy(out_.data() + pos_, &val, sizeof(U));
+        } else {
+            for (std::size_t i = 0; i < sizeof(U); i++) {
+                out_[pos_ + i] = (std::uint8_t)(val >> (8 * i));
+            }
+        }
+        pos_ += sizeof(U);
+    }
+
+    std::span<std::uint8_t> out_;
+    std::size_t pos_;
+    bool ok_;
+};
+
+// Reads from a message body. Reading past the end yields zeros and makes
+// ok() return false.
+class ByteReader {
+public:
+    explicit ByteReader(std::span<const std::uint8_t> data)
+        : data_(data), pos_(0), ok_(true) {}
+
+    std::uint8_t u8() {
+        return reserve(1) ? data_[pos_++] : 0;
+    }
+
+    std::uint16_t u16() {
+        return load<std::uint16_t>();
+    }
+
+    std::uint32_t u32() {
+        return load<std::uint32_t>();
+    }
+
+    std::span<const std::uint8_t> bytes(std::size_t n) {
+        if (!reserve(n)) {
+            return {};
+        }
+        auto res = data_.subspan(pos_, n);
+        pos_ += n;
+        return res;
+    }
+
+    std::span<const std::uint8_t> rest() {
+        return bytes(remaining());
+    }
+
+    std::size_t remaining() const {
+        return data_.size() - pos_;
+    }
+
+    bool ok() const {
+        return ok_;
+    }
+
+private:
+    bool reserve(std::size_t n) {
+        if (!ok_ || remaining() < n) {
+            ok_ = false;
+            return false;
+        }
+        return true;
+    }
+
+    template<typename U>
+    U load() {
+        if (!reserve(sizeof(U))) {
+            return 0;
+        }
+        U val = 0;
+        if constexpr (std::endian::native == std::endian::little) {
+            std::memcpy(&val, data_.data() + pos_, sizeof(U));
+        } else {
+            for (std::size_t i = 0; i < sizeof(U); i++) {
+                val |= (U)data_[pos_ + i] << (8 * i);
+            }
+        }
+        pos_ += sizeof(U);
+        return val;
+    }
+
+    std::span<const std::uint8_t> data_;
+    std::size_t pos_;
+    bool ok_;
+};
+
+namespace codec {
+
+template<typename M>
+struct MemberType;
+
+template<typename C, typename V>
+struct MemberType<V C::*> {
+    using type = V;
+};
+
+template<typename T>
+struct IsMap : std::false_type {};
+
+template<typename K, typename V>
+struct IsMap<std::map<K, V>> : std::true_type {};
+
+// Calls f.template operator()<M...>() with the types of T's wire members.
+template<typename T, typename F>
+constexpr auto forEachFieldType(F f) {
+    return [&]<typename... P>(std::type_identity<std::tuple<P...>>) {
+        return f.template operator()<typename MemberType<P>::type...>();
+    }(std::type_identity<std::remove_cv_t<decltype(T::kFields)>>{});
+}
+
+template<typename T>
+constexpr bool isFixedSize() {
+    if constexpr (std::is_same_v<T, bool> || std::is_integral_v<T>) {
+        return true;
+    } else if constexpr (Described<T>) {
+        return forEachFieldType<T>([]<typename... M>() {
+            return (isFixedSize<M>() && ...);
+        });
+    } else {
+        return false;
+    }
+}
+
+template<typename T>
+constexpr std::size_t fixedSize() {
+    static_assert(isFixedSize<T>(), "Type has members of variable size");
+    if constexpr (std::is_same_v<T, bool>) {
+        return 1;
+    } else if constexpr (std::is_integral_v<T>) {
+        static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4, "Unsupported integer size");
+        return sizeof(T);
+    } else {
+        return forEachFieldType<T>([]<typename... M>() {
+            return (fixedSize<M>() + ... + 0);
+        });
+    }
+}
+
+template<typename T>
+std::size_t encodedSize(const T& val);
+
+template<typename T>
+std::size_t fieldsSize(const T& val) {
+    return std::apply([&](auto... m) {
+        return (encodedSize(val.*m) + ... + 0);
+    }, T::kFields);
+}
+
+template<typename T>
+std::size_t encodedSize(const T& val) {
+    if constexpr (isFixedSize<T>()) {
+        return fixedSize<T>();
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        return 1 + val.size();
+    } else if constexpr (std::is_same_v<T, std::vector<std::uint8_t>>) {
+        return 2 + val.size();
+    } else if constexpr (std::is_same_v<T, std::span<const std::uint8_t>>) {
+        return val.size();
+    } else if constexpr (IsMap<T>::value) {
+        std::size_t res = 2;
+        for (const auto& p : val) {
+            res += 1 + encodedSize(p.first) + encodedSize(p.second);
+        }
+        return res;
+    } else {
+        static_assert(Described<T>, "Type can't be encoded");
+        return fieldsSize(val);
+    }
+}
+
+template<typename T>
+void write(ByteWriter& w, const T& val) {
+    if constexpr (std::is_same_v<T, bool>) {
+        w.u8(val ? 1 : 0);
+    } else if constexpr (std::is_integral_v<T> && sizeof(T) == 1) {
+        w.u8(val);
+    } else if constexpr (std::is_integral_v<T> && sizeof(T) == 2) {
+        w.u16(val);
+    } else if constexpr (std::is_integral_v<T> && sizeof(T) == 4) {
+        w.u32(val);
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        w.u8(val.size());
+        w.bytes(std::span<const std::uint8_t>((const std::uint8_t*)val.data(), val.size()));
+    } else if constexpr (std::is_same_v<T, std::vector<std::uint8_t>>) {
+        w.u16(val.size());
+        w.bytes(val);
+    } else if constexpr (std::is_same_v<T, std::span<const std::uint8_t>>) {
+        w.bytes(val);
+    } else if constexpr (IsMap<T>::value) {
+        w.u16(val.size());
+        for (const auto& p : val) {
+            w.u8(encodedSize(p.first) + encodedSize(p.second));
+            write(w, p.first);
+            write(w, p.second);
+        }
+    } else {
+        static_assert(Described<T>, "Type can't be encoded");
+        std::apply([&](auto... m) {
+            (write(w, val.*m), ...);
+        }, T::kFields);
+    }
+}
+
+template<typename T>
+void read(ByteReader& r, T& val) {
+    if constexpr (std::is_same_v<T, bool>) {
+        val = r.u8() != 0;
+    } else if constexpr (std::is_integral_v<T> && sizeof(T) == 1) {
+        val = r.u8();
+    } else if constexpr (std::is_integral_v<T> && sizeof(T) == 2) {
+        val = r.u16();
+    } else if constexpr (std::is_integral_v<T> && sizeof(T) == 4) {
+        val = r.u32();
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        auto chars = r.bytes(r.u8());
+        val.assign(chars.begin(), chars.end());
+    } else if constexpr (std::is_same_v<T, std::vector<std::uint8_t>>) {
+        auto bytes = r.bytes(r.u16());
+        val.assign(bytes.begin(), bytes.end());
+    } else if constexpr (std::is_same_v<T, std::span<const std::uint8_t>>) {
+        val = r.rest();
+    } else if constexpr (IsMap<T>::value) {
+        std::uint16_t cnt = r.u16();
+        while (cnt-- > 0 && r.ok()) {
+            ByteReader item(r.bytes(r.u8()));
+            typename T::key_type key{};
+            typename T::mapped_type value{};
+            read(item, key);
+            read(item, value);
+            if (!item.ok() || !r.ok()) {
+                // Truncated item
+                r.bytes(r.remaining() + 1);
+                return;
+            }
+            val[key] = std::move(value);
+        }
+    } else {
+        static_assert(Described<T>, "Type can't be decoded");
+        std::apply([&](auto... m) {
+            (read(r, val.*m), ...);
+        }, T::kFields);
+    }
+}
+
+}
+
+// Encoded size of a message that only has fixed size members.
+template<typename T>
+constexpr std::size_t kEncodedSize = codec::fixedSize<T>();
+
+template<typename T>
+std::size_t encodedSize(const T& msg) {
+    return codec::encodedSize(msg);
+}
+
+// Appends the encoded message to out.
+template<typename T>
+void encodeTo(std::vector<std::uint8_t>& out, const T& msg) {
+    std::size_t pos = out.size();
+    out.resize(pos + encodedSize(msg));
+    ByteWriter w(std::span<std::uint8_t>(out).subspan(pos));
+    codec::write(w, msg);
+}
+
+template<typename T>
+std::vector<std::uint8_t> encode(const T& msg) {
+    std::vector<std::uint8_t> res;
+    encodeTo(res, msg);
+    return res;
+}
+
+// Decodes the members of msg from data. Returns false if data is too short.
+template<typename T>
+bool decode(std::span<const std::uint8_t> data, T& msg) {
+    ByteReader r(data);
+    codec::read(r, msg);
+    return r.ok();
+}
+
+//
+// Message headers
+//
+
+struct RequestHeader {
+    std::uint8_t stx = kProtocolStx;
+    std::uint8_t apiVersion = kProtocolApiVersion;
+    std::uint32_t bodyLength;
+    std::uint32_t requestId;
+    std::uint8_t command;
+
+    static constexpr auto kFields = std::make_tuple(&RequestHeader::stx, &RequestHeader::apiVersion, &RequestHeader::bodyLength, &RequestHeader::requestId, &RequestHeader::command);
+};
+static_assert(kEncodedSize<RequestHeader> == 11);
+
+struct ResponseHeader {
+    std::uint8_t stx = kProtocolStx;
+    std::uint8_t apiVersion = kProtocolApiVersion;
+    std::uint32_t bodyLength;
+    std::uint8_t responseType;
+    std::uint8_t errorCode;
+    std::uint32_t requestId;
+
+    static constexpr auto kFields = std::make_tuple(&ResponseHeader::stx, &ResponseHeader::apiVersion, &ResponseHeader::bodyLength, &ResponseHeader::responseType, &ResponseHeader::errorCode, &ResponseHeader::requestId);
+};
+static_assert(kEncodedSize<ResponseHeader> == 12);
+
+//
+// Commands
+//
+
+struct MemGetCommand {
+    static constexpr const BinaryCommand kCommand = CMD_MEM_GET;
+    bool sideEffects;
+    std::uint16_t startAddress;
+    std::uint16_t endAddress;
+    std::uint8_t memSpace;
+    std::uint16_t bankId;
+
+    static constexpr auto kFields = std::make_tuple(&MemGetCommand::sideEffects, &MemGetCommand::startAddress, &MemGetCommand::endAddress, &MemGetCommand::memSpace, &MemGetCommand::bankId);
+};
+
+struct MemSetCommand {
+    static constexpr const BinaryCommand kCommand = CMD_MEM_SET;
+    bool sideEffects;
+    std::uint16_t startAddress;
+    std::uint16_t endAddress;
+    std::uint8_t memSpace;
+    std::uint16_t bankId;
+    std::span<const std::uint8_t> data;
+
+    static constexpr auto kFields = std::make_tuple(&MemSetCommand::sideEffects, &MemSetCommand::startAddress, &MemSetCommand::endAddress, &MemSetCommand::memSpace, &MemSetCommand::bankId, &MemSetCommand::data);
+};
+
+struct CheckpointGetCommand {
+    static constexpr const BinaryCommand kCommand = CMD_CHECKPOINT_GET;
+    std::uint32_t number;
+
+    static constexpr auto kFields = std::make_tuple(&CheckpointGetCommand::number);
+};
+
+struct CheckpointSetCommand {
+    static constexpr const BinaryCommand kCommand = CMD_CHECKPOINT_SET;
+    std::uint16_t startAddress;
+    std::uint16_t endAddress;
+    bool stopWhenHit;
+    bool enabled;
+    std::uint8_t op; // 0x01: load, 0x02: store, 0x04: exec
+    bool temporary;
+    std::uint8_t memSpace;
+
+    static constexpr auto kFields = std::make_tuple(&CheckpointSetCommand::startAddress, &CheckpointSetCommand::endAddress, &CheckpointSetCommand::stopWhenHit, &CheckpointSetCommand::enabled, &CheckpointSetCommand::op, &CheckpointSetCommand::temporary, &CheckpointSetCommand::memSpace);
+};
+
+// Makes a checkpoint only stop when the condition holds, e.g. "A == $ff".
+// VICE evaluates the condition itself, with the syntax of its monitor's "cond" command.
+struct ConditionSetCommand {
+    static constexpr const BinaryCommand kCommand = CMD_CONDITION_SET;
+    std::uint32_t number;
+    std::string condition;
+
+    static constexpr auto kFields = std::make_tuple(&ConditionSetCommand::number, &ConditionSetCommand::condition);
+};
+
+struct CheckpointDeleteCommand {
+    static constexpr const BinaryCommand kCommand = CMD_CHECKPOINT_DELETE;
+    std::uint32_t number;
+
+    static constexpr auto kFields = std::make_tuple(&CheckpointDeleteCommand::number);
+};
+
+struct CheckpointListCommand {
+    static constexpr const BinaryCommand kCommand = CMD_CHECKPOINT_LIST;
+
+    static constexpr auto kFields = std::make_tuple();
+};
+
+struct CheckpointToggleCommand {
+    static constexpr const BinaryCommand kCommand = CMD_CHECKPOINT_TOGGLE;
+    std::uint32_t number;
+    bool enabled;
+
+    static constexpr auto kFields = std::make_tuple(&CheckpointToggleCommand::number, &CheckpointToggleCommand::enabled);
+};
+
+struct RegistersGetCommand {
+    static constexpr const BinaryCommand kCommand = CMD_REGISTERS_GET;
+    std::uint8_t memSpace;
+
+    static constexpr auto kFields = std::make_tuple(&RegistersGetCommand::memSpace);
+};
+
+struct RegistersSetCommand {
+    static constexpr const BinaryCommand kCommand = CMD_REGISTERS_SET;
+    std::uint8_t memSpace;
+    std::map<std::uint8_t, std::uint16_t> values; // register ID -> value
+
+    static constexpr auto kFields = std::make_tuple(&RegistersSetCommand::memSpace, &RegistersSetCommand::values);
+};
+
+struct AdvanceInstructionsCommand {
+    static constexpr const BinaryCommand kCommand = CMD_ADVANCE_INSTRUCTIONS;
+    bool stepOverSubroutines;
+    std::uint16_t count;
+
+    static constexpr auto kFields = std::make_tuple(&AdvanceInstructionsCommand::stepOverSubroutines, &AdvanceInstructionsCommand::count);
+};
+
+struct ExecuteUntilReturnCommand {
+    static constexpr const BinaryCommand kCommand = CMD_EXECUTE_UNTIL_RETURN;
+
+    static constexpr auto kFields = std::make_tuple();
+};
+
+// Does nothing but answer. Like any command, it makes a running VICE enter the monitor.
+struct PingCommand {
+    static constexpr const BinaryCommand kCommand = CMD_PING;
+
+    static constexpr auto kFields = std::make_tuple();
+};
+
+struct BanksAvailableCommand {
+    static constexpr const BinaryCommand kCommand = CMD_BANKS_AVAILABLE;
+
+    static constexpr auto kFields = std::make_tuple();
+};
+
+struct RegistersAvailableCommand {
+    static constexpr const BinaryCommand kCommand = CMD_REGISTERS_AVAILABLE;
+    std::uint8_t memSpace;
+
+    static constexpr auto kFields = std::make_tuple(&RegistersAvailableCommand::memSpace);
+};
+
+struct ExitCommand {
+    static constexpr const BinaryCommand kCommand = CMD_EXIT;
+
+    static constexpr auto kFields = std::make_tuple();
+};
+
+//
+// Response bodies
+//
+
+// VICE sends the length of a MEM_GET response in 2 bytes, so it wraps to 0
+// for a read of all 64K. The memory is always the rest of the body.
+struct MemGetResponseBody {
+    std::uint16_t length;
+    std::span<const std::uint8_t> memory;
+
+    static constexpr auto kFields = std::make_tuple(&MemGetResponseBody::length, &MemGetResponseBody::memory);
+};
+
+}
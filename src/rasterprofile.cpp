@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "rasterprofile.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "disassembler.h"
+
+namespace vicedebug {
+
+namespace {
+
+bool isReturn(Cpu cpu, const Disassembler::Line& line) {
+    std::uint8_t op = line.bytes[0];
+    if (cpu == Cpu::Z80) {
+        // RET, RETN, RETI
+        return op == 0xc9 || (op == 0xed && line.bytes.size() > 1 && (line.bytes[1] & 0xc7) == 0x45);
+    }
+    // RTS, RTI
+    return op == 0x60 || op == 0x40;
+}
+
+}
+
+int RasterFrame::cycles(int routine) const {
+    int total = 0;
+    for (const auto& span : spans) {
+        if (span.routine == routine) {
+            total += span.cycles;
+        }
+    }
+    return total;
+}
+
+std::optional<std::uint16_t> RasterProfile::findExit(Cpu cpu, const std::vector<std::uint8_t>& memory, std::uint16_t entry) {
+    std::unique_ptr<Disassembler> disassembler = Disassembler::forCpu(cpu);
+    for (const auto& line : disassembler->disassembleForward(entry, memory, kMaxRoutineInstructions)) {
+        if (isReturn(cpu, line)) {
+            return line.addr;
+        }
+    }
+    return std::nullopt;
+}
+
+RasterProfile::RasterProfile(std::vector<RasterRoutine> routines, RasterGeometry geometry)
+    : routines_(std::move(routines)), geometry_(geometry), stats_(routines_.size()), entryPositions_(routines_.size()) {
+}
+
+void RasterProfile::addHit(int routine, bool entry, int line, int cycle) {
+    int frameCycles = geometry_.frameCycles();
+    int pos = (line * geometry_.cyclesPerLine + cycle) % frameCycles;
+    if (frames_.empty() || pos < lastPosition_) {
+        startFrame();
+    }
+    lastPosition_ = pos;
+
+    if (entry) {
+        entryPositions_[routine] = pos;
+        return;
+    }
+    if (!entryPositions_[routine].has_value()) {
+        // The profiler started while the routine ran.
+        return;
+    }
+    // Routines that run longer than a frame can't be told apart from short ones.
+    int cycles = (pos - *entryPositions_[routine] + frameCycles) % frameCycles;
+    entryPositions_[routine].reset();
+    frames_.back().spans.push_back(RasterSpan{routine, pos - cycles, cycles});
+
+    RasterRoutineStats& stats = stats_[routine];
+    stats.minCycles = stats.calls == 0 ? cycles : std::min(stats.minCycles, cycles);
+    stats.maxCycles = std::max(stats.maxCycles, cycles);
+    stats.calls++;
+    stats.totalCycles += cycles;
+    stats.maxCyclesPerFrame = std::max(stats.maxCyclesPerFrame, frames_.back().cycles(routine));
+}
+
+double RasterProfile::averageCyclesPerFrame(int routine) const {
+    return frameCount_ > 0 ? (double)stats_[routine].totalCycles / frameCount_ : 0;
+}
+
+void RasterProfile::startFrame() {
+    if (frames_.size() == kMaxFrames) {
+        frames_.pop_front();
+    }
+    frames_.emplace_back();
+    frameCount_++;
+}
+
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "machinestate.h"
+
+namespace vicedebug {
+
+// Raster lines per frame and cycles per raster line of the video chip.
+struct RasterGeometry {
+    int lines;
+    int cyclesPerLine;
+
+    int frameCycles() const {
+        return lines * cyclesPerLine;
+    }
+};
+
+constexpr const RasterGeometry kRasterPal{312, 63};
+constexpr const RasterGeometry kRasterNtsc{263, 65};
+constexpr const RasterGeometry kRasterOldNtsc{262, 64};
+
+// A routine the raster profiler measures: from the hit of the checkpoint at
+// its entry to the hit of the one at its exit, i.e. excluding the call and
+// the return instruction.
+struct RasterRoutine {
+    std::string name;
+    std::uint16_t entry;
+    std::optional<std::uint16_t> exit; // Looked up with findExit() if empty
+};
+
+// One run of a routine, in the frame it ended in. start is negative if the
+// routine was entered in the frame before.
+struct RasterSpan {
+    int routine;
+    int start; // Cycles since the start of the frame
+    int cycles;
+};
+
+struct RasterFrame {
+    std::vector<RasterSpan> spans;
+
+    int cycles(int routine) const;
+};
+
+struct RasterRoutineStats {
+    std::uint64_t calls = 0;
+    std::uint64_t totalCycles = 0;
+    int minCycles = 0;
+    int maxCycles = 0;
+    int maxCyclesPerFrame = 0;
+};
+
+// Raster time spent in routines, computed from the raster line and cycle
+// VICE reports at the hits of checkpoints at their entries and exits. The
+// raster position is emulated time, so it does not depend on how long VICE
+// stops for each hit.
+class RasterProfile {
+public:
+    // Frames kept for the timeline.
+    static constexpr const std::size_t kMaxFrames = 512;
+
+    // Instructions searched for the return of a routine.
+    static constexpr const int kMaxRoutineInstructions = 1024;
+
+    // The address of the first unconditional return after entry.
+    static std::optional<std::uint16_t> findExit(Cpu cpu, const std::vector<std::uint8_t>& memory, std::uint16_t entry);
+
+    RasterProfile() : geometry_(kRasterPal) {}
+    RasterProfile(std::vector<RasterRoutine> routines, RasterGeometry geometry);
+
+    // A new frame starts whenever the raster position is before the one of
+    // the previous hit, so frames without any hits are not counted.
+    void addHit(int routine, bool entry, int line, int cycle);
+
+    const std::vector<RasterRoutine>& routines() const {
+        return routines_;
+    }
+
+    const RasterGeometry& geometry() const {
+        return geometry_;
+    }
+
+    // The last kMaxFrames frames, oldest first.
+    const std::deque<RasterFrame>& frames() const {
+        return frames_;
+    }
+
+    const RasterRoutineStats& stats(int routine) const {
+        return stats_[routine];
+    }
+
+    std::uint64_t frameCount() const {
+        return frameCount_;
+    }
+
+    double averageCyclesPerFrame(int routine) const;
+
+private:
+    void startFrame();
+
+    std::vector<RasterRoutine> routines_;
+    RasterGeometry geometry_;
+    std::deque<RasterFrame> frames_;
+    std::vector<RasterRoutineStats> stats_;
+    std::vector<std::optional<int>> entryPositions_; // Of routines that were entered, but did not exit yet
+    int lastPosition_ = -1;
+    std::uint64_t frameCount_ = 0;
+};
+
+}
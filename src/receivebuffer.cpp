@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "receivebuffer.h"
+
+#include <cstring>
+
+namespace vicedebug {
+
+ReceiveBuffer::ReceiveBuffer(std::size_t initialCapacity)
+    : buf_(initialCapacity), begin_(0), end_(0) {
+}
+
+std::span<std::uint8_t> ReceiveBuffer::prepare(std::size_t minSize) {
+    if (buf_.size() - end_ < minSize) {
+        // Not enough room at the end. Move the unconsumed bytes to the front first...
+        std::size_t used = size();
+        if (begin_ > 0) {
+            if (used > 0) {
+                std::memmove(buf_.data(), buf_.data() + begin_, used);
+            }
+            begin_ = 0;
+            end_ = used;
+        }
+        // ... and only grow if that wasn't enough.
+        if (buf_.size() - end_ < minSize) {
+            std::size_t newSize = buf_.size() * 2;
+            if (newSize < used + minSize) {
+                newSize = used + minSize;
+            }
+            buf_.resize(newSize);
+        }
+    }
+    return std::span<std::uint8_t>(buf_.data() + end_, buf_.size() - end_);
+}
+
+void ReceiveBuffer::commit(std::size_t len) {
+    end_ += len;
+}
+
+std::span<const std::uint8_t> ReceiveBuffer::nextFrame() {
+    std::size_t available = size();
+    if (available < kHeaderSize) {
+        return {};
+    }
+    const std::uint8_t* frame = buf_.data() + begin_;
+    std::size_t bodyLength = (std::size_t)frame[5] << 24 | frame[4] << 16 | frame[3] << 8 | frame[2];
+    std::size_t frameLength = kHeaderSize + bodyLength;
+    if (available < frameLength) {
+        return {};
+    }
+    begin_ += frameLength;
+    if (begin_ == end_) {
+        // Everything consumed, start over at the beginning. The span stays
+        // valid, as the bytes are only overwritten by the next prepare().
+        begin_ = end_ = 0;
+    }
+    return std::span<const std::uint8_t>(frame, frameLength);
+}
+
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace vicedebug {
+
+// Receive buffer for the binary monitor protocol.
+//
+// Bytes are read from the socket in bulk directly into the buffer, and
+// complete frames (12 byte header plus body) are handed out as spans that
+// point into the buffer, so a frame is never copied on its way to the
+// decoder. Consumed bytes are reclaimed lazily: the read position wraps back
+// to the start whenever the buffer runs empty, and a partial frame is only
+// moved to the front when there's not enough room left at the end.
+//
+// Spans returned by nextFrame() stay valid until the next call to prepare().
+class ReceiveBuffer {
+public:
+    static constexpr const std::size_t kHeaderSize = 12;
+
+    explicit ReceiveBuffer(std::size_t initialCapacity = 128 * 1024);
+
+    // Returns a writable region of at least minSize bytes at the end of the
+    // buffered data. Call commit() with the number of bytes actually written.
+    std::span<std::uint8_t> prepare(std::size_t minSize);
+    void commit(std::size_t len);
+
+    // Returns the next complete frame and consumes it, or an empty span if
+    // no complete frame is buffered yet.
+    std::span<const std::uint8_t> nextFrame();
+
+    std::size_t size() const {
+        return end_ - begin_;
+    }
+
+    std::size_t capacity() const {
+        return buf_.size();
+    }
+
+    void clear() {
+        begin_ = end_ = 0;
+    }
+
+private:
+    std::vector<std::uint8_t> buf_;
+    std::size_t begin_;
+    std::size_t end_;
+};
+
+}
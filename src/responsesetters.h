@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QDebug>
+#include <QPromise>
+
+#include <span>
+
+#include "connectionworker.h"
+
+namespace vicedebug {
+
+// Fulfills the promise of a request with a single response. The response is
+// decoded straight into the result and moved into the promise, so large
+// payloads like MEM_GET's are never copied.
+template<typename T>
+class ResponseSetterImpl : public ResponseSetter {
+public:
+    ResponseSetterImpl(QPromise<T>* promise)
+        : promise_(promise), complete_(false) {}
+
+    ~ResponseSetterImpl() {
+        // Cancels the future if the response never arrived.
+        delete promise_;
+    }
+
+    void set(const Response& header, std::span<const std::uint8_t> body) override {
+        T response{};
+        static_cast<Response&>(response) = header;
+        // Failed requests come without a body, there is nothing to decode.
+        if (header.errorCode == 0 && !decodeResponse(body, response)) {
+            qWarning() << "Truncated response of type " << header.responseType;
+        }
+        promise_->addResult(std::move(response));
+        promise_->finish();
+        delete promise_;
+        promise_ = nullptr;
+        complete_ = true;
+    }
+
+    bool responseIsComplete() override {
+        return complete_;
+    }
+
+private:
+    QPromise<T>* promise_;
+    bool complete_;
+};
+
+// VICE answers CHECKPOINT_LIST with one CHECKPOINT_INFO per checkpoint,
+// followed by the CHECKPOINT_LIST response itself.
+class CheckpointListResponseSetterImpl : public ResponseSetter {
+public:
+    CheckpointListResponseSetterImpl(QPromise<CheckpointListResponse>* promise)
+        : promise_(promise), complete_(false) {
+    }
+
+    ~CheckpointListResponseSetterImpl() {
+        // Cancels the future if the response never arrived.
+        delete promise_;
+    }
+
+    void set(const Response& header, std::span<const std::uint8_t> body) override {
+        switch(header.responseType) {
+        case RESPONSE_CHECKPOINT_INFO: {
+            CheckpointInfoResponse r{};
+            if (!decodeResponse(body, r)) {
+                qWarning() << "Truncated checkpoint info";
+                break;
+            }
+            checkpoints_.push_back(r.checkpoint);
+            break;
+        }
+        case RESPONSE_CHECKPOINT_LIST: {
+            CheckpointListResponse r{};
+            static_cast<Response&>(r) = header;
+            if (header.errorCode == 0) {
+                decodeResponse(body, r);
+            }
+            r.checkpoints = std::move(checkpoints_);
+            promise_->addResult(std::move(r));
+            promise_->finish();
+            delete promise_;
+            promise_ = nullptr;
+            complete_ = true;
+            break;
+        }
+        default:
+            qDebug() << "Unexpected response " << header.responseType;
+        }
+    }
+
+    bool responseIsComplete() override {
+        return complete_;
+    }
+
+private:
+    QPromise<CheckpointListResponse>* promise_;
+    std::vector<CheckpointInfo> checkpoints_;
+    bool complete_;
+};
+
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "stepcondition.h"
+
+#include <algorithm>
+
+#include "exprlexer.h"
+
+namespace vicedebug {
+
+// Recursive descent parser for
+//
+//     or      := and { "||" and }
+//     and     := primary { "&&" primary }
+//     primary := "(" or ")" | operand cmp operand
+//     operand := register | "[" number "]" | number
+class StepCondition::Parser : ExprLexer {
+public:
+    Parser(const std::string& text, StepCondition& condition)
+        : ExprLexer(text), condition_(condition) {}
+
+    bool parse(std::string& error) {
+        condition_.root_ = parseOr();
+        skipSpaces();
+        if (error_.empty() && pos_ < text_.size()) {
+            fail("Unexpected input");
+        }
+        error = error_;
+        return error_.empty();
+    }
+
+private:
+    int parseOr() {
+        int left = parseAnd();
+        while (error_.empty() && consume("||")) {
+            int right = parseAnd();
+            left = addNode(Node{Node::OR, left, right, {}, {}});
+        }
+        return left;
+    }
+
+    int parseAnd() {
+        int left = parsePrimary();
+        while (error_.empty() && consume("&&")) {
+            int right = parsePrimary();
+            left = addNode(Node{Node::AND, left, right, {}, {}});
+        }
+        return left;
+    }
+
+    int parsePrimary() {
+        if (consume("(")) {
+            int node = parseOr();
+            if (error_.empty() && !consume(")")) {
+                fail("')' expected");
+            }
+            return node;
+        }
+        Operand lhs = parseOperand();
+        Node::Kind kind;
+        if (consume("==")) {
+            kind = Node::EQ;
+        } else if (consume("!=")) {
+            kind = Node::NE;
+        } else if (consume("<=")) {
+            kind = Node::LE;
+        } else if (consume(">=")) {
+            kind = Node::GE;
+        } else if (consume("<")) {
+            kind = Node::LT;
+        } else if (consume(">")) {
+            kind = Node::GT;
+        } else {
+            fail("Comparison expected");
+            return -1;
+        }
+        Operand rhs = parseOperand();
+        return addNode(Node{kind, -1, -1, lhs, rhs});
+    }
+
+    Operand parseOperand() {
+        if (consume("[")) {
+            std::uint16_t addr = parseNumber("Address expected");
+            if (error_.empty() && !consume("]")) {
+                fail("']' expected");
+            }
+            auto& addresses = condition_.memoryAddresses_;
+            if (std::find(addresses.begin(), addresses.end(), addr) == addresses.end()) {
+                addresses.push_back(addr);
+            }
+            return Operand{Operand::MEMORY, addr};
+        }
+        skipSpaces();
+        Registers::ID id;
+        if (consumeRegister(id)) {
+            return Operand{Operand::REGISTER, (std::uint16_t)id};
+        }
+        return Operand{Operand::CONSTANT, parseNumber("Number or register expected")};
+    }
+
+    int addNode(const Node& node) {
+        condition_.nodes_.push_back(node);
+        return condition_.nodes_.size() - 1;
+    }
+
+    StepCondition& condition_;
+};
+
+std::optional<StepCondition> StepCondition::parse(const std::string& text, std::string& error) {
+    StepCondition condition;
+    condition.text_ = text;
+    Parser parser(text, condition);
+    if (!parser.parse(error)) {
+        return std::nullopt;
+    }
+    return condition;
+}
+
+bool StepCondition::evaluate(const Registers& regs, const std::unordered_map<std::uint16_t, std::uint8_t>& memory) const {
+    return evaluate(root_, regs, memory);
+}
+
+bool StepCondition::evaluate(int node, const Registers& regs, const std::unordered_map<std::uint16_t, std::uint8_t>& memory) const {
+    const Node& n = nodes_[node];
+    switch (n.kind) {
+    case Node::OR:
+        return evaluate(n.left, regs, memory) || evaluate(n.right, regs, memory);
+    case Node::AND:
+        return evaluate(n.left, regs, memory) && evaluate(n.right, regs, memory);
+    default:
+        break;
+    }
+
+    std::uint16_t lhs = valueOf(n.lhs, regs, memory);
+    std::uint16_t rhs = valueOf(n.rhs, regs, memory);
+    switch (n.kind) {
+    case Node::EQ: return lhs == rhs;
+    case Node::NE: return lhs != rhs;
+    case Node::LT: return lhs < rhs;
+    case Node::LE: return lhs <= rhs;
+    case Node::GT: return lhs > rhs;
+    case Node::GE: return lhs >= rhs;
+    default: return false;
+    }
+}
+
+std::uint16_t StepCondition::valueOf(const Operand& operand, const Registers& regs, const std::unordered_map<std::uint16_t, std::uint8_t>& memory) const {
+    switch (operand.kind) {
+    case Operand::REGISTER:
+        return regs[(Registers::ID)operand.value];
+    case Operand::MEMORY: {
+        auto it = memory.find(operand.value);
+        return it != memory.end() ? it->second : 0;
+    }
+    default:
+        return operand.value;
+    }
+}
+
+}
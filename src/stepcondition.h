@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "machinestate.h"
+
+namespace vicedebug {
+
+// A condition on registers and memory, as used by "step until". Examples:
+//
+//     PC == $c000
+//     A != 0 && [$d020] == $0e
+//     (X >= 10 || Y < $10) && [$fb] == 0
+//
+// Operands are register names (case insensitive; Z80 shadow registers are
+// written AF', BC', ...), memory bytes in brackets, and numbers in decimal,
+// hex ($ff or 0xff) or binary (%1010). The comparisons are ==, !=, <, <=, >
+// and >=; && binds tighter than ||.
+class StepCondition {
+public:
+    // Returns an empty optional and sets error if text can't be parsed.
+    static std::optional<StepCondition> parse(const std::string& text, std::string& error);
+
+    // Addresses of the memory bytes the condition reads, without duplicates.
+    const std::vector<std::uint16_t>& memoryAddresses() const {
+        return memoryAddresses_;
+    }
+
+    // memory must contain the bytes at memoryAddresses(); missing bytes read as 0.
+    bool evaluate(const Registers& regs, const std::unordered_map<std::uint16_t, std::uint8_t>& memory) const;
+
+    const std::string& text() const {
+        return text_;
+    }
+
+private:
+    struct Operand {
+        enum Kind {
+            CONSTANT,
+            REGISTER,
+            MEMORY,
+        };
+
+        Kind kind;
+        std::uint16_t value; // Constant value, Registers::ID, or address
+    };
+
+    struct Node {
+        enum Kind {
+            OR,
+            AND,
+            EQ,
+            NE,
+            LT,
+            LE,
+            GT,
+            GE,
+        };
+
+        Kind kind;
+        int left; // Index of the left child for OR and AND
+        int right; // Index of the right child for OR and AND
+        Operand lhs; // Operands of comparisons
+        Operand rhs;
+    };
+
+    class Parser;
+
+    StepCondition() = default;
+
+    bool evaluate(int node, const Registers& regs, const std::unordered_map<std::uint16_t, std::uint8_t>& memory) const;
+    std::uint16_t valueOf(const Operand& operand, const Registers& regs, const std::unordered_map<std::uint16_t, std::uint8_t>& memory) const;
+
+    std::string text_;
+    std::vector<Node> nodes_;
+    int root_;
+    std::vector<std::uint16_t> memoryAddresses_;
+};
+
+}
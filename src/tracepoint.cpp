@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "tracepoint.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+
+#include "exprlexer.h"
+#include "littleendian.h"
+
+namespace vicedebug {
+
+namespace {
+
+constexpr const char kBinaryMagic[] = "VDTRACE1";
+
+// The binary format stores the number of ranges in a byte.
+constexpr const std::size_t kMaxRanges = 255;
+
+class SpecParser : ExprLexer {
+public:
+    SpecParser(const std::string& text) : ExprLexer(text) {}
+
+    std::optional<TraceSpec> parse(std::string& error) {
+        TraceSpec spec;
+        skipSeparators();
+        while (pos_ < text_.size() && error_.empty()) {
+            if (text_[pos_] == '[') {
+                pos_++;
+                parseRange(spec);
+            } else {
+                parseRegister(spec);
+            }
+            skipSeparators();
+        }
+        if (!error_.empty()) {
+            error = error_;
+            return std::nullopt;
+        }
+        return spec;
+    }
+
+private:
+    void parseRange(TraceSpec& spec) {
+        std::uint16_t start = parseNumber("Address expected");
+        std::uint16_t end = start;
+        skipSpaces();
+        if (error_.empty() && pos_ < text_.size() && text_[pos_] == '-') {
+            pos_++;
+            end = parseNumber("Address expected");
+        }
+        skipSpaces();
+        if (error_.empty() && (pos_ >= text_.size() || text_[pos_] != ']')) {
+            fail("']' expected");
+            return;
+        }
+        pos_++;
+        if (error_.empty() && end < start) {
+            fail("Range ends before it starts");
+            return;
+        }
+        if (spec.memory.size() == kMaxRanges) {
+            fail("Too many memory ranges");
+            return;
+        }
+        spec.memory.push_back(TraceSpec::Range{start, end});
+    }
+
+    void parseRegister(TraceSpec& spec) {
+        Registers::ID id;
+        if (consumeRegister(id)) {
+            if (std::find(spec.registers.begin(), spec.registers.end(), id) == spec.registers.end()) {
+                spec.registers.push_back(id);
+            }
+            return;
+        }
+        fail("Register or '[' expected");
+    }
+
+    void skipSeparators() {
+        while (pos_ < text_.size() && (std::isspace((unsigned char)text_[pos_]) || text_[pos_] == ',')) {
+            pos_++;
+        }
+    }
+};
+
+void writeHex(std::ostream& os, unsigned value, int digits) {
+    char buf[8];
+    std::snprintf(buf, sizeof(buf), "%0*x", digits, value);
+    os << buf;
+}
+
+template<typename T>
+void writeColumn(std::ostream& os, const std::vector<T>& column) {
+    for (T value : column) {
+        writeLittleEndian(os, value);
+    }
+}
+
+}
+
+const char* registerName(Registers::ID id) {
+    for (const auto& reg : kRegisterNames) {
+        if (reg.id == id) {
+            return reg.name;
+        }
+    }
+    return "?";
+}
+
+std::optional<TraceSpec> TraceSpec::parse(const std::string& text, std::string& error) {
+    return SpecParser(text).parse(error);
+}
+
+std::string TraceSpec::toString() const {
+    std::string s;
+    for (Registers::ID id : registers) {
+        if (!s.empty()) {
+            s += " ";
+        }
+        s += registerName(id);
+    }
+    char buf[16];
+    for (const Range& r : memory) {
+        if (r.start == r.end) {
+            std::snprintf(buf, sizeof(buf), "[$%04x]", r.start);
+        } else {
+            std::snprintf(buf, sizeof(buf), "[$%04x-$%04x]", r.start, r.end);
+        }
+        if (!s.empty()) {
+            s += " ";
+        }
+        s += buf;
+    }
+    return s;
+}
+
+int TraceSpec::memorySize() const {
+    int size = 0;
+    for (const Range& r : memory) {
+        size += r.size();
+    }
+    return size;
+}
+
+TraceLog::TraceLog(const TraceSpec& spec)
+    : spec_(spec), memoryStride_(spec.memorySize()), registers_(spec.registers.size())
+{
+}
+
+void TraceLog::append(std::int64_t timestampNs, std::uint16_t pc, const Registers& regs, std::span<const std::uint8_t> memory) {
+    timestampsNs_.push_back(timestampNs);
+    pcs_.push_back(pc);
+    for (std::size_t i = 0; i < registers_.size(); i++) {
+        registers_[i].push_back(regs[spec_.registers[i]]);
+    }
+    memory = memory.first(std::min<std::size_t>(memory.size(), memoryStride_));
+    memory_.insert(memory_.end(), memory.begin(), memory.end());
+    // Missing bytes read as 0, so that the rows stay aligned.
+    memory_.resize(timestampsNs_.size() * memoryStride_);
+}
+
+void TraceLog::clear() {
+    timestampsNs_.clear();
+    pcs_.clear();
+    for (auto& column : registers_) {
+        column.clear();
+    }
+    memory_.clear();
+}
+
+double TraceLog::hitsPerSecond(std::int64_t nowNs, std::int64_t windowNs) const {
+    if (windowNs <= 0) {
+        return 0;
+    }
+    // Timestamps are ascending.
+    auto first = std::upper_bound(timestampsNs_.begin(), timestampsNs_.end(), nowNs - windowNs);
+    return (timestampsNs_.end() - first) * 1e9 / windowNs;
+}
+
+void TraceLog::writeCsv(std::ostream& os) const {
+    os << "time_us,pc";
+    for (Registers::ID id : spec_.registers) {
+        os << "," << registerName(id);
+    }
+    for (const auto& r : spec_.memory) {
+        for (int addr = r.start; addr <= r.end; addr++) {
+            os << ",";
+            writeHex(os, addr, 4);
+        }
+    }
+    os << "\n";
+
+    std::int64_t origin = timestampsNs_.empty() ? 0 : timestampsNs_.front();
+    for (std::size_t hit = 0; hit < size(); hit++) {
+        os << (timestampsNs_[hit] - origin) / 1000 << ",";
+        writeHex(os, pcs_[hit], 4);
+        for (const auto& column : registers_) {
+            os << ",";
+            writeHex(os, column[hit], 2);
+        }
+        for (std::uint8_t b : memory(hit)) {
+            os << ",";
+            writeHex(os, b, 2);
+        }
+        os << "\n";
+    }
+}
+
+void TraceLog::writeBinary(std::ostream& os) const {
+    os.write(kBinaryMagic, sizeof(kBinaryMagic) - 1);
+    writeLittleEndian<std::uint8_t>(os, spec_.registers.size());
+    for (Registers::ID id : spec_.registers) {
+        writeLittleEndian<std::uint8_t>(os, id);
+    }
+    writeLittleEndian<std::uint8_t>(os, spec_.memory.size());
+    for (const auto& r : spec_.memory) {
+        writeLittleEndian(os, r.start);
+        writeLittleEndian(os, r.end);
+    }
+    writeLittleEndian<std::uint32_t>(os, size());
+    writeColumn(os, timestampsNs_);
+    writeColumn(os, pcs_);
+    for (const auto& column : registers_) {
+        writeColumn(os, column);
+    }
+    os.write((const char*)memory_.data(), memory_.size());
+}
+
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "machinestate.h"
+
+namespace vicedebug {
+
+// What a tracepoint records on every hit, written like
+//
+//     A X Y PC [$d020] [$fb-$fe]
+//
+// Register names are case insensitive, memory is given as a single byte or
+// an inclusive range in brackets. Items are separated by spaces or commas.
+struct TraceSpec {
+    struct Range {
+        std::uint16_t start;
+        std::uint16_t end;
+
+        int size() const {
+            return end - start + 1;
+        }
+    };
+
+    std::vector<Registers::ID> registers;
+    std::vector<Range> memory;
+
+    // Returns an empty optional and sets error if text can't be parsed.
+    static std::optional<TraceSpec> parse(const std::string& text, std::string& error);
+
+    std::string toString() const;
+
+    // Number of memory bytes recorded per hit.
+    int memorySize() const;
+};
+
+const char* registerName(Registers::ID id);
+
+// The hits of a tracepoint, stored column by column: one column for the
+// timestamps, one for PC, one per traced register, and the traced memory
+// bytes of all hits back to back. Appending a hit doesn't allocate once the
+// columns have grown, and exports only touch the columns they write.
+class TraceLog {
+public:
+    explicit TraceLog(const TraceSpec& spec);
+
+    const TraceSpec& spec() const {
+        return spec_;
+    }
+
+    std::size_t size() const {
+        return timestampsNs_.size();
+    }
+
+    // memory holds the bytes of spec().memory back to back, and must be
+    // spec().memorySize() bytes long.
+    void append(std::int64_t timestampNs, std::uint16_t pc, const Registers& regs, std::span<const std::uint8_t> memory);
+    void clear();
+
+    std::int64_t timestampNs(std::size_t hit) const {
+        return timestampsNs_[hit];
+    }
+
+    std::uint16_t pc(std::size_t hit) const {
+        return pcs_[hit];
+    }
+
+    // Value of the i-th register of spec().registers.
+    std::uint16_t reg(std::size_t i, std::size_t hit) const {
+        return registers_[i][hit];
+    }
+
+    std::span<const std::uint8_t> memory(std::size_t hit) const {
+        return std::span<const std::uint8_t>(memory_).subspan(hit * memoryStride_, memoryStride_);
+    }
+
+    // Hits in the windowNs before nowNs, per second.
+    double hitsPerSecond(std::int64_t nowNs, std::int64_t windowNs = 1000000000) const;
+
+    // One line per hit: time in microseconds since the first hit, PC, the
+    // registers, and one column per memory byte. Values are hex.
+    void writeCsv(std::ostream& os) const;
+
+    // The columns as they are in memory, little endian:
+    //
+    //     "VDTRACE1", u8 nofRegisters, u8 register IDs..., u8 nofRanges,
+    //     (u16 start, u16 end)..., u32 nofHits, i64 timestamps (ns)...,
+    //     u16 PCs..., u16 values... per register, memory bytes
+    void writeBinary(std::ostream& os) const;
+
+private:
+    TraceSpec spec_;
+    int memoryStride_;
+    std::vector<std::int64_t> timestampsNs_;
+    std::vector<std::uint16_t> pcs_;
+    std::vector<std::vector<std::uint16_t>> registers_;
+    std::vector<std::uint8_t> memory_;
+};
+
+}
@@ -0,0 +1,278 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tracing.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <utility>
+
+namespace vicedebug {
+
+namespace {
+
+std::size_t roundUpToPowerOfTwo(std::size_t v) {
+    std::size_t res = 1;
+    while (res < v) {
+        res <<= 1;
+    }
+    return res;
+}
+
+std::uint32_t currentThreadIndex() {
+    static std::atomic<std::uint32_t> nextIndex = 1;
+    thread_local std::uint32_t index = nextIndex.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+bool isPaint(const char* name) {
+    return std::strncmp(name, kTracePaintPrefix, sizeof(kTracePaintPrefix) - 1) == 0;
+}
+
+void writeJsonString(std::ostream& os, const char* s) {
+    os << '"';
+    for (; *s; s++) {
+        char c = *s;
+        if (c == '"' || c == '\\') {
+            os << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            os << ' ';
+        } else {
+            os << c;
+        }
+    }
+    os << '"';
+}
+
+void writeMicros(std::ostream& os, std::int64_t ns) {
+    // Chrome wants microseconds; keep the nanoseconds as fraction.
+    os << ns / 1000 << '.';
+    std::int64_t frac = ns % 1000;
+    os << char('0' + frac / 100) << char('0' + frac / 10 % 10) << char('0' + frac % 10);
+}
+
+}
+
+Tracer::Tracer(std::size_t capacity)
+    : slots_(new Slot[roundUpToPowerOfTwo(std::max(capacity, std::size_t(2)))]),
+      mask_(roundUpToPowerOfTwo(std::max(capacity, std::size_t(2))) - 1),
+      head_(0), tail_(0), enabled_(false), step_(0)
+{
+    for (std::size_t i = 0; i <= mask_; i++) {
+        slots_[i].seq.store(0, std::memory_order_relaxed);
+    }
+}
+
+Tracer& Tracer::instance() {
+    static Tracer tracer;
+    return tracer;
+}
+
+std::int64_t Tracer::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void Tracer::instant(const char* name) {
+    if (!isEnabled()) {
+        return;
+    }
+    record(name, TraceEvent::Kind::INSTANT, now(), 0);
+}
+
+void Tracer::complete(const char* name, std::int64_t startNs, std::int64_t endNs) {
+    if (!isEnabled()) {
+        return;
+    }
+    record(name, TraceEvent::Kind::COMPLETE, startNs, endNs - startNs);
+}
+
+void Tracer::record(const char* name, TraceEvent::Kind kind, std::int64_t startNs, std::int64_t durationNs) {
+    std::uint64_t idx = head_.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = slots_[idx & mask_];
+
+    // Seqlock style: invalidate, write, publish.
+    slot.seq.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.kind.store(static_cast<std::uint8_t>(kind), std::memory_order_relaxed);
+    slot.stepId.store(currentStep(), std::memory_order_relaxed);
+    slot.threadId.store(currentThreadIndex(), std::memory_order_relaxed);
+    slot.startNs.store(startNs, std::memory_order_relaxed);
+    slot.durationNs.store(durationNs, std::memory_order_relaxed);
+    slot.seq.store(idx + 1, std::memory_order_release);
+}
+
+std::vector<TraceEvent> Tracer::snapshot() const {
+    std::uint64_t head = head_.load(std::memory_order_acquire);
+    std::uint64_t first = std::max(tail_.load(std::memory_order_relaxed), head > capacity() ? head - capacity() : 0);
+
+    std::vector<TraceEvent> res;
+    res.reserve(head - first);
+    for (std::uint64_t idx = first; idx < head; idx++) {
+        const Slot& slot = slots_[idx & mask_];
+        std::uint64_t seq = slot.seq.load(std::memory_order_acquire);
+        if (seq != idx + 1) {
+            // Still being written, or overwritten already.
+            continue;
+        }
+        TraceEvent e;
+        e.name = slot.name.load(std::memory_order_relaxed);
+        e.kind = static_cast<TraceEvent::Kind>(slot.kind.load(std::memory_order_relaxed));
+        e.stepId = slot.stepId.load(std::memory_order_relaxed);
+        e.threadId = slot.threadId.load(std::memory_order_relaxed);
+        e.startNs = slot.startNs.load(std::memory_order_relaxed);
+        e.durationNs = slot.durationNs.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) != seq) {
+            continue;
+        }
+        res.push_back(e);
+    }
+    return res;
+}
+
+void Tracer::clear() {
+    tail_.store(head_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+std::uint64_t Tracer::recorded() const {
+    return head_.load(std::memory_order_relaxed) - tail_.load(std::memory_order_relaxed);
+}
+
+std::int64_t PhaseStats::minNs() const {
+    return samplesNs.empty() ? 0 : samplesNs.front();
+}
+
+std::int64_t PhaseStats::maxNs() const {
+    return samplesNs.empty() ? 0 : samplesNs.back();
+}
+
+std::int64_t PhaseStats::meanNs() const {
+    if (samplesNs.empty()) {
+        return 0;
+    }
+    std::int64_t sum = 0;
+    for (auto s : samplesNs) {
+        sum += s;
+    }
+    return sum / (std::int64_t)samplesNs.size();
+}
+
+std::int64_t PhaseStats::percentileNs(int percent) const {
+    if (samplesNs.empty()) {
+        return 0;
+    }
+    // Nearest rank
+    std::size_t rank = (percent * samplesNs.size() + 99) / 100;
+    return samplesNs[std::clamp(rank, std::size_t(1), samplesNs.size()) - 1];
+}
+
+std::size_t PhaseStats::bucketOf(std::int64_t durationNs) {
+    std::int64_t us = durationNs / 1000;
+    std::size_t bucket = 0;
+    while (us > 1 && bucket < kHistogramBuckets - 1) {
+        us >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+std::vector<PhaseStats> computePhaseStats(const std::vector<TraceEvent>& events) {
+    std::map<std::string, std::vector<std::int64_t>> samples;
+
+    // step ID -> time STOPPED was received
+    std::map<std::uint32_t, std::int64_t> stoppedAt;
+    for (const auto& e : events) {
+        if (e.kind == TraceEvent::Kind::COMPLETE) {
+            samples[e.name].push_back(e.durationNs);
+        } else if (std::strcmp(e.name, kTraceStoppedReceived) == 0 && !stoppedAt.contains(e.stepId)) {
+            stoppedAt[e.stepId] = e.startNs;
+        }
+    }
+
+    // For every step, the end of the first paint of every widget after the stop.
+    std::map<std::uint32_t, std::map<std::string, std::int64_t>> firstPaintEnd;
+    for (const auto& e : events) {
+        if (e.kind != TraceEvent::Kind::COMPLETE || !isPaint(e.name)) {
+            continue;
+        }
+        auto it = stoppedAt.find(e.stepId);
+        if (it == stoppedAt.end() || e.startNs < it->second) {
+            continue;
+        }
+        auto& ends = firstPaintEnd[e.stepId];
+        auto endIt = ends.find(e.name);
+        if (endIt == ends.end() || e.endNs() < endIt->second) {
+            ends[e.name] = e.endNs();
+        }
+    }
+    for (const auto& p : firstPaintEnd) {
+        std::int64_t lastEnd = 0;
+        for (const auto& q : p.second) {
+            lastEnd = std::max(lastEnd, q.second);
+        }
+        samples[kTraceStopToPaint].push_back(lastEnd - stoppedAt[p.first]);
+    }
+
+    std::vector<PhaseStats> res;
+    for (auto& p : samples) {
+        PhaseStats stats;
+        stats.name = p.first;
+        stats.samplesNs = std::move(p.second);
+        std::sort(stats.samplesNs.begin(), stats.samplesNs.end());
+        stats.histogram.fill(0);
+        for (auto s : stats.samplesNs) {
+            stats.histogram[PhaseStats::bucketOf(s)]++;
+        }
+        res.push_back(std::move(stats));
+    }
+    return res;
+}
+
+void writeChromeTrace(std::ostream& os, const std::vector<TraceEvent>& events) {
+    std::int64_t origin = events.empty() ? 0 : events.front().startNs;
+    for (const auto& e : events) {
+        origin = std::min(origin, e.startNs);
+    }
+
+    os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (const auto& e : events) {
+        if (!first) {
+            os << ",";
+        }
+        first = false;
+        os << "\n{\"name\":";
+        writeJsonString(os, e.name);
+        os << ",\"cat\":\"vicedebug\",\"pid\":1,\"tid\":" << e.threadId << ",\"ts\":";
+        writeMicros(os, e.startNs - origin);
+        if (e.kind == TraceEvent::Kind::COMPLETE) {
+            os << ",\"ph\":\"X\",\"dur\":";
+            writeMicros(os, e.durationNs);
+        } else {
+            os << ",\"ph\":\"i\",\"s\":\"g\"";
+        }
+        os << ",\"args\":{\"step\":" << e.stepId << "}}";
+    }
+    os << "\n]}\n";
+}
+
+}
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace vicedebug {
+
+// Names of the trace points on the stop-to-paint path. Widgets add their own
+// "slot ..." and "paint ..." scopes.
+constexpr const char kTraceStepRequested[] = "step requested";
+constexpr const char kTraceStoppedReceived[] = "STOPPED received";
+constexpr const char kTraceStoppedDispatched[] = "STOPPED dispatched";
+constexpr const char kTraceMachineState[] = "getMachineState";
+constexpr const char kTraceRegistersWait[] = "registers wait";
+constexpr const char kTraceMemoryWait[] = "memory wait";
+constexpr const char kTracePausedFanOut[] = "executionPaused fan-out";
+constexpr const char kTraceStopToPaint[] = "stop-to-paint";
+
+// Prefix of all paint scopes; used to derive the stop-to-paint latency.
+constexpr const char kTracePaintPrefix[] = "paint ";
+
+struct TraceEvent {
+    enum class Kind : std::uint8_t {
+        INSTANT,
+        COMPLETE,
+    };
+
+    const char* name; // Always a string literal
+    Kind kind;
+    std::uint32_t stepId;
+    std::uint32_t threadId;
+    std::int64_t startNs;
+    std::int64_t durationNs;
+
+    std::int64_t endNs() const {
+        return startNs + durationNs;
+    }
+};
+
+// Records trace events into a fixed size ring buffer.
+//
+// Recording is lock-free and safe from any thread: a writer claims a slot
+// with a single fetch_add and publishes it with a sequence number, so a
+// concurrent snapshot() simply skips slots that are being overwritten. Once
+// the buffer is full, the oldest events are overwritten.
+//
+// Events are correlated by step ID: every user action that lets the machine
+// run starts a new step, and all events recorded until the next one carry its
+// ID, no matter on which thread they are recorded.
+//
+// Recording is off until setEnabled(true); the latency panel's "Record"
+// checkbox turns it on.
+class Tracer {
+public:
+    static constexpr const std::size_t kDefaultCapacity = 16384;
+
+    explicit Tracer(std::size_t capacity = kDefaultCapacity);
+
+    static Tracer& instance();
+
+    // Monotonic time in nanoseconds.
+    static std::int64_t now();
+
+    void setEnabled(bool enabled) {
+        enabled_.store(enabled, std::memory_order_relaxed);
+    }
+
+    bool isEnabled() const {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    std::uint32_t beginStep() {
+        return step_.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    std::uint32_t currentStep() const {
+        return step_.load(std::memory_order_relaxed);
+    }
+
+    void instant(const char* name);
+    void complete(const char* name, std::int64_t startNs, std::int64_t endNs);
+
+    // All events still in the buffer, oldest first.
+    std::vector<TraceEvent> snapshot() const;
+    void clear();
+
+    std::size_t capacity() const {
+        return mask_ + 1;
+    }
+
+    // Number of events recorded since the last clear(), including the ones
+    // that were overwritten already.
+    std::uint64_t recorded() const;
+
+private:
+    struct Slot {
+        // 0 while the slot is written, otherwise the index of the event + 1.
+        std::atomic<std::uint64_t> seq;
+        std::atomic<const char*> name;
+        std::atomic<std::uint8_t> kind;
+        std::atomic<std::uint32_t> stepId;
+        std::atomic<std::uint32_t> threadId;
+        std::atomic<std::int64_t> startNs;
+        std::atomic<std::int64_t> durationNs;
+    };
+
+    void record(const char* name, TraceEvent::Kind kind, std::int64_t startNs, std::int64_t durationNs);
+
+    std::unique_ptr<Slot[]> slots_;
+    std::size_t mask_;
+    std::atomic<std::uint64_t> head_;
+    std::atomic<std::uint64_t> tail_; // First index that is not cleared
+    std::atomic<bool> enabled_;
+    std::atomic<std::uint32_t> step_;
+};
+
+// Records the lifetime of the scope as a COMPLETE event.
+class TraceScope {
+public:
+    explicit TraceScope(const char* name, Tracer& tracer = Tracer::instance())
+        : tracer_(tracer), name_(name), startNs_(tracer.isEnabled() ? Tracer::now() : 0) {}
+
+    ~TraceScope() {
+        if (startNs_ != 0) {
+            tracer_.complete(name_, startNs_, Tracer::now());
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    Tracer& tracer_;
+    const char* name_;
+    std::int64_t startNs_;
+};
+
+struct PhaseStats {
+    // Bucket i counts durations in [2^i, 2^(i+1)) microseconds; bucket 0
+    // also holds everything below 1 us, the last one everything above.
+    static constexpr const std::size_t kHistogramBuckets = 21;
+
+    std::string name;
+    std::vector<std::int64_t> samplesNs; // Sorted
+    std::array<std::uint32_t, kHistogramBuckets> histogram;
+
+    std::int64_t minNs() const;
+    std::int64_t maxNs() const;
+    std::int64_t meanNs() const;
+    std::int64_t percentileNs(int percent) const;
+
+    static std::size_t bucketOf(std::int64_t durationNs);
+};
+
+// Durations of all COMPLETE events, grouped by name, plus the derived
+// kTraceStopToPaint phase: for every step, the time from kTraceStoppedReceived
+// until every widget finished its first paint after it.
+std::vector<PhaseStats> computePhaseStats(const std::vector<TraceEvent>& events);
+
+// Writes the events in the Chrome trace event format, loadable in
+// chrome://tracing or https://ui.perfetto.dev.
+void writeChromeTrace(std::ostream& os, const std::vector<TraceEvent>& events);
+
+}
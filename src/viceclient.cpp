@@ -25,82 +25,12 @@
 #include <iostream>
 
 #include "connectionworker.h"
-#include "vectorutils.h"
+#include "responsesetters.h"
 
 namespace vicedebug {
 
-template<typename T>
-class ResponseSetterImpl : public ResponseSetter {
-public:
-    ResponseSetterImpl(ConnectionWorker* connectionWorker, QPromise<T>* promise)
-        : promise_(promise), connectionWorker_(connectionWorker), complete_(false) {}
-
-    void set(std::shared_ptr<Response> response) override {
-        qDebug() << QThread::currentThreadId() << "Adding Result to response";
-        promise_->addResult(*((T*)response.get()));
-        promise_->finish();
-        qDebug() << QThread::currentThreadId() << "Promise finished";
-        delete promise_;
-        promise_ = nullptr;
-        connectionWorker_->reportOobResponses(true);
-        complete_ = true;
-    }
-
-    bool responseIsComplete() override {
-        return complete_;
-    }
-
-private:
-    QPromise<T>* promise_;
-    ConnectionWorker* connectionWorker_;
-    bool complete_;
-};
-
-class CheckpointListResponseSetterImpl : public ResponseSetter {
-public:
-    CheckpointListResponseSetterImpl(ConnectionWorker* connectionWorker, QPromise<CheckpointListResponse>* promise)
-        : promise_(promise), connectionWorker_(connectionWorker), complete_(false) {
-    }
-
-    void set(std::shared_ptr<Response> response) override {
-        switch(response->responseType) {
-        case RESPONSE_CHECKPOINT_INFO: {
-            qDebug() << QThread::currentThreadId() << "Adding checkpoint info to response";
-            auto r = std::reinterpret_pointer_cast<CheckpointInfoResponse>(response);
-            checkpoints_.push_back(r->checkpoint);
-            break;
-        }
-        case RESPONSE_CHECKPOINT_LIST: {
-            qDebug() << QThread::currentThreadId() << "Finishing checkpoint list response";
-            auto r = std::reinterpret_pointer_cast<CheckpointListResponse>(response);
-            r->checkpoints = checkpoints_;
-            promise_->addResult(*r);
-            promise_->finish();
-            qDebug() << QThread::currentThreadId() << "Promise finished";
-            delete promise_;
-            promise_ = nullptr;
-            connectionWorker_->reportOobResponses(true);
-            complete_ = true;
-            break;
-        }
-        default:
-            qDebug() << "Unexpected response " << response->responseType;
-        }
-    }
-
-    bool responseIsComplete() override {
-        return complete_;
-    }
-
-private:
-    QPromise<CheckpointListResponse>* promise_;
-    std::vector<CheckpointInfo> checkpoints_;
-    ConnectionWorker* connectionWorker_;
-    bool complete_;
-};
-
 ViceClient::ViceClient(QObject* parent)
-    : QObject(parent)
+    : QObject(parent), readGeneration_(ConnectionWorker::kNoGeneration + 1)
 {   
     connectionWorker_ = new ConnectionWorker(nullptr);
     connectionWorker_->moveToThread(&connectionWorkerThread_);
@@ -109,7 +39,7 @@ ViceClient::ViceClient(QObject* parent)
 
     connect(this, &ViceClient::connectionRequested, connectionWorker_, &ConnectionWorker::connectToHost);
     connect(this, &ViceClient::disconnectRequested, connectionWorker_, &ConnectionWorker::disconnect);
-    connect(this, &ViceClient::sendCommand, connectionWorker_, &ConnectionWorker::sendCommand);
+    connect(this, &ViceClient::maxRequestsInFlightChanged, connectionWorker_, &ConnectionWorker::setMaxInFlight);
 
     connect(connectionWorker_, &ConnectionWorker::oobResponseReceived, this, &ViceClient::onOobResponseReceived);
 
@@ -121,49 +51,54 @@ ViceClient::~ViceClient() {
     connectionWorkerThread_.wait();
 }
 
-bool ViceClient::connectToVice(const QString& host, int port, int timeoutMs) {
-    QPromise<bool> resultPromise;
-    QFuture<bool> res = resultPromise.future();
-    emit connectionRequested(host, port, timeoutMs, &resultPromise);
-    res.waitForFinished();
-    return res.result();
+QFuture<bool> ViceClient::connectToVice(const QString& host, int port, int timeoutMs) {
+    // The worker fulfills and deletes the promise.
+    auto promise = new QPromise<bool>();
+    auto res = promise->future();
+    emit connectionRequested(host, port, timeoutMs, promise);
+    return res;
 }
 
 void ViceClient::disconnect() {
     emit disconnectRequested();
 }
 
-QFuture<MemGetResponse> ViceClient::memGet(uint16_t startAddress, uint16_t endAddress, MemSpace memSpace , uint16_t bankID, bool sideEffects ) {
+void ViceClient::setMaxRequestsInFlight(int maxInFlight) {
+    emit maxRequestsInFlightChanged(maxInFlight);
+}
+
+void ViceClient::supersedeReads() {
+    std::uint32_t generation = ++readGeneration_;
+    if (readGeneration_ == ConnectionWorker::kNoGeneration) {
+        // Wrapped around, which takes a few years of stepping.
+        generation = ++readGeneration_;
+    }
+    ConnectionWorker* worker = connectionWorker_;
+    QMetaObject::invokeMethod(connectionWorker_, [worker, generation]() {
+        worker->dropSupersededCommands(generation);
+    }, Qt::QueuedConnection);
+}
+
+QFuture<MemGetResponse> ViceClient::memGet(uint16_t startAddress, uint16_t endAddress, MemSpace memSpace , uint16_t bankID, bool sideEffects, RequestPriority priority) {
     auto promise = new QPromise<MemGetResponse>();
     auto res = promise->future();
-    ResponseSetter* responseSetter = new ResponseSetterImpl<MemGetResponse>(connectionWorker_, promise);
+    ResponseSetter* responseSetter = new ResponseSetterImpl<MemGetResponse>(promise);
 
-    std::vector<std::uint8_t> body;
-    body << (std::uint8_t)(sideEffects ? 0x01 : 0x00)
-         << startAddress
-         << endAddress
-         << (std::uint8_t)memSpace
-         << bankID;
-    emit sendCommand(CMD_MEM_GET, body, responseSetter);
+    if (sideEffects) {
+        send(MemGetCommand{sideEffects, startAddress, endAddress, (std::uint8_t)memSpace, bankID}, responseSetter);
+    } else {
+        sendRead(MemGetCommand{sideEffects, startAddress, endAddress, (std::uint8_t)memSpace, bankID}, responseSetter, priority);
+    }
 
     return res;
 }
 
-QFuture<MemSetResponse> ViceClient::memSet(uint16_t startAddress, MemSpace memSpace , uint16_t bankID, bool sideEffects, std::vector<std::uint8_t> data ) {
+QFuture<MemSetResponse> ViceClient::memSet(uint16_t startAddress, MemSpace memSpace , uint16_t bankID, bool sideEffects, const std::vector<std::uint8_t>& data) {
     auto promise = new QPromise<MemSetResponse>();
     auto res = promise->future();
-    ResponseSetter* responseSetter = new ResponseSetterImpl<MemSetResponse>(connectionWorker_, promise);
-
-    std::vector<std::uint8_t> body;
-    body.reserve(8 + data.size()); // 8 bytes header + data
-    body << (std::uint8_t)(sideEffects ? 0x01 : 0x00)
-         << startAddress
-         << (std::uint16_t)(startAddress + data.size() - 1)
-         << (std::uint8_t)memSpace
-         << bankID;
-    body.insert(body.end(), data.begin(), data.end());
+    ResponseSetter* responseSetter = new ResponseSetterImpl<MemSetResponse>(promise);
 
-    emit sendCommand(CMD_MEM_SET, body, responseSetter);
+    send(MemSetCommand{sideEffects, startAddress, (std::uint16_t)(startAddress + data.size() - 1), (std::uint8_t)memSpace, bankID, data}, responseSetter);
 
     return res;
 }
@@ -171,11 +106,9 @@ QFuture<MemSetResponse> ViceClient::memSet(uint16_t startAddress, MemSpace memSp
 QFuture<RegistersResponse> ViceClient::registersGet(MemSpace memSpace) {
     auto promise = new QPromise<RegistersResponse>();
     auto res = promise->future();
-    ResponseSetter* responseSetter = new ResponseSetterImpl<RegistersResponse>(connectionWorker_, promise);
+    ResponseSetter* responseSetter = new ResponseSetterImpl<RegistersResponse>(promise);
 
-    std::vector<std::uint8_t> body;
-    body << (std::uint8_t)memSpace;
-    emit sendCommand(CMD_REGISTERS_GET, body, responseSetter);
+    sendRead(RegistersGetCommand{(std::uint8_t)memSpace}, responseSetter);
 
     return res;
 }
@@ -183,33 +116,23 @@ QFuture<RegistersResponse> ViceClient::registersGet(MemSpace memSpace) {
 QFuture<RegistersResponse> ViceClient::registersSet(MemSpace memSpace, std::map<std::uint8_t, std::uint16_t> values) {
     auto promise = new QPromise<RegistersResponse>();
     auto res = promise->future();
-    ResponseSetter* responseSetter = new ResponseSetterImpl<RegistersResponse>(connectionWorker_, promise);
+    ResponseSetter* responseSetter = new ResponseSetterImpl<RegistersResponse>(promise);
 
     qDebug() << "Sending REGISTERS_SET:";
     for(const auto& p : values) {
         qDebug() << "  reg " << p.first << " = " << p.second;
     }
 
-    std::vector<std::uint8_t> body;
-    body << (std::uint8_t)memSpace
-         << (std::uint16_t)values.size();
-    for (auto p : values) {
-        body << (std::uint8_t)3 // Size of the item, excluding this byte
-             << (std::uint8_t)p.first // Register ID
-             << (std::uint16_t)p.second; // Register Value
-    }
-    emit sendCommand(CMD_REGISTERS_SET, body, responseSetter);
+    send(RegistersSetCommand{(std::uint8_t)memSpace, std::move(values)}, responseSetter);
     return res;
 }
 
 QFuture<RegistersAvailableResponse> ViceClient::registersAvailable(MemSpace memSpace) {
     auto promise = new QPromise<RegistersAvailableResponse>();
     auto res = promise->future();
-    ResponseSetter* responseSetter = new ResponseSetterImpl<RegistersAvailableResponse>(connectionWorker_, promise);
+    ResponseSetter* responseSetter = new ResponseSetterImpl<RegistersAvailableResponse>(promise);
 
-    std::vector<std::uint8_t> body;
-    body << (std::uint8_t)memSpace;
-    emit sendCommand(CMD_REGISTERS_AVAILABLE, body, responseSetter);
+    send(RegistersAvailableCommand{(std::uint8_t)memSpace}, responseSetter);
 
     return res;
 }
@@ -217,10 +140,11 @@ QFuture<RegistersAvailableResponse> ViceClient::registersAvailable(MemSpace memS
 QFuture<CheckpointListResponse> ViceClient::checkpointList() {
     auto promise = new QPromise<CheckpointListResponse>();
     auto res = promise->future();
-    ResponseSetter* responseSetter = new CheckpointListResponseSetterImpl(connectionWorker_, promise);
+    ResponseSetter* responseSetter = new CheckpointListResponseSetterImpl(promise);
 
-    std::vector<std::uint8_t> body;
-    emit sendCommand(CMD_CHECKPOINT_LIST, body, responseSetter);
+    // Like any command, this stops a running VICE, so it must not be overtaken
+    // by the interactive commands queued after it.
+    send(CheckpointListCommand{}, responseSetter);
 
     return res;
 }
@@ -228,11 +152,9 @@ QFuture<CheckpointListResponse> ViceClient::checkpointList() {
 QFuture<CheckpointDeleteResponse> ViceClient::checkpointDelete(std::uint32_t number) {
     auto promise = new QPromise<CheckpointDeleteResponse>();
     auto res = promise->future();
-    ResponseSetter* responseSetter = new ResponseSetterImpl<CheckpointDeleteResponse>(connectionWorker_, promise);
+    ResponseSetter* responseSetter = new ResponseSetterImpl<CheckpointDeleteResponse>(promise);
 
-    std::vector<std::uint8_t> body;
-    body << number;
-    emit sendCommand(CMD_CHECKPOINT_DELETE, body, responseSetter);
+    send(CheckpointDeleteCommand{number}, responseSetter);
 
     return res;
 }
@@ -240,12 +162,9 @@ QFuture<CheckpointDeleteResponse> ViceClient::checkpointDelete(std::uint32_t num
 QFuture<CheckpointToggleResponse> ViceClient::checkpointToggle(std::uint32_t number, bool enabled) {
     auto promise = new QPromise<CheckpointToggleResponse>();
     auto res = promise->future();
-    ResponseSetter* responseSetter = new ResponseSetterImpl<CheckpointToggleResponse>(connectionWorker_, promise);
+    ResponseSetter* responseSetter = new ResponseSetterImpl<CheckpointToggleResponse>(promise);
 
-    std::vector<std::uint8_t> body;
-    body << number
-         << (std::uint8_t)enabled;
-    emit sendCommand(CMD_CHECKPOINT_TOGGLE, body, responseSetter);
+    send(CheckpointToggleCommand{number, enabled}, responseSetter);
 
     return res;
 }
@@ -253,11 +172,9 @@ QFuture<CheckpointToggleResponse> ViceClient::checkpointToggle(std::uint32_t num
 QFuture<CheckpointInfoResponse> ViceClient::checkpointGet(std::uint32_t number) {
     auto promise = new QPromise<CheckpointInfoResponse>();
     auto res = promise->future();
-    ResponseSetter* responseSetter = new ResponseSetterImpl<CheckpointInfoResponse>(connectionWorker_, promise);
+    ResponseSetter* responseSetter = new ResponseSetterImpl<CheckpointInfoResponse>(promise);
 
-    std::vector<std::uint8_t> body;
-    body << number;
-    emit sendCommand(CMD_CHECKPOINT_GET, body, responseSetter);
+    send(CheckpointGetCommand{number}, responseSetter);
 
     return res;
 }
@@ -265,17 +182,19 @@ QFuture<CheckpointInfoResponse> ViceClient::checkpointGet(std::uint32_t number)
 QFuture<CheckpointInfoResponse> ViceClient::checkpointSet(std::uint16_t startAddr, std::uint16_t endAddr, bool stopWhenHit, bool enabled, std::uint8_t op, bool temporary, MemSpace memSpace) {
     auto promise = new QPromise<CheckpointInfoResponse>();
     auto res = promise->future();
-    ResponseSetter* responseSetter = new ResponseSetterImpl<CheckpointInfoResponse>(connectionWorker_, promise);
-
-    std::vector<std::uint8_t> body;
-    body << startAddr
-         << endAddr
-         << (std::uint8_t)stopWhenHit
-         << (std::uint8_t)enabled
-         << op
-         << (std::uint8_t)temporary
-         << (std::uint8_t)memSpace;
-    emit sendCommand(CMD_CHECKPOINT_SET, body, responseSetter);
+    ResponseSetter* responseSetter = new ResponseSetterImpl<CheckpointInfoResponse>(promise);
+
+    send(CheckpointSetCommand{startAddr, endAddr, stopWhenHit, enabled, op, temporary, (std::uint8_t)memSpace}, responseSetter);
+
+    return res;
+}
+
+QFuture<ConditionSetResponse> ViceClient::conditionSet(std::uint32_t checkpointNumber, const std::string& condition) {
+    auto promise = new QPromise<ConditionSetResponse>();
+    auto res = promise->future();
+    ResponseSetter* responseSetter = new ResponseSetterImpl<ConditionSetResponse>(promise);
+
+    send(ConditionSetCommand{checkpointNumber, condition.substr(0, 255)}, responseSetter);
 
     return res;
 }
@@ -283,12 +202,9 @@ QFuture<CheckpointInfoResponse> ViceClient::checkpointSet(std::uint16_t startAdd
 QFuture<AdvanceInstructionsResponse> ViceClient::advanceInstructions(bool stepOverSubroutines, int nofInstructions) {
     auto promise = new QPromise<AdvanceInstructionsResponse>();
     auto res = promise->future();
-    ResponseSetter* responseSetter = new ResponseSetterImpl<AdvanceInstructionsResponse>(connectionWorker_, promise);
+    ResponseSetter* responseSetter = new ResponseSetterImpl<AdvanceInstructionsResponse>(promise);
 
-    std::vector<std::uint8_t> body;
-    body << (std::uint8_t)stepOverSubroutines
-         << (std::uint16_t)nofInstructions;
-    emit sendCommand(CMD_ADVANCE_INSTRUCTIONS, body, responseSetter);
+    send(AdvanceInstructionsCommand{stepOverSubroutines, (std::uint16_t)nofInstructions}, responseSetter);
 
     return res;
 }
@@ -296,10 +212,19 @@ QFuture<AdvanceInstructionsResponse> ViceClient::advanceInstructions(bool stepOv
 QFuture<ExecuteUntilReturnResponse> ViceClient::executeUntilReturn() {
     auto promise = new QPromise<ExecuteUntilReturnResponse>();
     auto res = promise->future();
-    ResponseSetter* responseSetter = new ResponseSetterImpl<ExecuteUntilReturnResponse>(connectionWorker_, promise);
+    ResponseSetter* responseSetter = new ResponseSetterImpl<ExecuteUntilReturnResponse>(promise);
 
-    std::vector<std::uint8_t> body;
-    emit sendCommand(CMD_EXECUTE_UNTIL_RETURN, body, responseSetter);
+    send(ExecuteUntilReturnCommand{}, responseSetter);
+
+    return res;
+}
+
+QFuture<PingResponse> ViceClient::ping() {
+    auto promise = new QPromise<PingResponse>();
+    auto res = promise->future();
+    ResponseSetter* responseSetter = new ResponseSetterImpl<PingResponse>(promise);
+
+    send(PingCommand{}, responseSetter);
 
     return res;
 }
@@ -307,10 +232,9 @@ QFuture<ExecuteUntilReturnResponse> ViceClient::executeUntilReturn() {
 QFuture<BanksAvailableResponse> ViceClient::banksAvailable() {
     auto promise = new QPromise<BanksAvailableResponse>();
     auto res = promise->future();
-    ResponseSetter* responseSetter = new ResponseSetterImpl<BanksAvailableResponse>(connectionWorker_, promise);
+    ResponseSetter* responseSetter = new ResponseSetterImpl<BanksAvailableResponse>(promise);
 
-    std::vector<std::uint8_t> body;
-    emit sendCommand(CMD_BANKS_AVAILABLE, body, responseSetter);
+    send(BanksAvailableCommand{}, responseSetter);
 
     return res;
 }
@@ -318,14 +242,21 @@ QFuture<BanksAvailableResponse> ViceClient::banksAvailable() {
 QFuture<ExitResponse> ViceClient::exit() {
     auto promise = new QPromise<ExitResponse>();
     auto res = promise->future();
-    ResponseSetter* responseSetter = new ResponseSetterImpl<ExitResponse>(connectionWorker_, promise);
+    ResponseSetter* responseSetter = new ResponseSetterImpl<ExitResponse>(promise);
 
-    std::vector<std::uint8_t> body;
-    emit sendCommand(CMD_EXIT, body, responseSetter);
+    send(ExitCommand{}, responseSetter);
 
     return res;
 }
 
+void ViceClient::send(std::uint8_t cmd, std::vector<std::uint8_t>&& body, ResponseSetter* responseSetter, std::uint32_t generation, RequestPriority priority) {
+    // A queued signal would copy the body into the event; the functor is moved instead.
+    ConnectionWorker* worker = connectionWorker_;
+    QMetaObject::invokeMethod(connectionWorker_, [worker, cmd, body = std::move(body), responseSetter, generation, priority]() mutable {
+        worker->sendCommand(cmd, std::move(body), responseSetter, generation, priority);
+    }, Qt::QueuedConnection);
+}
+
 void ViceClient::onOobResponseReceived(std::shared_ptr<Response> r) {
     qDebug() << "OOB Response received: " << r->responseType;
     switch(r->responseType) {
@@ -339,6 +270,13 @@ void ViceClient::onOobResponseReceived(std::shared_ptr<Response> r) {
         emit resumedResponseReceived(sr->pc);
         break;
     }
+    case RESPONSE_CHECKPOINT_INFO: {
+        auto cr = std::reinterpret_pointer_cast<CheckpointInfoResponse>(r);
+        if (cr->checkpoint.hit) {
+            emit checkpointHit(cr->checkpoint.number);
+        }
+        break;
+    }
     default:
         qDebug() << "OOB Reponse " << r->responseType << "ignored.";
     }
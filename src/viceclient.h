@@ -44,17 +44,29 @@ public:
     ViceClient(QObject* parent);
     ~ViceClient();
 
-    bool connectToVice(const QString& host, int port, int timeoutMs);
+    // Resolves to whether the connection could be established within the timeout.
+    QFuture<bool> connectToVice(const QString& host, int port, int timeoutMs);
     void disconnect();
 
+    // Number of requests that are sent to VICE before waiting for responses.
+    void setMaxRequestsInFlight(int maxInFlight);
+
+    // Marks all reads (memGet, registersGet) issued so far as superseded: the
+    // ones that are not sent yet are dropped, and their futures canceled.
+    void supersedeReads();
+
     QFuture<CheckpointListResponse> checkpointList();
     QFuture<CheckpointDeleteResponse> checkpointDelete(std::uint32_t number);
     QFuture<CheckpointToggleResponse> checkpointToggle(std::uint32_t number, bool enabled);
     QFuture<CheckpointInfoResponse> checkpointGet(std::uint32_t number);
     QFuture<CheckpointInfoResponse> checkpointSet(std::uint16_t startAddr, std::uint16_t endAddr, bool stopWhenHit, bool enabled, std::uint8_t op, bool temporary, MemSpace memSpace);
+    // VICE answers with an error code if it can't parse the condition. At most 255 characters.
+    QFuture<ConditionSetResponse> conditionSet(std::uint32_t checkpointNumber, const std::string& condition);
 
-    QFuture<MemGetResponse> memGet(uint16_t startAddress, uint16_t endAddress, MemSpace memSpace , uint16_t bankID, bool sideEffects);
-    QFuture<MemSetResponse> memSet(uint16_t startAddress, MemSpace memSpace , uint16_t bankID, bool sideEffects, std::vector<std::uint8_t> data );
+    // Reads with side effects are always sent as interactive requests.
+    QFuture<MemGetResponse> memGet(uint16_t startAddress, uint16_t endAddress, MemSpace memSpace , uint16_t bankID, bool sideEffects,
+                                   RequestPriority priority = RequestPriority::INTERACTIVE);
+    QFuture<MemSetResponse> memSet(uint16_t startAddress, MemSpace memSpace , uint16_t bankID, bool sideEffects, const std::vector<std::uint8_t>& data);
     QFuture<RegistersResponse> registersGet(MemSpace memSpace);
     QFuture<RegistersResponse> registersSet(MemSpace memSpace, std::map<std::uint8_t, std::uint16_t> values);
 
@@ -63,19 +75,22 @@ public:
     QFuture<AdvanceInstructionsResponse> advanceInstructions(bool stepOverSubroutines, int nofInstructions);
     QFuture<ExecuteUntilReturnResponse> executeUntilReturn();
 
+    QFuture<PingResponse> ping();
     QFuture<BanksAvailableResponse> banksAvailable();
 
     QFuture<ExitResponse> exit();
 
 signals:
     // Signals to communicate with connection worker.
-    void sendCommand(std::uint8_t cmd, std::vector<std::uint8_t> body, ResponseSetter* responseSetter);
     void connectionRequested(QString host, int port, int timeoutMs, QPromise<bool>* resultPromise);
     void disconnectRequested();
+    void maxRequestsInFlightChanged(int maxInFlight);
 
     // Signals that propagate OOB messages
     void stoppedResponseReceived(std::uint16_t pc);
     void resumedResponseReceived(std::uint16_t pc);
+    // VICE reports the checkpoint that was hit right before the STOPPED event.
+    void checkpointHit(std::uint32_t number);
 
 private slots:
     void onOobResponseReceived(std::shared_ptr<Response> r);
@@ -84,8 +99,22 @@ private slots:
 //    void handleResponse(std::uint8_t responseType, std::uint8_t errCode, std::uint32_t requestId, QByteArray body);
 
 private:
+    void send(std::uint8_t cmd, std::vector<std::uint8_t>&& body, ResponseSetter* responseSetter, std::uint32_t generation, RequestPriority priority);
+
+    template<typename C>
+    void send(const C& command, ResponseSetter* responseSetter) {
+        send(C::kCommand, encode(command), responseSetter, ConnectionWorker::kNoGeneration, RequestPriority::INTERACTIVE);
+    }
+
+    // For side effect free requests only, see supersedeReads().
+    template<typename C>
+    void sendRead(const C& command, ResponseSetter* responseSetter, RequestPriority priority = RequestPriority::INTERACTIVE) {
+        send(C::kCommand, encode(command), responseSetter, readGeneration_, priority);
+    }
+
     QThread connectionWorkerThread_;
     ConnectionWorker* connectionWorker_;
+    std::uint32_t readGeneration_;
 };
 
 }
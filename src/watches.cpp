@@ -104,7 +104,10 @@ QString cbmDoubleToString(double d) {
 }
 
 QString Watch::asString(const std::unordered_map<std::uint16_t, std::vector<std::uint8_t>>& memory, std::uint32_t petsciiBase) const {
-    const std::vector<std::uint8_t>& mem = memory.at(bankId);
+    return asString(memory.at(bankId), petsciiBase);
+}
+
+QString Watch::asString(const std::vector<std::uint8_t>& mem, std::uint32_t petsciiBase) const {
     switch(viewType) {
     case INT:
         return QString::asprintf("%d", readInt(mem, addrStart, len));
@@ -45,6 +45,12 @@ struct Watch {
     std::uint16_t len;
 
     QString asString(const std::unordered_map<std::uint16_t, std::vector<std::uint8_t>>& memory, std::uint32_t petsciiBase = PETSCII::kLCBase) const;
+    QString asString(const std::vector<std::uint8_t>& bankMemory, std::uint32_t petsciiBase = PETSCII::kLCBase) const;
+
+    // Number of bytes the watch reads.
+    std::uint16_t size() const {
+        return viewType == FLOAT ? 5 : len;
+    }
 
     QString viewTypeAsString() const;
 };
@@ -20,25 +20,37 @@
 #include "widgets/breakpointswidget.h"
 
 #include <QCheckBox>
+#include <QFileDialog>
 #include <QGroupBox>
 #include <QHBoxLayout>
+#include <QMessageBox>
 #include <QVBoxLayout>
 #include <QSpacerItem>
 #include <QStringList>
 #include <QTimer>
 
+#include <fstream>
+
 #include "dialogs/breakpointdialog.h"
 
 namespace vicedebug {
 
+namespace {
+
+QString traceStr(std::size_t hits, double hitsPerSecond) {
+    return QString("%1 hits, %2/s").arg(hits).arg(hitsPerSecond, 0, 'f', 0);
+}
+
+}
+
 BreakpointsWidget::BreakpointsWidget(Controller* controller, SymTable* symtab, QWidget* parent) :
     QGroupBox("Breakpoints", parent), controller_(controller), symtab_(symtab)
 {
     QStringList l;
 
     tree_ = new QTreeWidget();
-    tree_->setColumnCount(3);
-    tree_->setHeaderLabels({ "Enabled","Address","Type"} );
+    tree_->setColumnCount(5);
+    tree_->setHeaderLabels({ "Enabled","Address","Type","Condition","Trace"} );
     tree_->setSelectionBehavior(QAbstractItemView::SelectRows);
     connect(tree_, &QTreeWidget::itemSelectionChanged, this, &BreakpointsWidget::onTreeItemSelectionChanged);
     connect(tree_, &QTreeWidget::itemChanged, this, &BreakpointsWidget::onTreeItemChanged);
@@ -52,9 +64,15 @@ BreakpointsWidget::BreakpointsWidget(Controller* controller, SymTable* symtab, Q
     removeBtn_->setIcon(QIcon(":/images/codicons/remove.svg"));
     connect(removeBtn_, &QToolButton::clicked, this, &BreakpointsWidget::onRemoveClicked);
 
+    exportBtn_ = new QToolButton();
+    exportBtn_->setIcon(QIcon(":/images/codicons/export.svg"));
+    exportBtn_->setToolTip("Export the tracepoint's log");
+    connect(exportBtn_, &QToolButton::clicked, this, &BreakpointsWidget::onExportClicked);
+
     QVBoxLayout* vLayout = new QVBoxLayout();
     vLayout->addWidget(addBtn_);
     vLayout->addWidget(removeBtn_);
+    vLayout->addWidget(exportBtn_);
     vLayout->addStretch(10);
 
     QHBoxLayout* hLayout = new QHBoxLayout();
@@ -68,6 +86,8 @@ BreakpointsWidget::BreakpointsWidget(Controller* controller, SymTable* symtab, Q
     connect(controller_, &Controller::executionPaused, this, &BreakpointsWidget::onExecutionPaused);
     connect(controller_, &Controller::executionResumed, this, &BreakpointsWidget::onExecutionResumed);
     connect(controller_, &Controller::breakpointsChanged, this, &BreakpointsWidget::onBreakpointsChanged);       
+    connect(controller_, &Controller::breakpointConditionRejected, this, &BreakpointsWidget::onBreakpointConditionRejected);
+    connect(controller_, &Controller::tracepointHit, this, &BreakpointsWidget::onTracepointHit);
 
     enableControls(false);
 }
@@ -98,6 +118,16 @@ void BreakpointsWidget::addItem(int bpIdx) {
     item->setCheckState(0, bp.enabled ? Qt::Checked : Qt::Unchecked);
     item->setText(1, rangeStr);
     item->setText(2, typeStr);
+    if (bp.hasCondition) {
+        QString condition = bp.condition.empty() ? "(set in VICE)" : QString::fromStdString(bp.condition);
+        item->setText(3, condition);
+        item->setToolTip(3, "Only breaks if " + condition + " holds. VICE evaluates the condition, so other hits don't stop the emulation.");
+    }
+    const TraceLog* log = controller_->traceLog(bp.number);
+    if (log != nullptr) {
+        item->setText(4, traceStr(log->size(), 0));
+        item->setToolTip(4, "Records " + QString::fromStdString(log->spec().toString()) + " on every hit, and continues.");
+    }
     item->setData(0, Qt::UserRole, QVariant(bpIdx));
 
     tree_->insertTopLevelItem(tree_->topLevelItemCount(), item);
@@ -108,6 +138,16 @@ void BreakpointsWidget::enableControls(bool enable) {
     tree_->setEnabled(enable);
     addBtn_->setEnabled(enable);
     removeBtn_->setEnabled(enable && tree_->selectedItems().size() == 1);
+    const Breakpoint* bp = selectedBreakpoint();
+    exportBtn_->setEnabled(enable && bp != nullptr && bp->trace.has_value());
+}
+
+const Breakpoint* BreakpointsWidget::selectedBreakpoint() {
+    auto selected = tree_->selectedItems();
+    if (selected.size() != 1) {
+        return nullptr;
+    }
+    return &breakpoints_[selected[0]->data(0, Qt::UserRole).toInt()];
 }
 
 void BreakpointsWidget::clearTree() {
@@ -154,9 +194,25 @@ void BreakpointsWidget::onBreakpointsChanged(const Breakpoints& breakpoints) {
     fillTree(breakpoints);
 }
 
+void BreakpointsWidget::onBreakpointConditionRejected(const std::string& condition) {
+    QMessageBox::warning(this, "Invalid condition", QString("VICE can't parse the condition \"%1\", the breakpoint was not created.").arg(QString::fromStdString(condition)));
+}
+
+void BreakpointsWidget::onTracepointHit(std::uint32_t breakpointNumber, std::size_t hits, double hitsPerSecond) {
+    for (int i = 0; i < tree_->topLevelItemCount(); i++) {
+        QTreeWidgetItem* item = tree_->topLevelItem(i);
+        if (breakpoints_[item->data(0, Qt::UserRole).toInt()].number == breakpointNumber) {
+            item->setText(4, traceStr(hits, hitsPerSecond));
+            return;
+        }
+    }
+}
+
 void BreakpointsWidget::onTreeItemSelectionChanged() {
     auto selectedItems = tree_->selectedItems();
     removeBtn_->setEnabled(selectedItems.size() == 1);
+    const Breakpoint* bp = selectedBreakpoint();
+    exportBtn_->setEnabled(bp != nullptr && bp->trace.has_value());
 }
 
 void BreakpointsWidget::onTreeItemChanged(QTreeWidgetItem* item, int column) {
@@ -184,7 +240,7 @@ void BreakpointsWidget::onTreeItemDoubleClicked(QTreeWidgetItem* item, int colum
         Breakpoint modifiedBp = dlg.breakpoint();
         bool wasEnabled = bp.enabled;
         controller_->deleteBreakpoint(bp.number);
-        controller_->createBreakpoint(modifiedBp.op, modifiedBp.addrStart, modifiedBp.addrEnd, wasEnabled);
+        controller_->createBreakpoint(modifiedBp.op, modifiedBp.addrStart, modifiedBp.addrEnd, wasEnabled, modifiedBp.condition, modifiedBp.trace);
     }
     qDebug() << "Leaving onTreeItemDoubleClicked()";
 }
@@ -194,7 +250,7 @@ void BreakpointsWidget::onAddClicked() {
     int res = dlg.exec();
     if (res == QDialog::DialogCode::Accepted) {
         Breakpoint bp = dlg.breakpoint();
-        controller_->createBreakpoint(bp.op, bp.addrStart,bp.addrEnd, true);
+        controller_->createBreakpoint(bp.op, bp.addrStart,bp.addrEnd, true, bp.condition, bp.trace);
     }
 }
 
@@ -209,4 +265,30 @@ void BreakpointsWidget::onRemoveClicked() {
     controller_->deleteBreakpoint(bp.number);
 }
 
+void BreakpointsWidget::onExportClicked() {
+    const Breakpoint* bp = selectedBreakpoint();
+    const TraceLog* log = bp != nullptr ? controller_->traceLog(bp->number) : nullptr;
+    if (log == nullptr) {
+        return;
+    }
+    QString csvFilter = tr("CSV files (*.csv)");
+    QString selectedFilter = csvFilter;
+    auto fileName = QFileDialog::getSaveFileName(this,
+        tr("Export trace log"), QString::asprintf("tracepoint-%04x.csv", bp->addrStart),
+        csvFilter + ";;" + tr("Binary trace logs (*.vdtrace)"), &selectedFilter).toStdString();
+    if (fileName.empty()) {
+        return;
+    }
+    std::ofstream out(fileName, std::ios::binary);
+    if (!out) {
+        QMessageBox::warning(this, tr("Export trace log"), tr("Can't write %1").arg(QString::fromStdString(fileName)));
+        return;
+    }
+    if (selectedFilter == csvFilter) {
+        log->writeCsv(out);
+    } else {
+        log->writeBinary(out);
+    }
+}
+
 }
@@ -51,6 +51,8 @@ public slots:
     void onExecutionResumed();
     void onExecutionPaused(const MachineState& machineState);
     void onBreakpointsChanged(const Breakpoints& breakpoints);
+    void onBreakpointConditionRejected(const std::string& condition);
+    void onTracepointHit(std::uint32_t breakpointNumber, std::size_t hits, double hitsPerSecond);
 
 private slots:
     void onTreeItemSelectionChanged();
@@ -58,9 +60,11 @@ private slots:
     void onTreeItemDoubleClicked(QTreeWidgetItem* item, int column);
     void onAddClicked();
     void onRemoveClicked();
+    void onExportClicked();
 
 private:
     void addItem(int bpIdx);
+    const Breakpoint* selectedBreakpoint();
 
     void enableControls(bool enable);
     void clearTree();
@@ -73,6 +77,7 @@ private:
     QTreeWidget* tree_;
     QToolButton* addBtn_;
     QToolButton* removeBtn_;
+    QToolButton* exportBtn_;
 };
 
 }
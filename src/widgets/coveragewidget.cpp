@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "widgets/coveragewidget.h"
+
+#include <QFileDialog>
+#include <QFormLayout>
+#include <QHBoxLayout>
+#include <QMessageBox>
+#include <QVBoxLayout>
+
+#include <fstream>
+
+namespace vicedebug {
+
+namespace {
+
+const char* kFileFilter = "Coverage files (*.vdcov)";
+
+// Hex, or decimal with a leading '+'.
+std::uint16_t parseAddress(QString str, bool& ok) {
+    str = str.trimmed();
+    if (str.length() == 0) {
+        ok = false;
+        return 0;
+    }
+    int base = 16;
+    if (str[0] == '+') {
+        str = str.mid(1);
+        base = 10;
+    }
+    uint res = str.toUInt(&ok, base);
+    if (res > 0xffff) {
+        res = 0;
+        ok = false;
+    }
+    return res;
+}
+
+}
+
+CoverageWidget::CoverageWidget(Controller* controller, QWidget* parent)
+    : QWidget(parent, Qt::Tool), controller_(controller), connected_(controller->isConnected()), paused_(connected_)
+{
+    setWindowTitle(tr("Code coverage"));
+
+    start_ = new QLineEdit("0801");
+    start_->setToolTip(tr("First address of the code"));
+    connect(start_, &QLineEdit::textChanged, this, &CoverageWidget::enableControls);
+    end_ = new QLineEdit("9fff");
+    end_->setToolTip(tr("Last address of the code"));
+    connect(end_, &QLineEdit::textChanged, this, &CoverageWidget::enableControls);
+
+    startStopBtn_ = new QPushButton(tr("Start"));
+    connect(startStopBtn_, &QPushButton::clicked, this, &CoverageWidget::onStartStopClicked);
+    exportBtn_ = new QPushButton(tr("Export..."));
+    connect(exportBtn_, &QPushButton::clicked, this, &CoverageWidget::onExportClicked);
+    mergeBtn_ = new QPushButton(tr("Merge..."));
+    mergeBtn_->setToolTip(tr("Add the coverage of an earlier run"));
+    connect(mergeBtn_, &QPushButton::clicked, this, &CoverageWidget::onMergeClicked);
+    clearBtn_ = new QPushButton(tr("Clear"));
+    connect(clearBtn_, &QPushButton::clicked, this, &CoverageWidget::onClearClicked);
+
+    summary_ = new QLabel();
+
+    QFormLayout* range = new QFormLayout();
+    range->addRow(tr("From:"), start_);
+    range->addRow(tr("To:"), end_);
+
+    QHBoxLayout* buttons = new QHBoxLayout();
+    buttons->addWidget(startStopBtn_);
+    buttons->addStretch(1);
+    buttons->addWidget(exportBtn_);
+    buttons->addWidget(mergeBtn_);
+    buttons->addWidget(clearBtn_);
+
+    QVBoxLayout* layout = new QVBoxLayout();
+    layout->addLayout(range);
+    layout->addLayout(buttons);
+    layout->addWidget(summary_);
+    setLayout(layout);
+
+    connect(controller_, &Controller::connected, this, &CoverageWidget::onConnected);
+    connect(controller_, &Controller::disconnected, this, &CoverageWidget::onDisconnected);
+    connect(controller_, &Controller::executionResumed, this, &CoverageWidget::onExecutionResumed);
+    connect(controller_, &Controller::executionPaused, this, &CoverageWidget::onExecutionPaused);
+    connect(controller_, &Controller::coverageChanged, this, &CoverageWidget::onCoverageChanged);
+
+    onCoverageChanged(controller_->coverage());
+}
+
+CoverageWidget::~CoverageWidget() {
+}
+
+bool CoverageWidget::rangeIsValid(std::uint16_t& start, std::uint16_t& end) const {
+    bool ok;
+    start = parseAddress(start_->text(), ok);
+    if (!ok) {
+        return false;
+    }
+    end = parseAddress(end_->text(), ok);
+    return ok && end >= start;
+}
+
+void CoverageWidget::enableControls() {
+    // Checkpoints are only set and deleted while the machine is paused.
+    bool recording = controller_->isRecordingCoverage();
+    std::uint16_t start, end;
+    startStopBtn_->setEnabled(connected_ && paused_ && (recording || rangeIsValid(start, end)));
+    startStopBtn_->setText(recording ? tr("Stop") : tr("Start"));
+    start_->setEnabled(!recording);
+    end_->setEnabled(!recording);
+    bool empty = controller_->coverage().banks().empty();
+    exportBtn_->setEnabled(!empty);
+    clearBtn_->setEnabled(!empty && !recording);
+}
+
+void CoverageWidget::onConnected() {
+    connected_ = true;
+    paused_ = true;
+    enableControls();
+}
+
+void CoverageWidget::onDisconnected() {
+    connected_ = false;
+    enableControls();
+}
+
+void CoverageWidget::onExecutionResumed() {
+    paused_ = false;
+    enableControls();
+}
+
+void CoverageWidget::onExecutionPaused() {
+    paused_ = true;
+    enableControls();
+}
+
+void CoverageWidget::onStartStopClicked() {
+    if (controller_->isRecordingCoverage()) {
+        controller_->stopCoverage();
+        enableControls();
+        return;
+    }
+    std::uint16_t start, end;
+    if (!rangeIsValid(start, end)) {
+        return;
+    }
+    summary_->setText(tr("Setting checkpoints..."));
+    controller_->startCoverage(start, end);
+    enableControls();
+}
+
+void CoverageWidget::onCoverageChanged(const Coverage& coverage) {
+    QString text = tr("%1 bytes of code covered").arg(coverage.coveredBytes());
+    if (controller_->isRecordingCoverage()) {
+        text += tr(", %1 blocks not run yet").arg(controller_->uncoveredBlocks());
+    }
+    summary_->setText(text);
+    enableControls();
+}
+
+void CoverageWidget::onExportClicked() {
+    auto fileName = QFileDialog::getSaveFileName(this, tr("Export coverage"), "coverage.vdcov", tr(kFileFilter)).toStdString();
+    if (fileName.empty()) {
+        return;
+    }
+    std::ofstream out(fileName, std::ios::binary);
+    if (!out) {
+        QMessageBox::warning(this, tr("Export coverage"), tr("Can't write %1").arg(QString::fromStdString(fileName)));
+        return;
+    }
+    controller_->coverage().write(out);
+}
+
+void CoverageWidget::onMergeClicked() {
+    auto fileName = QFileDialog::getOpenFileName(this, tr("Merge coverage"), QString(), tr(kFileFilter)).toStdString();
+    if (fileName.empty()) {
+        return;
+    }
+    std::ifstream in(fileName, std::ios::binary);
+    std::string error = "Can't read the file";
+    std::optional<Coverage> coverage;
+    if (in) {
+        coverage = Coverage::read(in, error);
+    }
+    if (!coverage.has_value()) {
+        QMessageBox::warning(this, tr("Merge coverage"), QString::fromStdString(fileName + ": " + error));
+        return;
+    }
+    controller_->mergeCoverage(coverage.value());
+}
+
+void CoverageWidget::onClearClicked() {
+    controller_->clearCoverage();
+}
+
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include <QLabel>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QWidget>
+
+#include "controller.h"
+
+namespace vicedebug {
+
+// Records which code runs: the controller arms a checkpoint per code block
+// in the given range, and the covered blocks are shown in the disassembly
+// and memory views. Coverage can be saved, and merged with earlier runs.
+class CoverageWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    CoverageWidget(Controller* controller, QWidget* parent);
+    virtual ~CoverageWidget();
+
+private slots:
+    void onConnected();
+    void onDisconnected();
+    void onExecutionResumed();
+    void onExecutionPaused();
+    void onCoverageChanged(const Coverage& coverage);
+    void onStartStopClicked();
+    void onExportClicked();
+    void onMergeClicked();
+    void onClearClicked();
+
+private:
+    void enableControls();
+    bool rangeIsValid(std::uint16_t& start, std::uint16_t& end) const;
+
+    Controller* controller_;
+
+    QLineEdit* start_;
+    QLineEdit* end_;
+    QPushButton* startStopBtn_;
+    QPushButton* exportBtn_;
+    QPushButton* mergeBtn_;
+    QPushButton* clearBtn_;
+    QLabel* summary_;
+
+    bool connected_;
+    bool paused_;
+};
+
+}
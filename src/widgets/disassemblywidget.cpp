@@ -22,6 +22,7 @@
 #include "resources.h"
 #include "disassembler_6502.h"
 #include "disassembler_z80.h"
+#include "tracing.h"
 
 #include <QEvent>
 #include <QMouseEvent>
@@ -35,12 +36,22 @@
 #include <QVBoxLayout>
 
 #include <iostream>
+#include <algorithm>
+#include <optional>
 
 namespace vicedebug {
 
 namespace {
 
 const int kDecorationBorder =  8;
+
+// Only a window of lines around the visible ones is disassembled. It is
+// extended by kWindowMargin lines when the view scrolls to within
+// kExtendThreshold lines of its ends, and lines at the other end are
+// dropped once it has more than kMaxWindowLines.
+const int kWindowMargin = 128;
+const int kExtendThreshold = 32;
+const std::size_t kMaxWindowLines = 2048;
 const char* kSeparator = "  ";
 
 QColor kDecorationBg = QColor(Qt::lightGray);
@@ -49,12 +60,18 @@ QColor kDecorationBgDisabled = QColor(Qt::lightGray).lighter(120);
 QColor kDisassemblyBg = QColor(Qt::white);
 QColor kDisassemblyBgDisabled = QColor(Qt::lightGray).lighter(120);
 QColor kDisassemblyBgSelected = QColor(Qt::yellow);
+QColor kDisassemblyBgInSelection = QColor(200, 220, 255);
 
 QColor kDisassemblyFg = QColor(Qt::black);
 QColor kDisassemblyFgDisabled = QColor(Qt::lightGray).lighter(80);
 QColor kDisassemblyFgSelected = QColor(Qt::black);
+QColor kCyclesFg = QColor(Qt::darkGray);
 QColor kBreakpointFg = QColor(Qt::red);
 QColor kBreakpointFgDisabled = QColor(Qt::lightGray).lighter(80);
+QColor kCoveredFg = QColor(Qt::darkGreen);
+QColor kCoveredFgDisabled = QColor(Qt::lightGray).lighter(80);
+
+const int kCoverageBarW = 3;
 
 }
 
@@ -134,6 +151,14 @@ DisassemblyWidget::DisassemblyWidget(Controller* controller, SymTable* symtab, Q
         }
     });
 
+    cyclesLabel_ = new QLabel();
+    cyclesLabel_->setToolTip(tr("Click a line for the cycles of its basic block, drag or shift-click to select lines"));
+    connect(content_, &DisassemblyContent::cyclesSelected, this, [this](const Disassembler::CycleTotals& totals, bool basicBlock) {
+        QString cycles = totals.minCycles == totals.maxCycles ? QString::number(totals.minCycles) : QString("%1-%2").arg(totals.minCycles).arg(totals.maxCycles);
+        cyclesLabel_->setText(tr("%1: %2 instructions, %3 cycles").arg(basicBlock ? tr("Block") : tr("Selection")).arg(totals.instructions).arg(cycles));
+    });
+    connect(content_, &DisassemblyContent::selectionCleared, cyclesLabel_, &QLabel::clear);
+
     QHBoxLayout* toolbar = new QHBoxLayout();
     toolbar->addWidget(addressEdit_);
     toolbar->addWidget(goToAddressBtn_);
@@ -141,6 +166,7 @@ DisassemblyWidget::DisassemblyWidget(Controller* controller, SymTable* symtab, Q
     toolbar->addWidget(cpuLabel_);
     toolbar->addWidget(cpuCombo_);
     toolbar->addStretch();
+    toolbar->addWidget(cyclesLabel_);
 
     // Set up final layout
     QVBoxLayout* layout = new QVBoxLayout();
@@ -157,8 +183,7 @@ DisassemblyWidget::~DisassemblyWidget() {
 
 void DisassemblyWidget::onSymTabChanged() {
     if (connected_) {
-        content_->updateDisassembly();
-        content_->update();
+        content_->onSymTabChanged();
     }
 }
 
@@ -185,7 +210,7 @@ std::optional<std::uint16_t> DisassemblyWidget::parseAddress(QString s) {
 // ------------------------------------------------------------
 
 DisassemblyContent::DisassemblyContent(Controller* controller, SymTable* symtab, QScrollArea* parent) :
-    QWidget(parent), symtab_(symtab), controller_(controller), mouseDown_(false), highlightedLine_(-1), scrollArea_(parent), pc_(0) {
+    QWidget(parent), symtab_(symtab), controller_(controller), mouseDown_(false), selecting_(false), extendingWindow_(false), selectionEnd_(0), highlightedLine_(-1), scrollArea_(parent), bankId_(0), pc_(0), cpu_(Cpu::MOS6502) {
 
     disassemblersPerCpu_[Cpu::MOS6502] = std::make_shared<Disassembler6502>(symtab);
     disassemblersPerCpu_[Cpu::Z80] = std::make_shared<DisassemblerZ80>(symtab);
@@ -202,6 +227,8 @@ DisassemblyContent::DisassemblyContent(Controller* controller, SymTable* symtab,
     separatorW_ = fm.horizontalAdvance(kSeparator);
     hexW_ = fm.horizontalAdvance("00 ");
     charW_ = fm.horizontalAdvance("0");
+    bytesW_ = 4 * hexW_ - charW_; // Z80 instructions have up to 4 bytes
+    cyclesW_ = fm.horizontalAdvance("00-00");
 
     connect(controller_, &Controller::connected, this, &DisassemblyContent::onConnected);
     connect(controller_, &Controller::disconnected, this, &DisassemblyContent::onDisconnected);
@@ -210,14 +237,17 @@ DisassemblyContent::DisassemblyContent(Controller* controller, SymTable* symtab,
     connect(controller_, &Controller::breakpointsChanged, this, &DisassemblyContent::onBreakpointsChanged);
     connect(controller_, &Controller::registersChanged, this, &DisassemblyContent::onRegistersChanged);
     connect(controller_, &Controller::memoryChanged, this, &DisassemblyContent::onMemoryChanged);
+    connect(controller_, &Controller::coverageChanged, this, &DisassemblyContent::onCoverageChanged);
+    connect(scrollArea_->verticalScrollBar(), &QScrollBar::valueChanged, this, &DisassemblyContent::onScrolled);
+    connect(scrollArea_->verticalScrollBar(), &QScrollBar::rangeChanged, this, &DisassemblyContent::onScrolled);
 
-    setMinimumWidth(decorationsW_ + separatorW_ + addressW_ + separatorW_ + 3 * hexW_ - charW_ + separatorW_ + 30 * charW_);
+    setMinimumWidth(decorationsW_ + separatorW_ + addressW_ + separatorW_ + bytesW_ + separatorW_ + cyclesW_ + separatorW_ + 30 * charW_);
 
     enableControls(false);
 }
 
 QSize DisassemblyContent::sizeHint() const {
-    return QSize(decorationsW_ + separatorW_ + addressW_ + separatorW_ + 3 * hexW_ - charW_ + separatorW_ + 30 * charW_, lines_.size()*lineH_);
+    return QSize(decorationsW_ + separatorW_ + addressW_ + separatorW_ + bytesW_ + separatorW_ + cyclesW_ + separatorW_ + 30 * charW_, lines_.size()*lineH_);
 }
 
 void DisassemblyContent::mousePressEvent(QMouseEvent* event) {
@@ -227,7 +257,23 @@ void DisassemblyContent::mousePressEvent(QMouseEvent* event) {
         return;
     }
     int x = event->position().x();
-    if (x < 0 || x >= decorationsW_) {
+    if (x >= decorationsW_) {
+        // Select lines, shift-click extends the selection.
+        int lineIdx = lineAt(event->position());
+        if (lineIdx < 0) {
+            event->ignore();
+            return;
+        }
+        int anchor = lineIdx;
+        if ((event->modifiers() & Qt::ShiftModifier) && selectionAnchor_.has_value()) {
+            anchor = lineOf(*selectionAnchor_).value_or(lineIdx);
+        }
+        selectLines(anchor, lineIdx);
+        selecting_ = true;
+        event->accept();
+        return;
+    }
+    if (x < 0) {
         // Not in decorations area.
         event->ignore();
         return;
@@ -236,7 +282,25 @@ void DisassemblyContent::mousePressEvent(QMouseEvent* event) {
     event->accept();
 }
 
+void DisassemblyContent::mouseMoveEvent(QMouseEvent* event) {
+    if (!selecting_) {
+        event->ignore();
+        return;
+    }
+    int lineIdx = lineAt(event->position());
+    std::optional<int> anchor = lineOf(*selectionAnchor_);
+    if (lineIdx >= 0 && anchor.has_value() && lines_.addr[lineIdx] != selectionEnd_) {
+        selectLines(anchor.value(), lineIdx);
+    }
+    event->accept();
+}
+
 void DisassemblyContent::mouseReleaseEvent(QMouseEvent* event) {
+    if (selecting_) {
+        selecting_ = false;
+        event->accept();
+        return;
+    }
     if (!mouseDown_) {
         // left button was never pressed, ignore.
         return;
@@ -257,7 +321,7 @@ void DisassemblyContent::mouseReleaseEvent(QMouseEvent* event) {
         return;
     }
 
-    std::uint16_t addr = lines_[lineIdx].addr;
+    std::uint16_t addr = lines_.addr[lineIdx];
     auto it = addressToBreakpoint_.find(addr);
     if (it != addressToBreakpoint_.end()) {
         // We *do* have a breakpoint here! Remove it.
@@ -274,7 +338,59 @@ void DisassemblyContent::mouseReleaseEvent(QMouseEvent* event) {
     update();
 }
 
+std::optional<int> DisassemblyContent::lineOf(std::uint16_t addr) const {
+    // The lines are sorted by address.
+    auto it = std::lower_bound(lines_.addr.begin(), lines_.addr.end(), addr);
+    if (it == lines_.addr.end() || *it != addr) {
+        return std::nullopt;
+    }
+    return it - lines_.addr.begin();
+}
+
+int DisassemblyContent::lineAtOrBefore(std::uint16_t addr) const {
+    auto it = std::upper_bound(lines_.addr.begin(), lines_.addr.end(), addr);
+    return std::max((int)(it - lines_.addr.begin()) - 1, 0);
+}
+
+int DisassemblyContent::lineAt(QPointF pos) const {
+    int lineIdx = pos.y() / lineH_;
+    return pos.y() >= 0 && lineIdx < lines_.size() ? lineIdx : -1;
+}
+
+std::optional<std::pair<int, int>> DisassemblyContent::selectedLines() const {
+    if (!selectionAnchor_.has_value() || disassembler_ == nullptr) {
+        return std::nullopt;
+    }
+    std::optional<int> anchor = lineOf(*selectionAnchor_);
+    std::optional<int> end = lineOf(selectionEnd_);
+    if (!anchor.has_value() || !end.has_value()) {
+        return std::nullopt;
+    }
+    if (*anchor == *end) {
+        return disassembler_->basicBlock(lines_, *anchor);
+    }
+    return std::pair<int, int>{std::min(*anchor, *end), std::max(*anchor, *end)};
+}
+
+void DisassemblyContent::selectLines(int anchor, int end) {
+    selectionAnchor_ = lines_.addr[anchor];
+    selectionEnd_ = lines_.addr[end];
+    reportSelection();
+    update();
+}
+
+void DisassemblyContent::reportSelection() {
+    auto selected = selectedLines();
+    if (!selected.has_value()) {
+        emit selectionCleared();
+        return;
+    }
+    bool basicBlock = *selectionAnchor_ == selectionEnd_;
+    emit cyclesSelected(Disassembler::cycleTotals(lines_, selected->first, selected->second), basicBlock);
+}
+
 void DisassemblyContent::paintEvent(QPaintEvent* event) {
+    TraceScope trace("paint disassembly");
     QPainter painter(this);
 //    painter.setFont(Fonts::robotoMono());
     painter.setBackgroundMode(Qt::OpaqueMode);
@@ -294,17 +410,25 @@ void DisassemblyContent::paintLine(QPainter& painter, const QRect& updateRect, i
     QColor disassemblyBg;
     QColor disassemblyFg;
     QColor breakpointFg;
+    QColor coveredFg;
+    QColor cyclesFg;
     if (isEnabled()) {
         bool isSelected = lineIdx == highlightedLine_;
+        auto selection = selectedLines();
+        bool inSelection = selection.has_value() && selection->first <= lineIdx && lineIdx <= selection->second;
         decorationBg = kDecorationBg;
-        disassemblyBg = isSelected ? kDisassemblyBgSelected : kDisassemblyBg;
+        disassemblyBg = isSelected ? kDisassemblyBgSelected : inSelection ? kDisassemblyBgInSelection : kDisassemblyBg;
         disassemblyFg = isSelected ? kDisassemblyFgSelected : kDisassemblyFg;
         breakpointFg = kBreakpointFg;
+        coveredFg = kCoveredFg;
+        cyclesFg = kCyclesFg;
     } else {
         decorationBg = kDecorationBgDisabled;
         disassemblyBg = kDisassemblyBgDisabled;
         disassemblyFg = kDisassemblyFgDisabled;
         breakpointFg = kBreakpointFgDisabled;
+        coveredFg = kCoveredFgDisabled;
+        cyclesFg = kDisassemblyFgDisabled;
     }
 
     QRect decoR(0, lineIdx * lineH_, decorationsW_, lineH_);
@@ -317,7 +441,7 @@ void DisassemblyContent::paintLine(QPainter& painter, const QRect& updateRect, i
         return;
     }
 
-    const Disassembler::Line& line = lines_[lineIdx];
+    Disassembler::Decoded line = lines_[lineIdx];
 
     // Decorations
     auto it = addressToBreakpoint_.find(line.addr);
@@ -331,6 +455,9 @@ void DisassemblyContent::paintLine(QPainter& painter, const QRect& updateRect, i
         painter.setBrush(breakpointEnabled ? QBrush(breakpointFg) : Qt::NoBrush);
         painter.drawEllipse(QPoint{cx,cy},radius,radius);
     }
+    if (coverage_.isCovered(line.addr)) {
+        painter.fillRect(QRect(decoR.left(), decoR.top(), kCoverageBarW, decoR.height()), coveredFg);
+    }
 
     // Disassembly
 
@@ -343,11 +470,20 @@ void DisassemblyContent::paintLine(QPainter& painter, const QRect& updateRect, i
     painter.drawText(x + separatorW_/2, y, addr);
 
     // ... bytes
-    for (int i = 0; i < line.bytes.size(); i++) {
-        QString text = QString::asprintf("%02X", line.bytes[i]);
+    for (int i = 0; i < line.length; i++) {
+        QString text = QString::asprintf("%02X", memory_[(line.addr + i) % 0xffff]);
         painter.drawText(x + separatorW_/2 + addressW_ + separatorW_ + i * hexW_, y, text);
     }
 
+    // ... cycles
+    int cyclesX = x + separatorW_/2 + addressW_ + separatorW_ + bytesW_ + separatorW_;
+    if (line.maxCycles > 0) {
+        QString cycles = line.minCycles == line.maxCycles ? QString::number(line.minCycles) : QString::asprintf("%d-%d", line.minCycles, line.maxCycles);
+        painter.setPen(cyclesFg);
+        painter.drawText(cyclesX, y, cycles);
+        painter.setPen(disassemblyFg);
+    }
+
     std::string disassembly;
 
     // ... label (if there are any)
@@ -362,8 +498,8 @@ void DisassemblyContent::paintLine(QPainter& painter, const QRect& updateRect, i
     }
 
     // ... disassembly
-    disassembly = labelPart.toStdString() + line.disassembly;
-    painter.drawText(x + separatorW_/2 + addressW_ + separatorW_ + 3 * hexW_ - charW_ + separatorW_ , y, disassembly.c_str());
+    disassembly = labelPart.toStdString() + formatter_.format(line);
+    painter.drawText(cyclesX + cyclesW_ + separatorW_, y, disassembly.c_str());
 }
 
 DisassemblyContent::~DisassemblyContent() {
@@ -375,17 +511,25 @@ void DisassemblyContent::enableControls(bool enable) {
 
 void DisassemblyContent::onConnected(const MachineState& machineState, const Banks& banks, const Breakpoints& breakpoints) {
     memory_ = machineState.memory.at(machineState.cpuBankId);
+    bankId_ = machineState.cpuBankId;
     pc_ = machineState.regs[Registers::PC];
-    disassembler_ = disassemblersPerCpu_[machineState.activeCpu];
+    cpu_ = machineState.activeCpu;
+    disassembler_ = disassemblersPerCpu_[cpu_];
+    formatter_.setDisassembler(disassembler_);
     updateDisassembly();
     onBreakpointsChanged(breakpoints);
+    onCoverageChanged(controller_->coverage());
     enableControls(true);
 }
 
 void DisassemblyContent::onDisconnected() {
+    selectionAnchor_.reset();
+    emit selectionCleared();
     addressToBreakpoint_.clear();
-    addressToLine_.clear();
-    lines_.resize(0);
+    lines_.clear();
+    boundaries_.clear();
+    formatter_.clear();
+    controller_->setVisibleMemory(this, {});
     enableControls(false);
 }
 
@@ -396,8 +540,18 @@ void DisassemblyContent::onExecutionResumed() {
 
 void DisassemblyContent::onExecutionPaused(const MachineState& machineState) {
     qDebug() << "DisassemblyWidget::onExecutionPaused called";
+    TraceScope trace("slot disassembly");
     memory_ = machineState.memory.at(machineState.cpuBankId);
+    bankId_ = machineState.cpuBankId;
     pc_ = machineState.regs[Registers::PC];
+    // The machine may have changed any memory while it ran.
+    const std::vector<std::uint8_t>& bytes = memory_.bytes();
+    for (int page = 0; page < MemoryImage::kMaxPages; page++) {
+        if (memory_.isPagePresent(page)) {
+            std::uint16_t addr = page * MemoryImage::kPageSize;
+            updateBoundaries(bankId_, addr, std::span(bytes).subspan(addr, MemoryImage::kPageSize));
+        }
+    }
     updateDisassembly();
     update();
     enableControls(true);
@@ -413,34 +567,139 @@ void DisassemblyContent::onBreakpointsChanged(const Breakpoints& breakpoints) {
     update();
 }
 
+void DisassemblyContent::onCoverageChanged(const Coverage& coverage) {
+    const CoverageMap* map = coverage.bank(bankId_);
+    coverage_ = map != nullptr ? *map : CoverageMap();
+    update();
+}
+
 void DisassemblyContent::onRegistersChanged(const Registers& registers) {
-    highlightLine(addressToLine_[registers[Registers::PC]]);
+    goTo(registers[Registers::PC]);
+}
+
+void DisassemblyContent::onSymTabChanged() {
+    formatter_.clear();
+    updateDisassembly();
+    update();
 }
 
 void DisassemblyContent::onCpuChanged(Cpu cpu) {
     qDebug() << "DisassemblyWidget::onCpuChanged called";
+    cpu_ = cpu;
     disassembler_ = disassemblersPerCpu_[cpu];
+    formatter_.setDisassembler(disassembler_);
     updateDisassembly();
     update();
 }
 
-void DisassemblyContent::updateDisassembly() {    
-    auto before = disassembler_->disassembleBackward(pc_, memory_, 65636, {});
-    auto after = disassembler_->disassembleForward(pc_, memory_, 65636);
+void DisassemblyContent::updateDisassembly() {
+    rebuildDisassembly(pc_);
+    goTo(pc_);
+    reportVisibleMemory();
+}
+
+void DisassemblyContent::rebuildDisassembly(std::uint16_t anchor) {
+    int visibleLines = scrollArea_->viewport()->height() / lineH_ + 1;
+    lines_ = disassembler_->decodeBackward(anchor, memory_.bytes(), kWindowMargin, &boundaries());
+    Disassembler::Instructions after = disassembler_->decodeForward(anchor, memory_.bytes(), visibleLines + kWindowMargin);
+    learnBoundaries(after);
+    lines_.insert(lines_.size(), after);
+    highlightedLine_ = -1;
 
-    lines_.clear();
-    addressToLine_.clear();
-    lines_.reserve( before.size() + after.size() ); // preallocate memory
-    lines_.insert( lines_.end(), before.begin(), before.end() );
-    lines_.insert( lines_.end(), after.begin(), after.end() );
-    for (int i = 0; i < lines_.size(); i++) {
-        addressToLine_[lines_[i].addr] = i;
+    this->setMinimumHeight(lines_.size() * lineH_);
+    this->setMaximumHeight(lines_.size() * lineH_);
+    reportSelection();
+}
+
+void DisassemblyContent::extendWindow() {
+    if (lines_.empty() || extendingWindow_) {
+        return;
+    }
+    QScrollBar* scrollBar = scrollArea_->verticalScrollBar();
+    int top = scrollBar->value();
+    int firstLine = top / lineH_;
+    int lastLine = (top + scrollArea_->viewport()->height()) / lineH_;
+    int next = lines_.end(lines_.size() - 1);
+
+    int shift = 0; // Lines added before the first visible one, negative if lines were dropped
+    if (firstLine < kExtendThreshold && lines_.addr.front() > 0) {
+        Disassembler::Instructions before = disassembler_->decodeBackward(lines_.addr.front(), memory_.bytes(), kWindowMargin, &boundaries());
+        if (before.empty()) {
+            return;
+        }
+        lines_.insert(0, before);
+        shift = before.size();
+        if (lines_.size() > kMaxWindowLines) {
+            lines_.erase(kMaxWindowLines, lines_.size());
+        }
+    } else if (lastLine >= (int)lines_.size() - kExtendThreshold && next <= 0xffff) {
+        Disassembler::Instructions after = disassembler_->decodeForward(next, memory_.bytes(), kWindowMargin);
+        if (after.empty()) {
+            return;
+        }
+        learnBoundaries(after);
+        lines_.insert(lines_.size(), after);
+        if (lines_.size() > kMaxWindowLines) {
+            int dropped = lines_.size() - kMaxWindowLines;
+            lines_.erase(0, dropped);
+            shift = -dropped;
+        }
+    } else {
+        return;
+    }
+    if (highlightedLine_ >= 0) {
+        highlightedLine_ += shift;
+        if (highlightedLine_ < 0 || highlightedLine_ >= lines_.size()) {
+            highlightedLine_ = -1;
+        }
     }
 
+    // Keep the visible lines where they are.
+    extendingWindow_ = true;
     this->setMinimumHeight(lines_.size() * lineH_);
     this->setMaximumHeight(lines_.size() * lineH_);
+    scrollBar->setValue(top + shift * lineH_);
+    extendingWindow_ = false;
+    reportSelection();
+    update();
+}
 
-    goTo(pc_);
+InstructionBoundaryMap& DisassemblyContent::boundaries() {
+    return boundaries_[{bankId_, cpu_}];
+}
+
+void DisassemblyContent::learnBoundaries(const Disassembler::Instructions& instrs) {
+    InstructionBoundaryMap& map = boundaries();
+    std::span<const std::uint8_t> bytes(memory_.bytes());
+    for (int i = 0; i < instrs.size(); i++) {
+        if (instrs.opcode[i] != Disassembler::kUndecoded && instrs.end(i) <= (int)bytes.size()) {
+            map.mark(instrs.addr[i], bytes.subspan(instrs.addr[i], instrs.length[i]));
+        }
+    }
+}
+
+void DisassemblyContent::updateBoundaries(std::uint16_t bankId, std::uint16_t addr, std::span<const std::uint8_t> data) {
+    for (auto& [key, map] : boundaries_) {
+        if (key.first == bankId) {
+            map.update(addr, data);
+        }
+    }
+}
+
+void DisassemblyContent::onScrolled() {
+    extendWindow();
+    reportVisibleMemory();
+}
+
+void DisassemblyContent::reportVisibleMemory() {
+    if (lines_.empty()) {
+        return;
+    }
+    int top = scrollArea_->verticalScrollBar()->value();
+    int firstLine = std::clamp(top / lineH_, 0, (int)lines_.size() - 1);
+    int lastLine = std::clamp((top + scrollArea_->viewport()->height()) / lineH_, 0, (int)lines_.size() - 1);
+    int end = std::min(lines_.end(lastLine) - 1, 0xffff);
+    controller_->setVisibleMemory(this, {MemoryRange{bankId_, lines_.addr[firstLine], (std::uint16_t)end}});
 }
 
 void DisassemblyContent::highlightLine(int line) {
@@ -453,23 +712,45 @@ void DisassemblyContent::highlightLine(int line) {
 }
 
 void DisassemblyContent::goTo(std::uint16_t addr) {
-    auto it = addressToLine_.find(addr);
-    while (addr > 0 && it == addressToLine_.end()) {
-        addr--;
-        it = addressToLine_.find(addr);
+    if (disassembler_ == nullptr) {
+        // Not connected yet.
+        return;
+    }
+    if (lines_.empty() || addr < lines_.addr.front() || addr > lines_.addr.back()) {
+        rebuildDisassembly(addr);
+        if (lines_.empty()) {
+            return;
+        }
     }
-    auto l = it->second;
-    highlightLine(l);
+    highlightLine(lineAtOrBefore(addr));
 //    int y = l * lineH_ + ascent_;
 //    int x = scrollArea_->horizontalScrollBar()->value();
 //    scrollArea_->ensureVisible(x, y, 0, 50);
 }
 
 void DisassemblyContent::onMemoryChanged(std::uint16_t bankId, std::uint16_t addr, std::vector<std::uint8_t> data) {
-    for (auto b : data) {
-        memory_[addr++] = b;
+    updateBoundaries(bankId, addr, data);
+    if (bankId != bankId_) {
+        return;
     }
-    updateDisassembly();
+    memory_.write(addr, data);
+    if (lines_.empty()) {
+        return;
+    }
+    // Only the decoded window is shown, memory outside of it is decoded when the window is extended.
+    if (addr + (int)data.size() <= lines_.addr.front() || addr >= lines_.end(lines_.size() - 1)) {
+        return;
+    }
+
+    // Memory arrives while the user looks at it, so keep the scroll position
+    // instead of jumping back to PC.
+    int top = scrollArea_->verticalScrollBar()->value();
+    std::uint16_t topAddr = lines_.addr[std::clamp(top / lineH_, 0, (int)lines_.size() - 1)];
+    extendingWindow_ = true;
+    rebuildDisassembly(topAddr);
+    highlightedLine_ = lineOf(pc_).value_or(-1);
+    scrollArea_->verticalScrollBar()->setValue(lineAtOrBefore(topAddr) * lineH_ + top % lineH_);
+    extendingWindow_ = false;
     update();
 }
 
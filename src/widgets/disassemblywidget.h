@@ -20,6 +20,7 @@
 #pragma once
 
 #include <map>
+#include <span>
 
 #include <QScrollArea>
 #include <QLineEdit>
@@ -64,6 +65,7 @@ private:
     QPushButton* goToAddressBtn_;
     QLabel* cpuLabel_;
     QComboBox* cpuCombo_;
+    QLabel* cyclesLabel_;
 };
 
 class DisassemblyContent : public QWidget {
@@ -82,9 +84,15 @@ public:
 
     void updateDisassembly();
 
+signals:
+    // Cycles of the selected lines, or of the basic block around a single selected line.
+    void cyclesSelected(const Disassembler::CycleTotals& totals, bool basicBlock);
+    void selectionCleared();
+
 protected:
     QSize sizeHint() const override;
     void mousePressEvent(QMouseEvent* event) override;
+    void mouseMoveEvent(QMouseEvent* event) override;
     void mouseReleaseEvent(QMouseEvent* event) override;
     void paintEvent(QPaintEvent* event) override;
 //    void resizeEvent(QResizeEvent* event) override;
@@ -99,19 +107,46 @@ public slots:
     void onRegistersChanged(const Registers& registers);
     void onMemoryChanged(std::uint16_t bankId, std::uint16_t addr, std::vector<std::uint8_t> data);
     void onCpuChanged(Cpu cpu);
+    void onCoverageChanged(const Coverage& coverage);
+    void onSymTabChanged();
 
 private:
     void paintLine(QPainter& painter, const QRect& updateRect, int line);
+    std::optional<int> lineOf(std::uint16_t addr) const;
+    // The line of the instruction addr is in, or the first one if addr is before the window.
+    int lineAtOrBefore(std::uint16_t addr) const;
+    int lineAt(QPointF pos) const;
+    // First and last line of the selection, or of the basic block around a single selected line.
+    std::optional<std::pair<int, int>> selectedLines() const;
+    void selectLines(int anchor, int end);
+    void reportSelection();
+    // Disassembles a new window of lines around anchor.
+    void rebuildDisassembly(std::uint16_t anchor);
+    // Adds lines to the window when the view is close to one of its ends.
+    void extendWindow();
+    void onScrolled();
+    void reportVisibleMemory();
+    // The instruction boundaries of the shown bank and CPU.
+    InstructionBoundaryMap& boundaries();
+    void learnBoundaries(const Disassembler::Instructions& instrs);
+    // Forgets the instructions of all CPUs in the bank whose bytes differ from data.
+    void updateBoundaries(std::uint16_t bankId, std::uint16_t addr, std::span<const std::uint8_t> data);
 
     void enableControls(bool enable);
 
     Controller* controller_;
-    std::vector<Disassembler::Line> lines_;
+    Disassembler::Instructions lines_; // The window around the visible lines, sorted by address
+    CachedFormatter formatter_; // Lines are only formatted when they are drawn
     std::map<std::uint16_t, Breakpoint> addressToBreakpoint_;
-    std::map<std::uint16_t, int> addressToLine_;
-    std::vector<std::uint8_t> memory_;
+    CoverageMap coverage_; // Of the shown bank
+    MemoryImage memory_;
+    std::uint16_t bankId_;
     std::uint16_t pc_;
+    Cpu cpu_;
     std::shared_ptr<Disassembler> disassembler_;
+    // Learned from the forward disassembly of every window, which always
+    // includes the PCs the machine stopped at. By bank and CPU.
+    std::map<std::pair<std::uint16_t, Cpu>, InstructionBoundaryMap> boundaries_;
 
     std::unordered_map<Cpu, std::shared_ptr<Disassembler>> disassemblersPerCpu_;
 
@@ -121,6 +156,12 @@ private:
 
     int highlightedLine_;
     bool mouseDown_;
+    bool selecting_;
+    bool extendingWindow_;
+
+    // By address, so that the selection survives rebuilding the lines.
+    std::optional<std::uint16_t> selectionAnchor_;
+    std::uint16_t selectionEnd_;
 
 
     // Widths of parts of the widget
@@ -131,6 +172,8 @@ private:
     int separatorW_; // Separator width between address and bytes, as well as bytes and text
     int addressW_; // Address part
     int hexW_;
+    int bytesW_; // Bytes part
+    int cyclesW_; // Cycles part
 };
 
 }
@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "widgets/latencywidget.h"
+
+#include <QFileDialog>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QMessageBox>
+#include <QPainter>
+#include <QSplitter>
+#include <QVBoxLayout>
+
+#include <algorithm>
+#include <fstream>
+
+namespace vicedebug {
+
+namespace {
+
+constexpr const int kRefreshIntervalMs = 500;
+
+QString formatNs(std::int64_t ns) {
+    return QString::asprintf("%.3f", ns / 1000000.0);
+}
+
+QString bucketLabel(std::size_t bucket) {
+    std::int64_t us = std::int64_t(1) << bucket;
+    if (us >= 1000000) {
+        return QString("%1s").arg(us / 1000000);
+    }
+    if (us >= 1000) {
+        return QString("%1ms").arg(us / 1000);
+    }
+    return QString("%1us").arg(us);
+}
+
+}
+
+HistogramView::HistogramView(QWidget* parent) : QWidget(parent) {
+    setMinimumHeight(120);
+    clear();
+}
+
+HistogramView::~HistogramView() {
+}
+
+void HistogramView::setStats(const PhaseStats& stats) {
+    stats_ = stats;
+    update();
+}
+
+void HistogramView::clear() {
+    stats_ = PhaseStats();
+    stats_.histogram.fill(0);
+    update();
+}
+
+void HistogramView::paintEvent(QPaintEvent* event) {
+    QPainter painter(this);
+    painter.fillRect(rect(), palette().base());
+
+    auto maxCount = *std::max_element(stats_.histogram.begin(), stats_.histogram.end());
+    if (maxCount == 0) {
+        painter.drawText(rect(), Qt::AlignCenter, tr("No samples"));
+        return;
+    }
+
+    int labelH = fontMetrics().height() + 4;
+    int barAreaH = height() - labelH;
+    int n = PhaseStats::kHistogramBuckets;
+    double barW = width() / (double)n;
+    for (int i = 0; i < n; i++) {
+        int x = (int)(i * barW);
+        int w = std::max(1, (int)((i + 1) * barW) - x - 1);
+        int h = (int)(barAreaH * (double)stats_.histogram[i] / maxCount);
+        painter.fillRect(x, barAreaH - h, w, h, palette().highlight());
+        if (i % 3 == 0) {
+            painter.drawText(QRect(x, barAreaH, (int)(3 * barW), labelH), Qt::AlignLeft | Qt::AlignVCenter, bucketLabel(i));
+        }
+    }
+}
+
+LatencyWidget::LatencyWidget(QWidget* parent) : QWidget(parent, Qt::Tool) {
+    setWindowTitle(tr("Latency"));
+
+    tree_ = new QTreeWidget();
+    tree_->setColumnCount(6);
+    tree_->setHeaderLabels({ "Phase", "Count", "Min (ms)", "Median (ms)", "P95 (ms)", "Max (ms)" });
+    tree_->setRootIsDecorated(false);
+    tree_->setSelectionBehavior(QAbstractItemView::SelectRows);
+    tree_->header()->setSectionResizeMode(0, QHeaderView::Stretch);
+    connect(tree_, &QTreeWidget::itemSelectionChanged, this, &LatencyWidget::onTreeItemSelectionChanged);
+
+    histogram_ = new HistogramView(this);
+
+    summary_ = new QLabel();
+
+    recordCheckBox_ = new QCheckBox(tr("Record"));
+    recordCheckBox_->setChecked(Tracer::instance().isEnabled());
+    connect(recordCheckBox_, &QCheckBox::toggled, this, &LatencyWidget::onRecordToggled);
+
+    clearBtn_ = new QPushButton(tr("Clear"));
+    connect(clearBtn_, &QPushButton::clicked, this, &LatencyWidget::onClearClicked);
+
+    exportBtn_ = new QPushButton(tr("Export..."));
+    exportBtn_->setToolTip(tr("Export as Chrome trace event JSON"));
+    connect(exportBtn_, &QPushButton::clicked, this, &LatencyWidget::onExportClicked);
+
+    QHBoxLayout* buttons = new QHBoxLayout();
+    buttons->addWidget(recordCheckBox_);
+    buttons->addWidget(summary_);
+    buttons->addStretch(10);
+    buttons->addWidget(clearBtn_);
+    buttons->addWidget(exportBtn_);
+
+    QSplitter* splitter = new QSplitter(Qt::Vertical);
+    splitter->addWidget(tree_);
+    splitter->addWidget(histogram_);
+
+    QVBoxLayout* layout = new QVBoxLayout();
+    layout->addWidget(splitter);
+    layout->addLayout(buttons);
+    setLayout(layout);
+
+    resize(600, 400);
+
+    refreshTimer_.setInterval(kRefreshIntervalMs);
+    connect(&refreshTimer_, &QTimer::timeout, this, &LatencyWidget::refresh);
+}
+
+LatencyWidget::~LatencyWidget() {
+}
+
+void LatencyWidget::showEvent(QShowEvent* event) {
+    refresh();
+    refreshTimer_.start();
+    QWidget::showEvent(event);
+}
+
+void LatencyWidget::hideEvent(QHideEvent* event) {
+    refreshTimer_.stop();
+    QWidget::hideEvent(event);
+}
+
+void LatencyWidget::refresh() {
+    Tracer& tracer = Tracer::instance();
+    auto events = tracer.snapshot();
+    stats_ = computePhaseStats(events);
+
+    // Keep the selection across refreshes.
+    QString selected;
+    auto selectedItems = tree_->selectedItems();
+    if (selectedItems.size() == 1) {
+        selected = selectedItems[0]->text(0);
+    }
+
+    tree_->blockSignals(true);
+    tree_->clear();
+    for (int i = 0; i < stats_.size(); i++) {
+        const PhaseStats& s = stats_[i];
+        QTreeWidgetItem* item = new QTreeWidgetItem();
+        item->setText(0, QString::fromStdString(s.name));
+        item->setText(1, QString::number(s.samplesNs.size()));
+        item->setText(2, formatNs(s.minNs()));
+        item->setText(3, formatNs(s.percentileNs(50)));
+        item->setText(4, formatNs(s.percentileNs(95)));
+        item->setText(5, formatNs(s.maxNs()));
+        for (int col = 1; col < 6; col++) {
+            item->setTextAlignment(col, Qt::AlignRight);
+        }
+        item->setData(0, Qt::UserRole, i);
+        tree_->addTopLevelItem(item);
+        if (item->text(0) == selected) {
+            item->setSelected(true);
+        }
+    }
+    tree_->blockSignals(false);
+    onTreeItemSelectionChanged();
+
+    summary_->setText(tr("%1 events, step %2").arg(tracer.recorded()).arg(tracer.currentStep()));
+}
+
+void LatencyWidget::onRecordToggled(bool checked) {
+    Tracer::instance().setEnabled(checked);
+}
+
+void LatencyWidget::onClearClicked() {
+    Tracer::instance().clear();
+    refresh();
+}
+
+void LatencyWidget::onExportClicked() {
+    auto fileName = QFileDialog::getSaveFileName(this,
+        tr("Export trace"), "vicedebug-trace.json", tr("Trace files (*.json);; All files (*.*)")).toStdString();
+    if (fileName.empty()) {
+        return;
+    }
+    std::ofstream out(fileName);
+    if (!out) {
+        QMessageBox::warning(this, tr("Export trace"), tr("Can't write %1").arg(QString::fromStdString(fileName)));
+        return;
+    }
+    writeChromeTrace(out, Tracer::instance().snapshot());
+}
+
+void LatencyWidget::onTreeItemSelectionChanged() {
+    auto selectedItems = tree_->selectedItems();
+    if (selectedItems.size() != 1) {
+        histogram_->clear();
+        return;
+    }
+    int idx = selectedItems[0]->data(0, Qt::UserRole).toInt();
+    histogram_->setStats(stats_[idx]);
+}
+
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QCheckBox>
+#include <QLabel>
+#include <QPushButton>
+#include <QTimer>
+#include <QTreeWidget>
+#include <QWidget>
+
+#include "tracing.h"
+
+namespace vicedebug {
+
+class HistogramView : public QWidget {
+    Q_OBJECT
+
+public:
+    HistogramView(QWidget* parent);
+    virtual ~HistogramView();
+
+    void setStats(const PhaseStats& stats);
+    void clear();
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+
+private:
+    PhaseStats stats_;
+};
+
+// Debug overlay that shows where the time between a step and the repaint
+// goes. Refreshes itself from the global Tracer while it is visible.
+class LatencyWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    LatencyWidget(QWidget* parent);
+    virtual ~LatencyWidget();
+
+protected:
+    void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
+
+private slots:
+    void refresh();
+    void onRecordToggled(bool checked);
+    void onClearClicked();
+    void onExportClicked();
+    void onTreeItemSelectionChanged();
+
+private:
+    QTreeWidget* tree_;
+    HistogramView* histogram_;
+    QLabel* summary_;
+    QCheckBox* recordCheckBox_;
+    QPushButton* clearBtn_;
+    QPushButton* exportBtn_;
+    QTimer refreshTimer_;
+
+    std::vector<PhaseStats> stats_;
+};
+
+}
@@ -19,9 +19,12 @@
 
 #include "widgets/memorywidget.h"
 
+#include "dialogs/filldialog.h"
+#include "memoryedittransaction.h"
 #include "resources.h"
 #include "tooltipgenerators.h"
 #include "petscii.h"
+#include "tracing.h"
 
 #include <QEvent>
 #include <QMouseEvent>
@@ -37,8 +40,12 @@
 #include <QMenu>
 #include <QGroupBox>
 #include <QPushButton>
+#include <QClipboard>
+#include <QGuiApplication>
+#include <QMessageBox>
 
 #include <iostream>
+#include <algorithm>
 
 namespace vicedebug {
 
@@ -58,6 +65,9 @@ const QColor kFgDisabled = QColor(Qt::lightGray).lighter(80);
 const QColor kFindResultFg = QColor(Qt::white);
 const QColor kFindResultBg = QColor(50,50,255);
 
+// Code coverage
+const QColor kCoveredBg = QColor(0,160,0,70);
+
 // Find
 const QColor kFindFound = Qt::black;
 const QColor kFindNotFound = QColor(255,50,50);
@@ -235,13 +245,14 @@ MemoryWidget::MemoryWidget(Controller* controller, QWidget* parent) :
     });
     scrollArea_->setWidgetResizable(true);
     scrollArea_->setWidget(content_);
+    connect(scrollArea_->verticalScrollBar(), &QScrollBar::valueChanged, content_, &MemoryContent::reportVisibleMemory);
 
     // Set up "toolbar"
     bankCombo_ = new QComboBox();
     connect(bankCombo_, &QComboBox::currentIndexChanged, [this](int index) {
         if (index < 0) {
             // No selection
-            content_->setMemory({{0,{}}}, Bank{0}, {}, {});
+            content_->setMemory({}, Bank{0}, {}, {});
             return;
         }
         selectedBank_ = banks_[index];
@@ -319,7 +330,7 @@ void MemoryWidget::onDisconnected() {
     memory_.clear();
     bankCombo_->clear();
     breakpoints_.clear();
-    content_->setMemory({{0,{}}}, Bank{0}, {}, {});
+    content_->setMemory({}, Bank{0}, {}, {});
     setEnabled(false);
 }
 
@@ -336,28 +347,34 @@ void MemoryWidget::onExecutionResumed() {
 }
 
 void MemoryWidget::onExecutionPaused(const MachineState& machineState) {
+    TraceScope trace("slot memory");
     memory_ = machineState.memory;
-    content_->setMemory(memory_, selectedBank_, breakpoints_, watches_); // So far, breakpoints are only supported for default bank...
+    if (content_->bankId() == selectedBank_.id) {
+        content_->updateMemory(memory_);
+    } else {
+        content_->setMemory(memory_, selectedBank_, breakpoints_, watches_); // So far, breakpoints are only supported for default bank...
+    }
     setEnabled(true);
     update();
 }
 
 void MemoryWidget::onMemoryChanged(std::uint16_t bankId, std::uint16_t addr, std::vector<std::uint8_t> data) {
-    std::vector<std::uint8_t>& mem = memory_.at(bankId);
-    for (auto b : data) {
-        mem[addr++] = b;
+    auto it = memory_.find(bankId);
+    if (it == memory_.end()) {
+        return;
     }
-    content_->setMemory(memory_, selectedBank_, breakpoints_, watches_); // So far, breakpoints are only supported for default bank...
+    it->second.write(addr, data);
+    content_->writeMemory(bankId, addr, data);
 }
 
 void MemoryWidget::onBreakpointsChanged(const Breakpoints& breakpoints) {
     breakpoints_ = breakpoints;
-    content_->setMemory(memory_, selectedBank_, breakpoints_, watches_); // So far, breakpoints are only supported for default bank...
+    content_->setMarks(breakpoints_, watches_); // So far, breakpoints are only supported for default bank...
 }
 
 void MemoryWidget::onWatchesChanged(const Watches& watches) {
     watches_ = watches;
-    content_->setMemory(memory_, selectedBank_, breakpoints_, watches_); // So far, breakpoints are only supported for default bank...
+    content_->setMarks(breakpoints_, watches_);
 }
 
 // ----------------------
@@ -365,7 +382,7 @@ void MemoryWidget::onWatchesChanged(const Watches& watches) {
 // ----------------------
 
 MemoryContent::MemoryContent(Controller* controller, QScrollArea* parent) :
-    QWidget(parent), controller_(controller), scrollArea_(parent)
+    QWidget(parent), controller_(controller), scrollArea_(parent), bank_(Bank{0})
 {
     setFocusPolicy(Qt::StrongFocus);
 
@@ -386,24 +403,59 @@ MemoryContent::MemoryContent(Controller* controller, QScrollArea* parent) :
     editActive_ = false;
     petsciiBase_ = PETSCII::kUCBase;
 
+    connect(controller_, &Controller::coverageChanged, this, &MemoryContent::onCoverageChanged);
+    coverage_ = controller_->coverage();
+
     updateSize(0);
 }
 
 MemoryContent::~MemoryContent() {
 }
 
-void MemoryContent::setMemory(const std::unordered_map<std::uint16_t, std::vector<std::uint8_t>>& memory, const Bank bank, const Breakpoints& breakpoints, const Watches& watches) {
+void MemoryContent::setMemory(const std::unordered_map<std::uint16_t, MemoryImage>& memory, const Bank bank, const Breakpoints& breakpoints, const Watches& watches) {
     bank_ = bank;
-    memory_ = memory.at(bank_.id);
+    auto it = memory.find(bank_.id);
+    memory_ = it != memory.end() ? it->second : MemoryImage(0);
+    setMarks(breakpoints, watches);
+    updateSize(memory_.size() / kBytesPerLine);
+    markSearchResult({.found=false});
+    reportVisibleMemory();
+    update();
+}
+
+void MemoryContent::updateMemory(const std::unordered_map<std::uint16_t, MemoryImage>& memory) {
+    auto it = memory.find(bank_.id);
+    memory_ = it != memory.end() ? it->second : MemoryImage(0);
+    if (breakpointTypes_.size() != memory_.size()) {
+        updateMarks();
+        updateSize(memory_.size() / kBytesPerLine);
+    }
+    markSearchResult({.found=false});
+    reportVisibleMemory();
+    update();
+}
+
+void MemoryContent::writeMemory(std::uint16_t bankId, std::uint16_t addr, const std::vector<std::uint8_t>& data) {
+    if (bankId != bank_.id || memory_.size() == 0) {
+        return;
+    }
+    memory_.write(addr, data);
+    update();
+}
+
+void MemoryContent::setMarks(const Breakpoints& breakpoints, const Watches& watches) {
     breakpoints_ = bank_.id == 0 ? breakpoints : Breakpoints();
     watches_ = filterByBank(watches, bank_.id);
-    breakpointTypes_.resize(memory_.size());
-    breakpoint_.resize(memory_.size());
-    watch_.resize(memory_.size());
-    for (int i = 0; i < memory_.size(); i++) {
-        breakpointTypes_[i] = 0;
-        breakpoint_[i] = nullptr;
-        watch_[i] = nullptr;
+    updateMarks();
+    update();
+}
+
+void MemoryContent::updateMarks() {
+    breakpointTypes_.assign(memory_.size(), 0);
+    breakpoint_.assign(memory_.size(), nullptr);
+    watch_.assign(memory_.size(), nullptr);
+    if (memory_.size() == 0) {
+        return;
     }
     for (const auto& bp : breakpoints_) {
         std::uint8_t op = bp.op & (Breakpoint::Type::READ | Breakpoint::Type::WRITE);
@@ -420,11 +472,26 @@ void MemoryContent::setMemory(const std::unordered_map<std::uint16_t, std::vecto
             watch_[addr] = &w;
         }
     }
-    updateSize(memory_.size() / kBytesPerLine);
-    markSearchResult({.found=false});
+}
+
+void MemoryContent::onCoverageChanged(const Coverage& coverage) {
+    coverage_ = coverage;
     update();
 }
 
+void MemoryContent::reportVisibleMemory() {
+    if (memory_.size() == 0) {
+        controller_->setVisibleMemory(this, {});
+        return;
+    }
+    int top = scrollArea_->verticalScrollBar()->value();
+    int firstLine = top / lineH_;
+    int lastLine = (top + scrollArea_->viewport()->height()) / lineH_;
+    int start = std::min(firstLine * kBytesPerLine, (int)memory_.size() - 1);
+    int end = std::min((lastLine + 1) * kBytesPerLine - 1, (int)memory_.size() - 1);
+    controller_->setVisibleMemory(this, {MemoryRange{bank_.id, (std::uint16_t)start, (std::uint16_t)end}});
+}
+
 bool MemoryContent::event(QEvent* event) {
     if (event->type() != QEvent::ToolTip) {
         return QWidget::event(event);
@@ -517,11 +584,42 @@ void MemoryContent::contextMenuEvent(QContextMenuEvent* event) {
     connect(submenu->addAction("Bytes"), &QAction::triggered, [addr, this] {
         controller_->createWatch(Watch::ViewType::BYTES, bank_.id, addr, 16); // Should we instead of a fixed length just show the dialog?
     });
+    menu.addSeparator();
+    connect(menu.addAction("Paste hex bytes"), &QAction::triggered, [addr, this] {
+        pasteHex(addr);
+    });
+    connect(menu.addAction("Fill..."), &QAction::triggered, [addr, this] {
+        fillRange(addr);
+    });
     menu.exec(event->globalPos());
     event->ignore();
 }
 
+void MemoryContent::pasteHex(std::uint16_t addr) {
+    auto data = parseHexBytes(QGuiApplication::clipboard()->text().toStdString());
+    if (!data.has_value() || data->empty()) {
+        QMessageBox::warning(this, "Paste hex bytes", "The clipboard doesn't contain hex bytes like \"a9 00 8d 20 d0\".");
+        return;
+    }
+    MemoryEditTransaction transaction;
+    transaction.write(addr, data.value());
+    // memory and view will be updated in onMemoryChanged();
+    controller_->writeMemory(bank_.id, transaction);
+}
+
+void MemoryContent::fillRange(std::uint16_t start) {
+    FillDialog dlg(start, this);
+    if (dlg.exec() != QDialog::DialogCode::Accepted) {
+        return;
+    }
+    MemoryEditTransaction transaction;
+    transaction.fill(dlg.start(), std::min<int>(dlg.end(), memory_.size() - 1), dlg.value());
+    // memory and view will be updated in onMemoryChanged();
+    controller_->writeMemory(bank_.id, transaction);
+}
+
 void MemoryContent::paintEvent(QPaintEvent* event) {
+    TraceScope trace("paint memory");
     QPainter painter(this);
 
     int firstLine = event->rect().top()/lineH_;
@@ -542,6 +640,7 @@ void MemoryContent::paintEvent(QPaintEvent* event) {
     painter.fillRect(event->rect(), bg);
 
     int memSize = memory_.size() > 0 ? memory_.size() : 0;
+    const CoverageMap* covered = coverage_.bank(bank_.id);
     QString sep("  ");
     const char* addrFormatString = memSize <= 0x10000 ? " %04X" : "%05X";
     for (int pos = firstLine * kBytesPerLine, y = firstLine*lineH_+ascent_; pos < (lastLine + 1) * kBytesPerLine; pos += kBytesPerLine, y += lineH_) {
@@ -560,7 +659,12 @@ void MemoryContent::paintEvent(QPaintEvent* event) {
             const Breakpoint* bp = breakpoint_[pos + i];
             const Watch* w = watch_[pos+i];
             bool inSearchResult = pos + i >= resultStart_ && pos + i < resultStart_+resultLen_;
-            if (pos + i < memSize) {
+            bool isCovered = covered != nullptr && pos + i <= 0xffff && covered->isCovered(pos + i);
+            if (pos + i < memSize && !memory_.isPresent(pos + i)) {
+                // Not fetched yet
+                hex = "-- ";
+                text = " ";
+            } else if (pos + i < memSize) {
                 std::uint8_t c = memory_[pos+i];
                 hex = QString::asprintf("%02X ", c);
                 text = PETSCII::isPrintable(c) ? QString(QChar(petsciiBase_ + PETSCII::toScreenCode(c))) : ".";
@@ -595,12 +699,20 @@ void MemoryContent::paintEvent(QPaintEvent* event) {
                 painter.setPen(kBg);
                 painter.setBackgroundMode(Qt::TransparentMode);
                 painter.setBrush(Qt::NoBrush);
+            } else if (isCovered) {
+                painter.setBrush(kCoveredBg);
+                painter.setPen(Qt::NoPen);
+                painter.drawRect(hexX, y - ascent_, hexSpaceW_ - hexCharW_, lineH_);
+                painter.drawRect(textX, y - ascent_, charW_, lineH_);
+                painter.setPen(fg);
+                painter.setBackgroundMode(Qt::TransparentMode);
+                painter.setBrush(Qt::NoBrush);
             }
             painter.setFont(Resources::robotoMonoFont());
             painter.drawText(hexX, y, hex);
             painter.setFont(Resources::c64Font());
             painter.drawText(textX , y, text);
-            if (bp || w || inSearchResult) {
+            if (bp || w || inSearchResult || isCovered) {
                 painter.setBackgroundMode(Qt::OpaqueMode);
                 painter.setPen(fg);
             }
@@ -766,6 +878,11 @@ void MemoryContent::keyPressEvent(QKeyEvent* event) {
     }
     event->accept();
 
+    if (event->matches(QKeySequence::Paste)) {
+        pasteHex(nibbleMode_ ? cursorPos_ / 2 : cursorPos_);
+        return;
+    }
+
     // Deal with cursor movement
     switch(event->key()) {
     case Qt::Key_Left:
@@ -113,7 +113,7 @@ private:
 
     Banks banks_;
     Bank selectedBank_;
-    std::unordered_map<std::uint16_t, std::vector<std::uint8_t>> memory_;
+    std::unordered_map<std::uint16_t, MemoryImage> memory_;
     Breakpoints breakpoints_;
     Watches watches_;
 };
@@ -127,11 +127,29 @@ public:
 
     FindResult find(const std::vector<std::uint8_t>& data, std::uint16_t pos, std::int8_t direction);
     void markSearchResult(const FindResult& res);
-    void setMemory(const std::unordered_map<std::uint16_t, std::vector<std::uint8_t>>& memory, const Bank bank, const Breakpoints& breakpoints, const Watches& watches);
+    void setMemory(const std::unordered_map<std::uint16_t, MemoryImage>& memory, const Bank bank, const Breakpoints& breakpoints, const Watches& watches);
+    // New contents for the shown bank, with the same breakpoints and watches.
+    void updateMemory(const std::unordered_map<std::uint16_t, MemoryImage>& memory);
+    // Writes a chunk of fetched memory, if it is in the shown bank.
+    void writeMemory(std::uint16_t bankId, std::uint16_t addr, const std::vector<std::uint8_t>& data);
+    void setMarks(const Breakpoints& breakpoints, const Watches& watches);
+
+    std::uint16_t bankId() const {
+        return bank_.id;
+    }
+    void reportVisibleMemory();
+
+    // Write hex bytes from the clipboard starting at addr.
+    void pasteHex(std::uint16_t addr);
+    // Asks for a range and a value, and fills the range with it.
+    void fillRange(std::uint16_t start);
 
 signals:
     void memoryChanged(std::uint16_t addr, std::uint8_t newVal);
 
+private slots:
+    void onCoverageChanged(const Coverage& coverage);
+
 protected:
     bool event(QEvent* event) override;
     void contextMenuEvent(QContextMenuEvent* event) override;
@@ -142,6 +160,8 @@ protected:
 
 private:
     void updateSize(int lines);
+    // Rebuilds the per-byte breakpoint and watch tables.
+    void updateMarks();
     bool addrAtPos(QPoint pos, std::uint16_t& addr, bool& nibbleMode, int& nibbleOfs);
     void moveCursorRight();
     void ensurePosVisible(std::uint16_t pos);
@@ -150,7 +170,7 @@ private:
     Controller* controller_;
     QScrollArea* scrollArea_;
 
-    std::vector<std::uint8_t> memory_;
+    MemoryImage memory_;
     std::vector<std::uint8_t> breakpointTypes_;
     std::vector<const Breakpoint*> breakpoint_;
     std::vector<const Watch*> watch_;
@@ -160,6 +180,7 @@ private:
     Breakpoints breakpoints_;
     Watches watches_;
     Bank bank_;
+    Coverage coverage_;
 
     // Search results highlights
     std::uint16_t resultStart_;
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "widgets/profilerwidget.h"
+
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QMessageBox>
+#include <QVBoxLayout>
+
+namespace vicedebug {
+
+namespace {
+
+enum Column {
+    kColRegion,
+    kColAddress,
+    kColHits,
+    kColDelta,
+};
+
+// Sorts the numeric columns by value instead of by text.
+class ProfileItem : public QTreeWidgetItem {
+public:
+    bool operator<(const QTreeWidgetItem& other) const override {
+        int column = treeWidget()->sortColumn();
+        if (column == kColRegion) {
+            return text(column) < other.text(column);
+        }
+        return data(column, Qt::UserRole).toULongLong() < other.data(column, Qt::UserRole).toULongLong();
+    }
+};
+
+// Profiling modes, in the order of the mode combo box. 0 is "routines".
+constexpr const int kBucketSizes[] = { 0, 256, 1024, 4096 };
+
+}
+
+ProfilerWidget::ProfilerWidget(Controller* controller, SymTable* symtab, QWidget* parent)
+    : QWidget(parent, Qt::Tool), controller_(controller), symtab_(symtab), connected_(controller->isConnected()), paused_(connected_)
+{
+    setWindowTitle(tr("Profiler"));
+
+    modeCombo_ = new QComboBox();
+    modeCombo_->addItem(tr("Routines (symbol table)"));
+    modeCombo_->addItem(tr("256 byte blocks"));
+    modeCombo_->addItem(tr("1K blocks"));
+    modeCombo_->addItem(tr("4K blocks"));
+
+    startStopBtn_ = new QPushButton(tr("Start"));
+    connect(startStopBtn_, &QPushButton::clicked, this, &ProfilerWidget::onStartStopClicked);
+
+    summary_ = new QLabel();
+
+    tree_ = new QTreeWidget();
+    tree_->setColumnCount(4);
+    tree_->setHeaderLabels({ "Routine", "Address", "Hits", "Delta" });
+    tree_->setRootIsDecorated(false);
+    tree_->setSelectionBehavior(QAbstractItemView::SelectRows);
+    tree_->header()->setSectionResizeMode(kColRegion, QHeaderView::Stretch);
+    tree_->setSortingEnabled(true);
+    tree_->sortByColumn(kColHits, Qt::DescendingOrder);
+
+    QHBoxLayout* controls = new QHBoxLayout();
+    controls->addWidget(modeCombo_);
+    controls->addWidget(startStopBtn_);
+    controls->addWidget(summary_, 1);
+
+    QVBoxLayout* layout = new QVBoxLayout();
+    layout->addLayout(controls);
+    layout->addWidget(tree_);
+    setLayout(layout);
+    resize(500, 400);
+
+    connect(controller_, &Controller::connected, this, &ProfilerWidget::onConnected);
+    connect(controller_, &Controller::disconnected, this, &ProfilerWidget::onDisconnected);
+    connect(controller_, &Controller::executionResumed, this, &ProfilerWidget::onExecutionResumed);
+    connect(controller_, &Controller::executionPaused, this, &ProfilerWidget::onExecutionPaused);
+    connect(controller_, &Controller::profileUpdated, this, &ProfilerWidget::onProfileUpdated);
+
+    enableControls();
+}
+
+ProfilerWidget::~ProfilerWidget() {
+}
+
+void ProfilerWidget::enableControls() {
+    // Checkpoints are only set and deleted while the machine is paused.
+    bool profiling = controller_->isProfiling();
+    startStopBtn_->setEnabled(connected_ && paused_);
+    startStopBtn_->setText(profiling ? tr("Stop") : tr("Start"));
+    modeCombo_->setEnabled(connected_ && paused_ && !profiling);
+}
+
+void ProfilerWidget::onConnected() {
+    connected_ = true;
+    paused_ = true;
+    enableControls();
+}
+
+void ProfilerWidget::onDisconnected() {
+    connected_ = false;
+    enableControls();
+}
+
+void ProfilerWidget::onExecutionResumed() {
+    paused_ = false;
+    enableControls();
+}
+
+void ProfilerWidget::onExecutionPaused() {
+    paused_ = true;
+    enableControls();
+}
+
+void ProfilerWidget::onStartStopClicked() {
+    if (controller_->isProfiling()) {
+        controller_->stopProfiler();
+        enableControls();
+        return;
+    }
+
+    int bucketSize = kBucketSizes[modeCombo_->currentIndex()];
+    std::vector<ProfileRegion> regions = bucketSize > 0 ? Profile::bucketRegions(bucketSize) : Profile::routineRegions(symtab_->elements());
+    if (regions.empty()) {
+        QMessageBox::information(this, tr("Profiler"), tr("The symbol table is empty. Load symbols, or profile address blocks instead."));
+        return;
+    }
+    tree_->clear();
+    summary_->setText(tr("Setting %1 checkpoints...").arg(regions.size()));
+    controller_->startProfiler(regions);
+    enableControls();
+}
+
+void ProfilerWidget::onProfileUpdated(const Profile& profile) {
+    const auto& entries = profile.entries();
+    if (tree_->topLevelItemCount() != entries.size()) {
+        tree_->clear();
+        for (int i = 0; i < entries.size(); i++) {
+            QTreeWidgetItem* item = new ProfileItem();
+            item->setText(kColRegion, QString::fromStdString(entries[i].region.name));
+            item->setText(kColAddress, QString::asprintf("%04x", entries[i].region.start));
+            item->setData(kColAddress, Qt::UserRole, entries[i].region.start);
+            item->setData(kColRegion, Qt::UserRole, i);
+            tree_->addTopLevelItem(item);
+        }
+    }
+    // Sorting is switched off while the items change, so that they don't move under the loop.
+    tree_->setSortingEnabled(false);
+    for (int i = 0; i < tree_->topLevelItemCount(); i++) {
+        QTreeWidgetItem* item = tree_->topLevelItem(i);
+        const ProfileEntry& e = entries[item->data(kColRegion, Qt::UserRole).toInt()];
+        item->setText(kColHits, QString::number(e.hits));
+        item->setData(kColHits, Qt::UserRole, (qulonglong)e.hits);
+        item->setText(kColDelta, e.delta > 0 ? "+" + QString::number(e.delta) : "");
+        item->setData(kColDelta, Qt::UserRole, (qulonglong)e.delta);
+    }
+    tree_->setSortingEnabled(true);
+    summary_->setText(tr("%1 checkpoints, %2 hits").arg(entries.size()).arg(profile.totalHits()));
+    enableControls();
+}
+
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include <QComboBox>
+#include <QLabel>
+#include <QPushButton>
+#include <QTreeWidget>
+#include <QWidget>
+
+#include "controller.h"
+#include "symtab.h"
+
+namespace vicedebug {
+
+// Hot spot table of the hit count profiler: per routine or address block,
+// the executions counted by VICE since the start, and since the last update.
+class ProfilerWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    ProfilerWidget(Controller* controller, SymTable* symtab, QWidget* parent);
+    virtual ~ProfilerWidget();
+
+private slots:
+    void onConnected();
+    void onDisconnected();
+    void onExecutionResumed();
+    void onExecutionPaused();
+    void onProfileUpdated(const Profile& profile);
+    void onStartStopClicked();
+
+private:
+    void enableControls();
+
+    Controller* controller_;
+    SymTable* symtab_;
+
+    QComboBox* modeCombo_;
+    QPushButton* startStopBtn_;
+    QLabel* summary_;
+    QTreeWidget* tree_;
+
+    bool connected_;
+    bool paused_;
+};
+
+}
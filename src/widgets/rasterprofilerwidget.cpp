@@ -0,0 +1,303 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "widgets/rasterprofilerwidget.h"
+
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QMessageBox>
+#include <QPainter>
+#include <QRegularExpression>
+#include <QVBoxLayout>
+
+#include <algorithm>
+#include <map>
+
+namespace vicedebug {
+
+namespace {
+
+enum Column {
+    kColRoutine,
+    kColEntry,
+    kColExit,
+    kColCalls,
+    kColMinMax,
+    kColAvgPerFrame,
+    kColMaxPerFrame,
+};
+
+// Sorts the numeric columns by value instead of by text.
+class RasterItem : public QTreeWidgetItem {
+public:
+    bool operator<(const QTreeWidgetItem& other) const override {
+        int column = treeWidget()->sortColumn();
+        if (column == kColRoutine) {
+            return text(column) < other.text(column);
+        }
+        return data(column, Qt::UserRole).toDouble() < other.data(column, Qt::UserRole).toDouble();
+    }
+};
+
+// Video standards, in the order of the geometry combo box.
+constexpr const RasterGeometry kGeometries[] = { kRasterPal, kRasterNtsc, kRasterOldNtsc };
+
+constexpr const int kRowH = 3;
+
+QColor kTimelineBg = QColor(Qt::white);
+QColor kOverrunFg = QColor(Qt::red);
+
+}
+
+RasterTimeline::RasterTimeline(QWidget* parent) : QWidget(parent) {
+}
+
+QColor RasterTimeline::routineColor(int routine) {
+    // Golden angle steps, so that neighbours differ.
+    return QColor::fromHsv((routine * 137) % 360, 160, 220);
+}
+
+void RasterTimeline::setProfile(const RasterProfile& profile) {
+    profile_ = profile;
+    update();
+}
+
+QSize RasterTimeline::sizeHint() const {
+    return QSize(400, 100 * kRowH);
+}
+
+void RasterTimeline::paintEvent(QPaintEvent* event) {
+    QPainter painter(this);
+    painter.fillRect(rect(), kTimelineBg);
+
+    const auto& frames = profile_.frames();
+    int rows = std::min((int)frames.size(), height() / kRowH);
+    double scale = (double)width() / profile_.geometry().frameCycles();
+    for (int row = 0; row < rows; row++) {
+        const RasterFrame& frame = frames[frames.size() - rows + row];
+        int y = row * kRowH;
+        for (const auto& span : frame.spans) {
+            int x0 = std::max(span.start, 0) * scale;
+            int x1 = (span.start + span.cycles) * scale;
+            painter.fillRect(x0, y, std::max(x1 - x0, 1), kRowH, routineColor(span.routine));
+            if (span.start < 0) {
+                // Started in the frame before.
+                painter.fillRect(0, y, 2, kRowH, kOverrunFg);
+            }
+        }
+    }
+}
+
+RasterProfilerWidget::RasterProfilerWidget(Controller* controller, SymTable* symtab, QWidget* parent)
+    : QWidget(parent, Qt::Tool), controller_(controller), symtab_(symtab), connected_(controller->isConnected()), paused_(connected_)
+{
+    setWindowTitle(tr("Raster profiler"));
+
+    routines_ = new QLineEdit();
+    routines_->setPlaceholderText(tr("irq, music, $1000-$1040"));
+    routines_->setToolTip(tr("Labels or hex addresses of the routines' entries, optionally followed by '-' and the exit. "
+                             "Without an exit, the first return after the entry is used."));
+
+    geometryCombo_ = new QComboBox();
+    geometryCombo_->addItem(tr("PAL"));
+    geometryCombo_->addItem(tr("NTSC"));
+    geometryCombo_->addItem(tr("Old NTSC"));
+
+    startStopBtn_ = new QPushButton(tr("Start"));
+    connect(startStopBtn_, &QPushButton::clicked, this, &RasterProfilerWidget::onStartStopClicked);
+
+    summary_ = new QLabel();
+
+    timeline_ = new RasterTimeline(this);
+    timeline_->setToolTip(tr("One row per frame, newest at the bottom"));
+
+    tree_ = new QTreeWidget();
+    tree_->setColumnCount(7);
+    tree_->setHeaderLabels({ "Routine", "Entry", "Exit", "Calls", "Cycles", "Avg/frame", "Max/frame" });
+    tree_->setRootIsDecorated(false);
+    tree_->setSelectionBehavior(QAbstractItemView::SelectRows);
+    tree_->header()->setSectionResizeMode(kColRoutine, QHeaderView::Stretch);
+    tree_->setSortingEnabled(true);
+    tree_->sortByColumn(kColMaxPerFrame, Qt::DescendingOrder);
+
+    QHBoxLayout* controls = new QHBoxLayout();
+    controls->addWidget(routines_, 1);
+    controls->addWidget(geometryCombo_);
+    controls->addWidget(startStopBtn_);
+
+    QVBoxLayout* layout = new QVBoxLayout();
+    layout->addLayout(controls);
+    layout->addWidget(summary_);
+    layout->addWidget(timeline_, 1);
+    layout->addWidget(tree_);
+    setLayout(layout);
+    resize(600, 500);
+
+    connect(controller_, &Controller::connected, this, &RasterProfilerWidget::onConnected);
+    connect(controller_, &Controller::disconnected, this, &RasterProfilerWidget::onDisconnected);
+    connect(controller_, &Controller::executionResumed, this, &RasterProfilerWidget::onExecutionResumed);
+    connect(controller_, &Controller::executionPaused, this, &RasterProfilerWidget::onExecutionPaused);
+    connect(controller_, &Controller::rasterProfileUpdated, this, &RasterProfilerWidget::onRasterProfileUpdated);
+
+    enableControls();
+}
+
+RasterProfilerWidget::~RasterProfilerWidget() {
+}
+
+void RasterProfilerWidget::enableControls() {
+    // Checkpoints are only set and deleted while the machine is paused.
+    bool profiling = controller_->isRasterProfiling();
+    startStopBtn_->setEnabled(connected_ && paused_);
+    startStopBtn_->setText(profiling ? tr("Stop") : tr("Start"));
+    routines_->setEnabled(connected_ && paused_ && !profiling);
+    geometryCombo_->setEnabled(connected_ && paused_ && !profiling);
+}
+
+void RasterProfilerWidget::onConnected() {
+    connected_ = true;
+    paused_ = true;
+    enableControls();
+}
+
+void RasterProfilerWidget::onDisconnected() {
+    connected_ = false;
+    enableControls();
+}
+
+void RasterProfilerWidget::onExecutionResumed() {
+    paused_ = false;
+    enableControls();
+}
+
+void RasterProfilerWidget::onExecutionPaused() {
+    paused_ = true;
+    enableControls();
+}
+
+std::optional<std::vector<RasterRoutine>> RasterProfilerWidget::parseRoutines(const QString& text, QString& error) const {
+    std::map<QString, std::uint16_t> labels;
+    for (const auto& [label, addr] : symtab_->elements()) {
+        labels[QString::fromStdString(label)] = addr;
+    }
+    auto parseAddress = [&labels](QString s, std::uint16_t& addr) {
+        auto it = labels.find(s);
+        if (it != labels.end()) {
+            addr = it->second;
+            return true;
+        }
+        if (s.startsWith('$')) {
+            s = s.mid(1);
+        }
+        bool ok;
+        uint res = s.toUInt(&ok, 16);
+        addr = res;
+        return ok && res <= 0xffff;
+    };
+
+    std::vector<RasterRoutine> routines;
+    for (const QString& item : text.split(QRegularExpression("[\\s,]+"), Qt::SkipEmptyParts)) {
+        // Labels may contain '-' themselves.
+        QStringList parts = labels.contains(item) ? QStringList{item} : item.split('-');
+        RasterRoutine routine;
+        routine.name = parts[0].toStdString();
+        if (parts.size() > 2 || !parseAddress(parts[0], routine.entry)) {
+            error = tr("Unknown routine '%1'").arg(item);
+            return std::nullopt;
+        }
+        if (parts.size() == 2) {
+            std::uint16_t exit;
+            if (!parseAddress(parts[1], exit)) {
+                error = tr("Unknown exit '%1'").arg(parts[1]);
+                return std::nullopt;
+            }
+            routine.exit = exit;
+        }
+        routines.push_back(routine);
+    }
+    if (routines.empty()) {
+        error = tr("Enter the routines to profile.");
+        return std::nullopt;
+    }
+    return routines;
+}
+
+void RasterProfilerWidget::onStartStopClicked() {
+    if (controller_->isRasterProfiling()) {
+        controller_->stopRasterProfiler();
+        enableControls();
+        return;
+    }
+
+    if (!controller_->hasRasterRegisters()) {
+        QMessageBox::information(this, tr("Raster profiler"), tr("VICE does not report the raster line and cycle for this machine."));
+        return;
+    }
+    QString error;
+    auto routines = parseRoutines(routines_->text(), error);
+    if (!routines.has_value()) {
+        QMessageBox::information(this, tr("Raster profiler"), error);
+        return;
+    }
+    tree_->clear();
+    summary_->setText(tr("Setting checkpoints for %1 routines...").arg(routines->size()));
+    controller_->startRasterProfiler(routines.value(), kGeometries[geometryCombo_->currentIndex()]);
+    enableControls();
+}
+
+void RasterProfilerWidget::onRasterProfileUpdated(const RasterProfile& profile) {
+    const auto& routines = profile.routines();
+    if (tree_->topLevelItemCount() != routines.size()) {
+        tree_->clear();
+        for (int i = 0; i < routines.size(); i++) {
+            QTreeWidgetItem* item = new RasterItem();
+            item->setText(kColRoutine, QString::fromStdString(routines[i].name));
+            item->setData(kColRoutine, Qt::DecorationRole, RasterTimeline::routineColor(i));
+            item->setData(kColRoutine, Qt::UserRole + 1, i);
+            item->setText(kColEntry, QString::asprintf("%04x", routines[i].entry));
+            item->setData(kColEntry, Qt::UserRole, routines[i].entry);
+            item->setText(kColExit, QString::asprintf("%04x", routines[i].exit.value_or(0)));
+            item->setData(kColExit, Qt::UserRole, routines[i].exit.value_or(0));
+            tree_->addTopLevelItem(item);
+        }
+    }
+    int frameCycles = profile.geometry().frameCycles();
+    // Sorting is switched off while the items change, so that they don't move under the loop.
+    tree_->setSortingEnabled(false);
+    for (int i = 0; i < tree_->topLevelItemCount(); i++) {
+        QTreeWidgetItem* item = tree_->topLevelItem(i);
+        int routine = item->data(kColRoutine, Qt::UserRole + 1).toInt();
+        const RasterRoutineStats& stats = profile.stats(routine);
+        item->setText(kColCalls, QString::number(stats.calls));
+        item->setData(kColCalls, Qt::UserRole, (double)stats.calls);
+        item->setText(kColMinMax, stats.calls > 0 ? QString("%1-%2").arg(stats.minCycles).arg(stats.maxCycles) : "");
+        item->setData(kColMinMax, Qt::UserRole, stats.maxCycles);
+        double avg = profile.averageCyclesPerFrame(routine);
+        item->setText(kColAvgPerFrame, QString::asprintf("%.0f (%.1f%%)", avg, 100.0 * avg / frameCycles));
+        item->setData(kColAvgPerFrame, Qt::UserRole, avg);
+        item->setText(kColMaxPerFrame, QString::asprintf("%d (%.1f%%)", stats.maxCyclesPerFrame, 100.0 * stats.maxCyclesPerFrame / frameCycles));
+        item->setData(kColMaxPerFrame, Qt::UserRole, stats.maxCyclesPerFrame);
+    }
+    tree_->setSortingEnabled(true);
+    summary_->setText(tr("%1 frames, %2 cycles per frame").arg(profile.frameCount()).arg(frameCycles));
+    timeline_->setProfile(profile);
+    enableControls();
+}
+
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QComboBox>
+#include <QLabel>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QTreeWidget>
+#include <QWidget>
+
+#include "controller.h"
+#include "symtab.h"
+
+namespace vicedebug {
+
+// The recent frames of a raster profile, one row per frame from top to
+// bottom, newest last. The width of a row is the whole frame.
+class RasterTimeline : public QWidget {
+    Q_OBJECT
+
+public:
+    RasterTimeline(QWidget* parent);
+
+    void setProfile(const RasterProfile& profile);
+
+    static QColor routineColor(int routine);
+
+protected:
+    QSize sizeHint() const override;
+    void paintEvent(QPaintEvent* event) override;
+
+private:
+    RasterProfile profile_;
+};
+
+// Raster time per routine: the controller stops at the entries and exits of
+// the routines, and fetches just the registers to get the raster positions.
+class RasterProfilerWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    RasterProfilerWidget(Controller* controller, SymTable* symtab, QWidget* parent);
+    virtual ~RasterProfilerWidget();
+
+private slots:
+    void onConnected();
+    void onDisconnected();
+    void onExecutionResumed();
+    void onExecutionPaused();
+    void onRasterProfileUpdated(const RasterProfile& profile);
+    void onStartStopClicked();
+
+private:
+    void enableControls();
+    // Routines written like "irq, music $1000-$1040": labels or hex addresses,
+    // optionally followed by '-' and the exit. Empty, with error set, if text can't be parsed.
+    std::optional<std::vector<RasterRoutine>> parseRoutines(const QString& text, QString& error) const;
+
+    Controller* controller_;
+    SymTable* symtab_;
+
+    QLineEdit* routines_;
+    QComboBox* geometryCombo_;
+    QPushButton* startStopBtn_;
+    QLabel* summary_;
+    RasterTimeline* timeline_;
+    QTreeWidget* tree_;
+
+    bool connected_;
+    bool paused_;
+};
+
+}
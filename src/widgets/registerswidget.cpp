@@ -25,6 +25,7 @@
 #include <QSpacerItem>
 
 #include "resources.h"
+#include "tracing.h"
 
 namespace vicedebug {
 
@@ -379,6 +380,7 @@ void RegistersWidget::onExecutionResumed() {
 }
 
 void RegistersWidget::onExecutionPaused(const MachineState& machineState) {
+    TraceScope trace("slot registers");
     regs_ = machineState.regs;
     activeRegsGroup_ = regsGroupForCpu_[machineState.activeCpu];
     for(const auto& [key, g] : regsGroupForCpu_) {
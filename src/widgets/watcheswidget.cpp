@@ -20,12 +20,15 @@
 #include "widgets/watcheswidget.h"
 #include "dialogs/watchdialog.h"
 #include "resources.h"
+#include "tracing.h"
 
 #include <QGroupBox>
 #include <QHBoxLayout>
 #include <QVBoxLayout>
 #include <QSpacerItem>
 
+#include <algorithm>
+
 namespace vicedebug {
 
 WatchesWidget::WatchesWidget(Controller* controller, SymTable* symtab, QWidget* parent) :
@@ -119,16 +122,33 @@ void WatchesWidget::fillTreeItem(QTreeWidgetItem* item, const Watch& w, int idx)
     item->setText(0, bank.name.c_str());
     item->setText(1, QString::asprintf("%04x", w.addrStart));
     item->setText(2, w.viewTypeAsString());
-    item->setText(3, w.asString(memory_));
+    auto it = memory_.find(w.bankId);
+    int end = std::min(w.addrStart + std::max((int)w.size(), 1) - 1, 0xffff);
+    if (it != memory_.end() && it->second.isPresent(w.addrStart, end)) {
+        item->setText(3, w.asString(it->second.bytes()));
+    } else {
+        // Memory not fetched yet.
+        item->setText(3, "...");
+    }
     item->setFont(3, w.viewType == Watch::ViewType::CHARS ? Resources::c64Font() : Resources::robotoMonoFont());
     item->setData(0, Qt::UserRole, idx);
 }
 
+void WatchesWidget::reportVisibleMemory() {
+    std::vector<MemoryRange> ranges;
+    for (const auto& w : watches_) {
+        int end = std::min(w.addrStart + std::max((int)w.size(), 1) - 1, 0xffff);
+        ranges.push_back(MemoryRange{w.bankId, w.addrStart, (std::uint16_t)end});
+    }
+    controller_->setVisibleMemory(this, ranges);
+}
+
 void WatchesWidget::onConnected(const MachineState& machineState, const Banks& banks, const Breakpoints& breakpoints) {
     enableControls(true);
     memory_ = machineState.memory;
     banks_ = banks;
     updateTree();
+    reportVisibleMemory();
 }
 
 void WatchesWidget::onDisconnected() {
@@ -141,19 +161,30 @@ void WatchesWidget::onExecutionResumed() {
 }
 
 void WatchesWidget::onMemoryChanged(std::uint16_t bankId, std::uint16_t address, const std::vector<std::uint8_t>& data) {
-    std::vector<std::uint8_t>& mem = memory_.at(bankId);
-    for (auto b : data) {
-        mem[address++] = b;
+    auto it = memory_.find(bankId);
+    if (it == memory_.end()) {
+        return;
+    }
+    it->second.write(address, data);
+    // Only the watches on the chunk show something new.
+    int end = address + (int)data.size() - 1;
+    for (int i = 0; i < watches_.size() && i < tree_->topLevelItemCount(); i++) {
+        const Watch& w = watches_[i];
+        int watchEnd = w.addrStart + std::max((int)w.size(), 1) - 1;
+        if (w.bankId == bankId && w.addrStart <= end && watchEnd >= address) {
+            fillTreeItem(tree_->topLevelItem(i), w, i);
+        }
     }
-    updateTree();
 }
 
 void WatchesWidget::onWatchesChanged(const Watches& watches) {
     watches_ = watches;
     updateTree();
+    reportVisibleMemory();
 }
 
 void WatchesWidget::onExecutionPaused(const MachineState& machineState) {
+    TraceScope trace("slot watches");
     enableControls(true);
     memory_ = machineState.memory;
     updateTree();
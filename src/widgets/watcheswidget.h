@@ -57,13 +57,14 @@ private:
     void clearTree();
     void updateTree();
     void fillTreeItem(QTreeWidgetItem* item, const Watch& w, int idx);
+    void reportVisibleMemory();
 
     Bank bankById(std::uint32_t id);
 
     Controller* controller_;
 
     Watches watches_;
-    std::unordered_map<std::uint16_t, std::vector<std::uint8_t>> memory_;
+    std::unordered_map<std::uint16_t, MemoryImage> memory_;
     Banks banks_;
     SymTable *symtab_;
 
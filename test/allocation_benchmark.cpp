@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QTest>
+#include <QFuture>
+#include <QPromise>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include "bufferpool.h"
+#include "connectionworker.h"
+#include "machinestate.h"
+#include "responsesetters.h"
+
+// Counts heap allocations while enabled. Replacing the global operator new
+// only affects this test binary.
+
+namespace {
+
+constexpr const std::size_t kPayloadSize = 0x10000;
+
+std::atomic<bool> counting = false;
+std::atomic<std::size_t> allocations = 0;
+std::atomic<std::size_t> payloadSizedAllocations = 0;
+
+}
+
+void* operator new(std::size_t size) {
+    if (counting.load(std::memory_order_relaxed)) {
+        allocations++;
+        if (size >= kPayloadSize) {
+            payloadSizedAllocations++;
+        }
+    }
+    void* p = std::malloc(size == 0 ? 1 : size);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace vicedebug {
+
+namespace {
+
+struct AllocationCount {
+    std::size_t allocations;
+    std::size_t payloadSized;
+};
+
+class CountAllocations {
+public:
+    CountAllocations() {
+        allocations = 0;
+        payloadSizedAllocations = 0;
+        counting = true;
+    }
+
+    ~CountAllocations() {
+        counting = false;
+    }
+
+    AllocationCount count() const {
+        return AllocationCount{allocations.load(), payloadSizedAllocations.load()};
+    }
+};
+
+// Body of a MEM_GET response for a full bank.
+std::vector<std::uint8_t> memGetBody() {
+    std::vector<std::uint8_t> body = { 0x00, 0x00 }; // Length, ignored
+    for (std::size_t i = 0; i < kPayloadSize; i++) {
+        body.push_back(i * 7);
+    }
+    return body;
+}
+
+Response memGetHeader(std::uint32_t id) {
+    Response header;
+    header.errorCode = 0;
+    header.id = id;
+    header.responseType = RESPONSE_MEM_GET;
+    return header;
+}
+
+// What the connection worker and the controller do with a MEM_GET response.
+MemGetResponse roundTrip(const Response& header, std::span<const std::uint8_t> body) {
+    auto promise = new QPromise<MemGetResponse>();
+    auto future = promise->future();
+    ResponseSetter* setter = new ResponseSetterImpl<MemGetResponse>(promise);
+    setter->set(header, body);
+    delete setter;
+    return future.takeResult();
+}
+
+}
+
+class AllocationBenchmark: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testMemGetPayloadIsNotCopied() {
+        constexpr int kResponses = 100;
+        auto body = memGetBody();
+
+        // Warm up the pool.
+        BufferPool::instance().release(roundTrip(memGetHeader(0), body).memory);
+
+        AllocationCount c;
+        {
+            CountAllocations counter;
+            for (int i = 0; i < kResponses; i++) {
+                MemGetResponse r = roundTrip(memGetHeader(i), body);
+                QCOMPARE(r.memory.size(), kPayloadSize);
+                QCOMPARE(r.memory[0x1234], std::uint8_t(0x1234 * 7));
+                BufferPool::instance().release(std::move(r.memory));
+            }
+            c = counter.count();
+        }
+        qInfo() << "MEM_GET:" << double(c.allocations) / kResponses << "allocations per response,"
+                << c.payloadSized << "of payload size in" << kResponses << "responses";
+        QCOMPARE(c.payloadSized, std::size_t(0));
+    }
+
+    void testResultCopiesPayload() {
+        // QFuture::result() copies; this is why consumers use takeResult().
+        auto body = memGetBody();
+        auto promise = new QPromise<MemGetResponse>();
+        auto future = promise->future();
+        ResponseSetter* setter = new ResponseSetterImpl<MemGetResponse>(promise);
+        setter->set(memGetHeader(0), body);
+        delete setter;
+
+        AllocationCount c;
+        {
+            CountAllocations counter;
+            MemGetResponse r = future.result();
+            c = counter.count();
+        }
+        QCOMPARE(c.payloadSized, std::size_t(1));
+    }
+
+    void testMachineStateFanOutSharesMemory() {
+        // Every view keeps the state of the last stop, and applies later edits to it.
+        constexpr int kViews = 4;
+        MachineState state;
+        for (std::uint16_t bankId = 0; bankId < 3; bankId++) {
+            MemoryImage image;
+            image.write(0, std::vector<std::uint8_t>(kPayloadSize, bankId));
+            state.memory.emplace(bankId, image);
+        }
+
+        std::vector<MachineState> views;
+        views.reserve(kViews);
+        AllocationCount c;
+        {
+            CountAllocations counter;
+            for (int i = 0; i < kViews; i++) {
+                views.push_back(state);
+                views.back().memory.at(1).write(0x1234, { 0x42 });
+            }
+            c = counter.count();
+        }
+        qInfo() << "Fan-out to" << kViews << "views:" << c.allocations << "allocations,"
+                << c.payloadSized << "of bank size";
+        QCOMPARE(c.payloadSized, std::size_t(0));
+        QCOMPARE(state.memory.at(1)[0x1234], std::uint8_t(1));
+        QCOMPARE(views[0].memory.at(1)[0x1234], std::uint8_t(0x42));
+    }
+
+    void benchmarkMemGetRoundTrip() {
+        auto body = memGetBody();
+        QBENCHMARK {
+            BufferPool::instance().release(roundTrip(memGetHeader(0), body).memory);
+        }
+    }
+};
+
+}
+
+QTEST_MAIN(vicedebug::AllocationBenchmark)
+#include "allocation_benchmark.moc"
@@ -0,0 +1,297 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QTest>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "controllerfixture.h"
+
+namespace vicedebug {
+
+// Behavior of the Controller against a fake VICE.
+class ControllerTest: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testDisconnectWhileConnecting() {
+        ControllerFixture fixture(FakeViceServer::Options{.latencyMs = 20});
+        Controller& controller = fixture.controller();
+        int connected = 0;
+        QObject::connect(&controller, &Controller::connected, [&connected] {
+            connected++;
+        });
+
+        controller.connectToVice("127.0.0.1", fixture.server().port());
+        controller.disconnect();
+        QVERIFY(!controller.isConnected());
+
+        // The abandoned attempt must neither block the next one, nor
+        // report a connection of its own.
+        QVERIFY(fixture.connect());
+        QTest::qWait(200);
+        QCOMPARE(connected, 1);
+    }
+
+    // Steps requested faster than VICE executes them, like a held step key.
+    void testHeldStepsAreCoalesced() {
+        const int kSteps = 50;
+
+        ControllerFixture fixture;
+        Controller& controller = fixture.controller();
+        QVERIFY(fixture.connect());
+
+        int pausedCount = 0;
+        std::uint16_t pc = 0;
+        QObject::connect(&controller, &Controller::executionPaused, [&](const MachineState& state) {
+            pausedCount++;
+            pc = state.regs[Registers::PC];
+        });
+
+        for (int i = 0; i < kSteps; i++) {
+            controller.stepIn();
+        }
+        while (pc != (std::uint16_t)(fixture.startPc() + kSteps)) {
+            QVERIFY(waitForSignal(&controller, &Controller::executionPaused));
+        }
+
+        // The queued steps are coalesced, and the states in between are never fetched.
+        QVERIFY(pausedCount <= 2);
+    }
+
+    void testStepUntilStopsAfterMaxSteps() {
+        const int kMaxSteps = 100;
+
+        ControllerFixture fixture;
+        Controller& controller = fixture.controller();
+        QVERIFY(fixture.connect());
+
+        // Never true for the fake's memory pattern.
+        std::string error;
+        auto condition = StepCondition::parse("[$d020] == $00 && A == $ff", error);
+        QVERIFY(condition.has_value());
+
+        int steps = 0;
+        QObject::connect(&controller, &Controller::steppingFinished, [&steps](int n, double) { steps = n; });
+        controller.stepUntil(condition.value(), false, kMaxSteps);
+        QVERIFY(waitForSignal(&controller, &Controller::executionPaused));
+        QCOMPARE(steps, kMaxSteps);
+    }
+
+    void testFillRange_data() {
+        QTest::addColumn<int>("start");
+        QTest::addColumn<int>("end");
+        QTest::newRow("page") << 0x2000 << 0x20ff;
+        QTest::newRow("whole bank") << 0x0000 << 0xffff;
+    }
+
+    void testFillRange() {
+        QFETCH(int, start);
+        QFETCH(int, end);
+
+        ControllerFixture fixture;
+        Controller& controller = fixture.controller();
+        QVERIFY(fixture.connect());
+
+        std::vector<std::uint8_t> written;
+        QObject::connect(&controller, &Controller::memoryChanged, [&](std::uint16_t, std::uint16_t address, const std::vector<std::uint8_t>& data) {
+            if (address == start && data.size() == std::size_t(end - start + 1)) {
+                written = data;
+            }
+        });
+
+        // One MEM_SET, and one read back for the whole range.
+        MemoryEditTransaction transaction;
+        transaction.fill(start, end, 0xea);
+        controller.writeMemory(fixture.cpuBankId(), transaction);
+        while (written.empty()) {
+            QVERIFY(waitForSignal(&controller, &Controller::memoryChanged));
+        }
+        QCOMPARE(written[0x2000 - start], std::uint8_t(0xea));
+    }
+
+    void testConditionalBreakpoint() {
+        ControllerFixture fixture;
+        Controller& controller = fixture.controller();
+        QVERIFY(fixture.connect());
+
+        Breakpoints breakpoints;
+        QObject::connect(&controller, &Controller::breakpointsChanged, [&breakpoints](const Breakpoints& bps) {
+            breakpoints = bps;
+        });
+        std::string rejected;
+        QObject::connect(&controller, &Controller::breakpointConditionRejected, [&rejected](const std::string& condition) {
+            rejected = condition;
+        });
+
+        controller.createBreakpoint(Breakpoint::Type::EXEC, 0x1000, 0x1000, true, "A == $ff");
+        QVERIFY(waitForSignal(&controller, &Controller::breakpointsChanged));
+        QCOMPARE(breakpoints.size(), size_t(1));
+        QVERIFY(breakpoints[0].hasCondition);
+        QCOMPARE(breakpoints[0].condition, std::string("A == $ff"));
+
+        // A condition VICE can't parse must not leave a breakpoint that stops on every hit.
+        controller.createBreakpoint(Breakpoint::Type::EXEC, 0x2000, 0x2000, true, "A $ff");
+        QVERIFY(waitForSignal(&controller, &Controller::breakpointConditionRejected));
+        QCOMPARE(rejected, std::string("A $ff"));
+        QCOMPARE(breakpoints.size(), size_t(1));
+    }
+
+    void testTracepointContinues() {
+        const std::size_t kHits = 10;
+
+        // The fake runs straight into the tracepoint whenever it is resumed.
+        ControllerFixture fixture(FakeViceServer::Options{.runIntoCheckpoints = true});
+        Controller& controller = fixture.controller();
+        QVERIFY(fixture.connect());
+
+        std::string error;
+        controller.createBreakpoint(Breakpoint::Type::EXEC, 0xc010, 0xc010, true, {}, TraceSpec::parse("A X [$d020] [$fb-$fe]", error));
+        QVERIFY(waitForSignal(&controller, &Controller::breakpointsChanged));
+
+        int paused = 0;
+        QObject::connect(&controller, &Controller::executionPaused, [&paused] {
+            paused++;
+        });
+        std::uint32_t tracepoint = 0;
+        std::size_t hits = 0;
+        QObject::connect(&controller, &Controller::tracepointHit, [&](std::uint32_t number, std::size_t n, double) {
+            tracepoint = number;
+            hits = n;
+        });
+
+        controller.resumeExecution();
+        while (hits < kHits) {
+            QVERIFY(waitForSignal(&controller, &Controller::tracepointHit));
+        }
+
+        // Every hit continued on its own, with just the traced state fetched.
+        QCOMPARE(paused, 0);
+        const TraceLog* log = controller.traceLog(tracepoint);
+        QVERIFY(log != nullptr);
+        QVERIFY(log->size() >= kHits);
+        QCOMPARE(log->pc(0), std::uint16_t(0xc010));
+        QCOMPARE(log->memory(0)[0], std::uint8_t(0xf0)); // $d020 of the fake's memory pattern
+    }
+
+    void testProfiler() {
+        const int kSteps = 0x100;
+
+        ControllerFixture fixture;
+        Controller& controller = fixture.controller();
+        QVERIFY(fixture.connect());
+
+        Profile profile;
+        QObject::connect(&controller, &Controller::profileUpdated, [&profile](const Profile& p) {
+            profile = p;
+        });
+
+        controller.startProfiler(Profile::bucketRegions(0x100));
+        QVERIFY(waitForSignal(&controller, &Controller::profileUpdated));
+        QCOMPARE(profile.entries().size(), size_t(0x100));
+
+        // The fake's instructions are one byte NOPs, so stepping from $c000 hits every address of one bucket.
+        controller.stepN(kSteps, false);
+        QVERIFY(waitForSignal(&controller, &Controller::executionPaused));
+        QVERIFY(waitForSignal(&controller, &Controller::profileUpdated));
+        auto it = std::find_if(profile.entries().begin(), profile.entries().end(), [](const ProfileEntry& e) {
+            return e.region.start == 0xc000;
+        });
+        QVERIFY(it != profile.entries().end());
+        QCOMPARE(it->hits, std::uint64_t(kSteps));
+        QCOMPARE(profile.totalHits(), std::uint64_t(kSteps));
+
+        // While running, polls stop VICE for just one round trip.
+        int paused = 0;
+        QObject::connect(&controller, &Controller::executionPaused, [&paused] {
+            paused++;
+        });
+        controller.resumeExecution();
+        QVERIFY(waitForSignal(&controller, &Controller::profileUpdated));
+        QVERIFY(waitForSignal(&controller, &Controller::profileUpdated));
+        QCOMPARE(paused, 0);
+        QVERIFY(controller.isProfiling());
+
+        // Deleting the checkpoints stops VICE, but that stop is not shown either.
+        controller.stopProfiler();
+        QVERIFY(!controller.isProfiling());
+        QTest::qWait(200);
+        QCOMPARE(paused, 0);
+    }
+
+    void testCoverage() {
+        const int kSteps = 0x10;
+
+        ControllerFixture fixture;
+        Controller& controller = fixture.controller();
+        QVERIFY(fixture.connect());
+
+        controller.startCoverage(0xc000, 0xc0ff);
+        QVERIFY(waitForSignal(&controller, &Controller::coverageChanged));
+        std::size_t blocks = controller.uncoveredBlocks();
+        QVERIFY(blocks > 0);
+
+        // The fake counts a hit for every checkpoint the stepped addresses are in.
+        controller.stepN(kSteps, false);
+        QVERIFY(waitForSignal(&controller, &Controller::executionPaused));
+        QVERIFY(waitForSignal(&controller, &Controller::coverageChanged));
+        QCOMPARE(controller.coverage().banks().size(), size_t(1));
+        const CoverageMap& covered = controller.coverage().banks().begin()->second;
+        QVERIFY(covered.isCovered(0xc000));
+        QVERIFY(covered.isCovered(0xc000 + kSteps - 1));
+        QVERIFY(!covered.isCovered(0xc0ff));
+        QVERIFY(controller.uncoveredBlocks() < blocks);
+
+        controller.stopCoverage();
+        QVERIFY(waitForSignal(&controller, &Controller::coverageChanged));
+        QCOMPARE(controller.uncoveredBlocks(), size_t(0));
+    }
+
+    void testStopCoverageWhileRunning() {
+        ControllerFixture fixture;
+        Controller& controller = fixture.controller();
+        QVERIFY(fixture.connect());
+
+        controller.startCoverage(0xc000, 0xc0ff);
+        QVERIFY(waitForSignal(&controller, &Controller::coverageChanged));
+        controller.resumeExecution();
+        QVERIFY(waitForSignal(&controller, &Controller::executionResumed));
+
+        int paused = 0;
+        QObject::connect(&controller, &Controller::executionPaused, [&paused] {
+            paused++;
+        });
+
+        // The last poll and the deletes stop VICE, but it continues right away.
+        controller.stopCoverage();
+        QVERIFY(waitForSignal(&controller, &Controller::coverageChanged));
+        QTest::qWait(200);
+        QCOMPARE(controller.uncoveredBlocks(), size_t(0));
+        QCOMPARE(paused, 0);
+    }
+};
+
+}
+
+QTEST_MAIN(vicedebug::ControllerTest)
+
+#include "controller_test.moc"
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QEventLoop>
+#include <QThread>
+#include <QTimer>
+
+#include <cstdint>
+
+#include "fakeviceserver.h"
+#include "viceclient.h"
+#include "controller.h"
+
+namespace vicedebug {
+
+// Runs a FakeViceServer in its own thread, so that its latency simulation
+// doesn't interfere with the event loop of the test.
+class ServerThread {
+public:
+    explicit ServerThread(const FakeViceServer::Options& options) {
+        server_ = new FakeViceServer(options);
+        server_->moveToThread(&thread_);
+        QObject::connect(&thread_, &QThread::finished, server_, &QObject::deleteLater);
+        thread_.start();
+        QMetaObject::invokeMethod(server_, [this] {
+            server_->listen();
+            port_ = server_->port();
+        }, Qt::BlockingQueuedConnection);
+    }
+
+    ~ServerThread() {
+        thread_.quit();
+        thread_.wait();
+    }
+
+    quint16 port() const {
+        return port_;
+    }
+
+    void stop() {
+        QMetaObject::invokeMethod(server_, &FakeViceServer::stop, Qt::QueuedConnection);
+    }
+
+private:
+    QThread thread_;
+    FakeViceServer* server_;
+    quint16 port_ = 0;
+};
+
+template<typename Signal>
+bool waitForSignal(const typename QtPrivate::FunctionPointer<Signal>::Object* sender, Signal signal, int timeoutMs = 5000) {
+    QEventLoop loop;
+    QTimer timer;
+    bool fired = false;
+    QObject::connect(sender, signal, &loop, [&] {
+        fired = true;
+        loop.quit();
+    });
+    QObject::connect(&timer, &QTimer::timeout, &loop, &QEventLoop::quit);
+    timer.setSingleShot(true);
+    timer.start(timeoutMs);
+    loop.exec();
+    return fired;
+}
+
+inline bool connectController(Controller& controller, quint16 port) {
+    controller.connectToVice("127.0.0.1", port);
+    return waitForSignal(&controller, &Controller::connected) && controller.isConnected();
+}
+
+// A Controller talking to a fake VICE in its own thread. It remembers the
+// CPU bank and the PC it saw when it connected.
+class ControllerFixture {
+public:
+    explicit ControllerFixture(const FakeViceServer::Options& options = {})
+        : server_(options), client_(nullptr), controller_(&client_) {
+        QObject::connect(&controller_, &Controller::connected, [this](const MachineState& state, const Banks&, const Breakpoints&) {
+            cpuBankId_ = state.cpuBankId;
+            startPc_ = state.regs[Registers::PC];
+        });
+    }
+
+    ~ControllerFixture() {
+        controller_.disconnect();
+    }
+
+    bool connect() {
+        return connectController(controller_, server_.port());
+    }
+
+    ServerThread& server() {
+        return server_;
+    }
+
+    Controller& controller() {
+        return controller_;
+    }
+
+    std::uint16_t cpuBankId() const {
+        return cpuBankId_;
+    }
+
+    std::uint16_t startPc() const {
+        return startPc_;
+    }
+
+private:
+    ServerThread server_;
+    ViceClient client_;
+    Controller controller_;
+    std::uint16_t cpuBankId_ = 0;
+    std::uint16_t startPc_ = 0;
+};
+
+}
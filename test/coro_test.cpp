@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QTest>
+#include <QPromise>
+#include <QThread>
+#include <QTimer>
+
+#include <memory>
+#include <optional>
+
+#include "coro.h"
+
+namespace vicedebug {
+
+namespace {
+
+Task<int> twice(QFuture<int> future) {
+    std::optional<int> v = co_await future;
+    co_return v.has_value() ? v.value() * 2 : -1;
+}
+
+Task<> store(QFuture<int> future, int* result) {
+    *result = co_await twice(future);
+}
+
+Task<> storeThread(QFuture<int> future, QThread** thread) {
+    co_await future;
+    *thread = QThread::currentThread();
+}
+
+}
+
+class CoroTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void finishedFutureDoesNotSuspend() {
+        QPromise<int> promise;
+        promise.addResult(21);
+        promise.finish();
+
+        int result = 0;
+        spawn(this, store(promise.future(), &result));
+        QCOMPARE(result, 42);
+    }
+
+    void resumesWhenFutureFinishes() {
+        QPromise<int> promise;
+        promise.start();
+
+        int result = 0;
+        spawn(this, store(promise.future(), &result));
+        QCOMPARE(result, 0);
+
+        promise.addResult(21);
+        promise.finish();
+        QTRY_COMPARE(result, 42);
+    }
+
+    void resumesInAwaitingThread() {
+        auto promise = std::make_shared<QPromise<int>>();
+        promise->start();
+
+        QThread* resumedIn = nullptr;
+        spawn(this, storeThread(promise->future(), &resumedIn));
+
+        std::unique_ptr<QThread> worker(QThread::create([promise] {
+            promise->addResult(1);
+            promise->finish();
+        }));
+        worker->start();
+        worker->wait();
+
+        QTRY_VERIFY(resumedIn != nullptr);
+        QCOMPARE(resumedIn, QThread::currentThread());
+    }
+
+    void canceledFutureYieldsNothing() {
+        int result = 0;
+        {
+            QPromise<int> promise;
+            promise.start();
+            spawn(this, store(promise.future(), &result));
+            // Destroying an unfinished promise cancels its future.
+        }
+        QTRY_COMPARE(result, -1);
+    }
+
+    void neverResumesAfterContextIsDeleted() {
+        QPromise<int> promise;
+        promise.start();
+
+        int result = 0;
+        auto context = std::make_unique<QObject>();
+        spawn(context.get(), store(promise.future(), &result));
+        context.reset();
+
+        promise.addResult(21);
+        promise.finish();
+        QTest::qWait(50);
+        QCOMPARE(result, 0);
+    }
+};
+
+}
+
+QTEST_MAIN(vicedebug::CoroTest)
+#include "coro_test.moc"
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <QTest>
+
+#include <sstream>
+
+#include "coverage.h"
+
+namespace vicedebug {
+
+class CoverageTest: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testCodeBlocks() {
+        std::vector<std::uint8_t> memory(0x10000);
+        std::vector<std::uint8_t> code = {
+            0xa9, 0x00,       // $1000 LDA #$00
+            0x8d, 0x20, 0xd0, // $1002 STA $D020
+            0xd0, 0xf9,       // $1005 BNE $1000
+            0xe8,             // $1007 INX
+            0x60,             // $1008 RTS
+            0xea,             // $1009 NOP
+        };
+        std::copy(code.begin(), code.end(), memory.begin() + 0x1000);
+
+        auto blocks = Coverage::codeBlocks(Cpu::MOS6502, memory, 0x1000, 0x1009);
+        QCOMPARE(blocks.size(), size_t(3));
+        QCOMPARE(blocks[0].start, std::uint16_t(0x1000));
+        QCOMPARE(blocks[0].end, std::uint16_t(0x1006));
+        QCOMPARE(blocks[1].start, std::uint16_t(0x1007));
+        QCOMPARE(blocks[1].end, std::uint16_t(0x1008));
+        // The end of the range ends the last block.
+        QCOMPARE(blocks[2].start, std::uint16_t(0x1009));
+        QCOMPARE(blocks[2].end, std::uint16_t(0x1009));
+    }
+
+    void testCodeBlocksAtZero() {
+        std::vector<std::uint8_t> memory(0x10000, 0xea); // NOP
+        memory[0x0002] = 0x60; // RTS
+
+        auto blocks = Coverage::codeBlocks(Cpu::MOS6502, memory, 0x0000, 0x0005);
+        QCOMPARE(blocks.size(), size_t(2));
+        QCOMPARE(blocks[0].start, std::uint16_t(0x0000));
+        QCOMPARE(blocks[0].end, std::uint16_t(0x0002));
+        QCOMPARE(blocks[1].start, std::uint16_t(0x0003));
+        QCOMPARE(blocks[1].end, std::uint16_t(0x0005));
+    }
+
+    void testCodeBlocksAreCapped() {
+        // All RTS
+        std::vector<std::uint8_t> memory(0x10000, 0x60);
+        QCOMPARE(Coverage::codeBlocks(Cpu::MOS6502, memory, 0x0000, 0xffff).size(), Coverage::kMaxBlocks);
+    }
+
+    void testMark() {
+        Coverage coverage;
+        QVERIFY(coverage.bank(0) == nullptr);
+        coverage.mark(0, CodeBlock{0x103f, 0x1041});
+        const CoverageMap* map = coverage.bank(0);
+        QVERIFY(map != nullptr);
+        QVERIFY(!map->isCovered(0x103e));
+        QVERIFY(map->isCovered(0x103f));
+        QVERIFY(map->isCovered(0x1040));
+        QVERIFY(map->isCovered(0x1041));
+        QVERIFY(!map->isCovered(0x1042));
+        QCOMPARE(coverage.coveredBytes(), size_t(3));
+    }
+
+    void testMerge() {
+        Coverage run1;
+        run1.mark(0, CodeBlock{0x1000, 0x1003});
+        Coverage run2;
+        run2.mark(0, CodeBlock{0x1002, 0x1005});
+        run2.mark(1, CodeBlock{0xffff, 0xffff});
+
+        run1.merge(run2);
+        QCOMPARE(run1.coveredBytes(), size_t(7));
+        QVERIFY(run1.bank(1)->isCovered(0xffff));
+    }
+
+    void testWriteAndRead() {
+        Coverage coverage;
+        coverage.mark(0, CodeBlock{0x0000, 0x0002});
+        coverage.mark(3, CodeBlock{0xc000, 0xc0ff});
+
+        std::stringstream data;
+        coverage.write(data);
+        QCOMPARE(data.str().size(), size_t(8 + 2 + 2 * (2 + 0x2000)));
+        QCOMPARE(data.str().substr(0, 8), std::string("VDCOVER1"));
+        QCOMPARE((int)(std::uint8_t)data.str()[12], 0x07); // Addresses 0 to 2 of bank 0
+
+        std::string error;
+        auto read = Coverage::read(data, error);
+        QVERIFY(read.has_value());
+        QVERIFY(read->banks() == coverage.banks());
+    }
+
+    void testReadRejectsOtherFiles() {
+        std::string error;
+        std::stringstream notCoverage("VDTRACE1");
+        QVERIFY(!Coverage::read(notCoverage, error).has_value());
+        QVERIFY(!error.empty());
+
+        Coverage coverage;
+        coverage.mark(0, CodeBlock{0x1000, 0x1000});
+        std::stringstream data;
+        coverage.write(data);
+        std::stringstream truncated(data.str().substr(0, 100));
+        QVERIFY(!Coverage::read(truncated, error).has_value());
+    }
+};
+
+}
+
+QTEST_MAIN(vicedebug::CoverageTest)
+#include "coverage_test.moc"
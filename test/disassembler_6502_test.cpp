@@ -20,6 +20,7 @@
 #include <QTest>
 
 #include <vector>
+#include <memory>
 #include <algorithm>
 #include <cstdint>
 
@@ -194,6 +195,101 @@ private slots:
         verifyLine(lines[5], 0xf050, {0xC8            }, "INY");
     }
 
+    void testCycles6502() {
+        initMemory();
+        std::vector<vicedebug::Disassembler::Line> lines = disassembler_.disassembleForward(0xf000, memory_, 5);
+        // AND #$0F
+        QCOMPARE(lines[0].minCycles, 2);
+        QCOMPARE(lines[0].maxCycles, 2);
+        // BNE $F023: +1 if taken
+        QCOMPARE(lines[1].minCycles, 2);
+        QCOMPARE(lines[1].maxCycles, 3);
+        // JSR $E9C8
+        QCOMPARE(lines[2].minCycles, 6);
+        QCOMPARE(lines[2].maxCycles, 6);
+
+        lines = disassembler_.disassembleForward(0xf039, memory_, 1);
+        // STA ($B2),Y: no page crossing penalty for stores
+        QCOMPARE(lines[0].minCycles, 6);
+        QCOMPARE(lines[0].maxCycles, 6);
+
+        lines = disassembler_.disassembleForward(0xf069, memory_, 2);
+        // LDY $E84F,X and LDA $E84E,X: +1 if a page is crossed
+        QCOMPARE(lines[0].minCycles, 4);
+        QCOMPARE(lines[0].maxCycles, 5);
+        QCOMPARE(lines[1].minCycles, 4);
+        QCOMPARE(lines[1].maxCycles, 5);
+    }
+
+    void testBranchCrossingPage6502() {
+        // BNE $1FF2 at $2000 crosses a page if taken, BNE $2014 does not
+        std::vector<std::uint8_t> memory(0x10000);
+        memory[0x2000] = 0xD0;
+        memory[0x2001] = 0xF0;
+        memory[0x2002] = 0xD0;
+        memory[0x2003] = 0x10;
+        std::vector<vicedebug::Disassembler::Line> lines = disassembler_.disassembleForward(0x2000, memory, 2);
+        QVERIFY(lines[0].disassembly == "BNE $1FF2");
+        QCOMPARE(lines[0].maxCycles, 4);
+        QVERIFY(lines[1].disassembly == "BNE $2014");
+        QCOMPARE(lines[1].maxCycles, 3);
+    }
+
+    void testCycleTotals6502() {
+        initMemory();
+        std::vector<vicedebug::Disassembler::Line> lines = disassembler_.disassembleForward(0xf028, memory_, 12);
+        // LDA #$04, JSR $E919
+        Disassembler::CycleTotals totals = Disassembler::cycleTotals(lines, 0, 1);
+        QCOMPARE(totals.instructions, 2);
+        QCOMPARE(totals.minCycles, 8);
+        QCOMPARE(totals.maxCycles, 8);
+
+        // LDA #$BF, LDY $B9, CPY #$60, BEQ $F03C
+        auto block = disassembler_.basicBlock(lines, 3);
+        QCOMPARE(block.first, 2);
+        QCOMPARE(block.second, 5);
+        totals = Disassembler::cycleTotals(lines, block.first, block.second);
+        QCOMPARE(totals.instructions, 4);
+        QCOMPARE(totals.minCycles, 9);
+        QCOMPARE(totals.maxCycles, 10);
+
+        // LDY #$00 ... RTS
+        block = disassembler_.basicBlock(lines, 6);
+        QCOMPARE(block.first, 6);
+        QCOMPARE(block.second, 11);
+    }
+
+    void testDecodeForward6502() {
+        initMemory();
+        // AND #$0F, BNE $F023, JSR $E9C8
+        Disassembler::Instructions instrs = disassembler_.decodeForward(0xf000, memory_, 3);
+        QCOMPARE(instrs.size(), std::size_t(3));
+        QCOMPARE(instrs.end(1), 0xf004);
+        QCOMPARE(instrs.length[2], std::uint8_t(3));
+        QCOMPARE(instrs.operand[2], std::uint16_t(0xe9c8));
+        QVERIFY(disassembler_.format(instrs[1]) == "BNE $F023");
+        QVERIFY(!disassembler_.isControlTransfer(instrs[0]));
+        QVERIFY(disassembler_.isControlTransfer(instrs[1]));
+    }
+
+    void testCachedFormatter6502() {
+        initMemory();
+        auto disassembler = std::make_shared<Disassembler6502>(&symtab_);
+        CachedFormatter formatter;
+        formatter.setDisassembler(disassembler);
+        Disassembler::Instructions instrs = disassembler->decodeForward(0xf004, memory_, 1);
+        const std::string& text = formatter.format(instrs[0]);
+        QVERIFY(text == "JSR $E9C8");
+        QVERIFY(&formatter.format(instrs[0]) == &text);
+
+        // Labels are only used once the cache is cleared.
+        symtab_.set("print", 0xe9c8);
+        QVERIFY(formatter.format(instrs[0]) == "JSR $E9C8");
+        formatter.clear();
+        QVERIFY(formatter.format(instrs[0]) == "JSR print");
+        symtab_.remove("print");
+    }
+
     void testDisassembleBackward6502() {
         initMemory();
         std::vector<vicedebug::Disassembler::Line> lines = disassembler_.disassembleBackward(0xf017, memory_, 10, {});
@@ -219,6 +315,28 @@ private slots:
         verifyLine(lines[5], 0xf050, {0xC8            }, "INY");
     }
 
+    void testDisassembleBackwardWithBoundaries6502() {
+        // The code starts at $4001: LDA #$20, NOP, NOP, RTS
+        std::vector<std::uint8_t> memory(0x10000, 0xea);
+        std::vector<std::uint8_t> code = { 0xa2, 0xa9, 0x20, 0xea, 0xea, 0x60 };
+        std::copy(code.begin(), code.end(), memory.begin() + 0x4000);
+
+        // Without boundaries, the code seems to start before $4000.
+        std::vector<vicedebug::Disassembler::Line> lines = disassembler_.disassembleBackward(0x4005, memory, 3, nullptr);
+        QVERIFY(lines.size() == 3);
+        verifyLine(lines[2], 0x4002, {0x20, 0xEA, 0xEA}, "JSR $EAEA");
+
+        InstructionBoundaryMap boundaries;
+        for (const auto& line : disassembler_.disassembleForward(0x4001, memory, 4)) {
+            boundaries.mark(line.addr, line.bytes);
+        }
+        lines = disassembler_.disassembleBackward(0x4005, memory, 3, &boundaries);
+        QVERIFY(lines.size() == 3);
+        verifyLine(lines[0], 0x4001, {0xA9, 0x20}, "LDA #$20");
+        verifyLine(lines[1], 0x4003, {0xEA      }, "NOP");
+        verifyLine(lines[2], 0x4004, {0xEA      }, "NOP");
+    }
+
 
     void cleanupTestCase() {
     }
@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QTest>
+#include <QElapsedTimer>
+#include <QFile>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "disassembler_6502.h"
+#include "symtab.h"
+
+namespace vicedebug {
+
+namespace {
+
+const int kLines = 32;
+
+using InstructionLengths = std::array<int, 256>;
+
+InstructionLengths instructionLengths(Disassembler6502& disassembler) {
+    InstructionLengths res;
+    std::vector<std::uint8_t> memory(0x10000);
+    for (int opcode = 0; opcode < 256; opcode++) {
+        memory[0x1000] = opcode;
+        res[opcode] = disassembler.disassembleForward(0x1000, memory, 1)[0].bytes.size();
+    }
+    return res;
+}
+
+// The 6502 backward disassembly before the dynamic programming one: at every
+// line, the longest instruction that ends at pos and is preceded by two more
+// instructions.
+class GreedyBackward {
+public:
+    explicit GreedyBackward(const InstructionLengths& lengths) : lengths_(lengths) {}
+
+    std::vector<std::uint16_t> starts(std::uint16_t pos, const std::vector<std::uint8_t>& memory, int lines) const {
+        std::vector<std::uint16_t> res;
+        while (lines-- > 0 && 0 < pos) {
+            int len = 3;
+            while (len > 0 && !isValid(0, pos - len, memory, len)) {
+                len--;
+            }
+            pos -= std::max(len, 1);
+            res.push_back(pos);
+        }
+        std::reverse(res.begin(), res.end());
+        return res;
+    }
+
+private:
+    bool isValid(int depth, int pos, const std::vector<std::uint8_t>& memory, int len) const {
+        if (pos < 0 || pos + len >= memory.size() || lengths_[memory[pos]] != len) {
+            return false;
+        }
+        return depth >= 2
+                || isValid(depth + 1, pos - 3, memory, 3)
+                || isValid(depth + 1, pos - 2, memory, 2)
+                || isValid(depth + 1, pos - 1, memory, 1);
+    }
+
+    InstructionLengths lengths_;
+};
+
+// Returns the addresses of the lines before pos.
+using BackwardFunc = std::function<std::vector<std::uint16_t>(std::uint16_t pos, int lines)>;
+
+struct Quality {
+    double accuracy; // Share of the lines that start where an instruction starts
+    double stability; // Share of the one line scrolls that keep the lines that stay visible
+    double linesPerSec;
+};
+
+// Disassembles kLines lines backward from each of positions, which are
+// consecutive instructions.
+Quality measure(const BackwardFunc& backward, const std::vector<std::uint16_t>& positions, const std::vector<bool>& isStart) {
+    std::vector<std::vector<std::uint16_t>> results;
+    QElapsedTimer timer;
+    timer.start();
+    for (std::uint16_t pos : positions) {
+        results.push_back(backward(pos, kLines));
+    }
+    double secs = timer.nsecsElapsed() / 1e9;
+
+    int lines = 0;
+    int correct = 0;
+    int stable = 0;
+    for (int i = 0; i < results.size(); i++) {
+        for (std::uint16_t addr : results[i]) {
+            lines++;
+            correct += isStart[addr] ? 1 : 0;
+        }
+        if (i > 0 && results[i].size() == kLines && results[i - 1].size() == kLines
+                && std::equal(results[i].begin(), results[i].end() - 1, results[i - 1].begin() + 1)) {
+            stable++;
+        }
+    }
+    return Quality{double(correct) / lines, double(stable) / (results.size() - 1), lines / secs};
+}
+
+void report(const char* name, const Quality& greedy, const Quality& dp) {
+    qInfo() << name << "greedy:" << greedy.accuracy * 100 << "% accurate," << greedy.stability * 100 << "% stable,"
+            << greedy.linesPerSec << "lines/s";
+    qInfo() << name << "dynamic programming:" << dp.accuracy * 100 << "% accurate," << dp.stability * 100 << "% stable,"
+            << dp.linesPerSec << "lines/s";
+}
+
+// Random code of typical instructions in [start, end).
+std::vector<std::uint8_t> generateCode(const InstructionLengths& lengths, int start, int end, std::vector<std::uint16_t>& starts) {
+    static const std::uint8_t kOpcodes[] = {
+        0xa9, 0xa5, 0xad, 0xbd, 0xb9, 0xb1, 0x85, 0x8d, 0x9d, 0x99, 0x91, 0xa2, 0xa0, 0xa6, 0xa4, 0x86,
+        0x84, 0xe8, 0xc8, 0xca, 0x88, 0xaa, 0xa8, 0x8a, 0x98, 0x18, 0x38, 0x69, 0xe9, 0x29, 0x09, 0x49,
+        0xc9, 0xe0, 0xc0, 0xd0, 0xf0, 0x90, 0xb0, 0x10, 0x30, 0x20, 0x4c, 0x60, 0x48, 0x68, 0x0a, 0x4a,
+        0x2a, 0x6a, 0xe6, 0xc6, 0xee, 0xce, 0x24, 0x2c,
+    };
+    std::mt19937 rnd(6502);
+    std::vector<std::uint8_t> memory(0x10000);
+    int addr = start;
+    while (addr + 3 <= end) {
+        std::uint8_t opcode = kOpcodes[rnd() % std::size(kOpcodes)];
+        starts.push_back(addr);
+        memory[addr] = opcode;
+        for (int i = 1; i < lengths[opcode]; i++) {
+            memory[addr + i] = rnd();
+        }
+        addr += lengths[opcode];
+    }
+    return memory;
+}
+
+}
+
+// Compares the dynamic programming backward disassembly of the 6502 with the
+// greedy one it replaced. Results are reported with qInfo(). ROM images are
+// only measured if VICEDEBUG_ROM_DIR is the directory of VICE's C64 ROMs.
+class DisassemblerBenchmark: public QObject
+{
+    Q_OBJECT
+
+public:
+    DisassemblerBenchmark() : disassembler_(&symtab_), lengths_(instructionLengths(disassembler_)), greedy_(lengths_) {}
+
+private:
+    SymTable symtab_;
+    Disassembler6502 disassembler_;
+    InstructionLengths lengths_;
+    GreedyBackward greedy_;
+
+    BackwardFunc dp(const std::vector<std::uint8_t>& memory) {
+        return [this, &memory](std::uint16_t pos, int lines) {
+            std::vector<std::uint16_t> res;
+            for (const auto& line : disassembler_.disassembleBackward(pos, memory, lines, nullptr)) {
+                res.push_back(line.addr);
+            }
+            return res;
+        };
+    }
+
+    BackwardFunc greedy(const std::vector<std::uint8_t>& memory) {
+        // Decodes the lines as well, like the disassembler did.
+        return [this, &memory](std::uint16_t pos, int lines) {
+            std::vector<std::uint16_t> res = greedy_.starts(pos, memory, lines);
+            for (std::uint16_t start : res) {
+                disassembler_.disassembleForward(start, memory, 1);
+            }
+            return res;
+        };
+    }
+
+private slots:
+    void testGeneratedCode() {
+        std::vector<std::uint16_t> starts;
+        std::vector<std::uint8_t> memory = generateCode(lengths_, 0x1000, 0x9000, starts);
+        std::vector<bool> isStart(0x10000);
+        for (std::uint16_t start : starts) {
+            isStart[start] = true;
+        }
+        // Leave room for the lines and the look behind before the first position.
+        std::vector<std::uint16_t> positions(starts.begin() + 2 * kLines, starts.end());
+
+        Quality g = measure(greedy(memory), positions, isStart);
+        Quality d = measure(dp(memory), positions, isStart);
+        report("Generated code", g, d);
+        QVERIFY(d.accuracy >= g.accuracy);
+        QVERIFY(d.stability >= g.stability);
+    }
+
+    void testRomImages_data() {
+        QTest::addColumn<QString>("file");
+        QTest::addColumn<int>("addr");
+
+        QTest::newRow("BASIC") << "basic-901226-01.bin" << 0xa000;
+        QTest::newRow("KERNAL") << "kernal-901227-03.bin" << 0xe000;
+    }
+
+    void testRomImages() {
+        QFETCH(QString, file);
+        QFETCH(int, addr);
+
+        QString dir = qEnvironmentVariable("VICEDEBUG_ROM_DIR");
+        if (dir.isEmpty()) {
+            QSKIP("VICEDEBUG_ROM_DIR is not set");
+        }
+        QFile f(dir + "/" + file);
+        if (!f.open(QIODevice::ReadOnly)) {
+            QSKIP(qPrintable(file + " not found"));
+        }
+        QByteArray rom = f.readAll();
+        std::vector<std::uint8_t> memory(0x10000);
+        std::copy(rom.begin(), rom.end(), memory.begin() + addr);
+
+        // ROMs contain tables, so the instructions are the ones of the forward
+        // disassembly from the start of the ROM.
+        std::vector<std::uint16_t> starts;
+        for (const auto& line : disassembler_.disassembleForward(addr, memory, rom.size())) {
+            if (line.addr < addr || line.addr >= addr + rom.size()) {
+                break;
+            }
+            starts.push_back(line.addr);
+        }
+        std::vector<bool> isStart(0x10000);
+        for (std::uint16_t start : starts) {
+            isStart[start] = true;
+        }
+        std::vector<std::uint16_t> positions(starts.begin() + 2 * kLines, starts.end());
+
+        report(qPrintable(file), measure(greedy(memory), positions, isStart), measure(dp(memory), positions, isStart));
+    }
+
+    void benchmarkBackward() {
+        std::vector<std::uint16_t> starts;
+        std::vector<std::uint8_t> memory = generateCode(lengths_, 0x1000, 0x9000, starts);
+        QBENCHMARK {
+            disassembler_.disassembleBackward(0x8000, memory, 128, nullptr);
+        }
+    }
+
+    void benchmarkDecodeForward() {
+        std::vector<std::uint16_t> starts;
+        std::vector<std::uint8_t> memory = generateCode(lengths_, 0x1000, 0x9000, starts);
+        QBENCHMARK {
+            disassembler_.decodeForward(0x1000, memory, 256);
+        }
+    }
+
+    void benchmarkDisassembleForward() {
+        // Decodes and formats, which the disassembly view only does for the lines it draws.
+        std::vector<std::uint16_t> starts;
+        std::vector<std::uint8_t> memory = generateCode(lengths_, 0x1000, 0x9000, starts);
+        QBENCHMARK {
+            disassembler_.disassembleForward(0x1000, memory, 256);
+        }
+    }
+};
+
+}
+
+QTEST_MAIN(vicedebug::DisassemblerBenchmark)
+
+#include "disassembler_benchmark.moc"
@@ -5446,6 +5446,48 @@ private slots:
         verifyLine(999, lines[0], 0x07fc, { 0xFD,0xCB,0x23,0xFF }, "*SET 7, (IY+$23), A");
     }
 
+    void testCyclesZ80() {
+        struct Case {
+            std::vector<std::uint8_t> bytes;
+            std::string disassembly;
+            int minCycles;
+            int maxCycles;
+        };
+        std::vector<Case> cases = {
+            { { 0x00 }, "NOP", 4, 4 },
+            { { 0x01,0x02,0x03 }, "LD BC, #$0302", 10, 10 },
+            { { 0x10,0x11 }, "DJNZ $1013", 8, 13 },
+            { { 0xC0 }, "RET NZ", 5, 11 },
+            { { 0xCB,0x46 }, "BIT 0, (HL)", 12, 12 },
+            { { 0xDD,0x34,0x05 }, "INC (IX+$05)", 23, 23 },
+            { { 0xED,0xB0 }, "LDIR", 16, 21 },
+            { { 0xFD,0xCB,0x05,0x46 }, "BIT 0, (IY+$05)", 20, 20 },
+        };
+        for (const auto& c : cases) {
+            initMem(0x1000, c.bytes);
+            auto lines = disassembler_.disassembleForward(0x1000, memory_, 1);
+            QVERIFY(lines[0].disassembly == c.disassembly);
+            QCOMPARE(lines[0].minCycles, c.minCycles);
+            QCOMPARE(lines[0].maxCycles, c.maxCycles);
+        }
+    }
+
+    void testDecodeZ80() {
+        // RETN, JP (IX), SET 0, (IX+$05), CALL Z, $0200
+        initMem(0x1000, { 0xED,0x45, 0xDD,0xE9, 0xDD,0xCB,0x05,0xC6, 0xCC,0x00,0x02 });
+        Disassembler::Instructions instrs = disassembler_.decodeForward(0x1000, memory_, 4);
+        QCOMPARE(instrs.size(), std::size_t(4));
+        QCOMPARE(instrs.addr[2], std::uint16_t(0x1004));
+        QCOMPARE(instrs.length[2], std::uint8_t(4));
+        QCOMPARE(instrs.operand[3], std::uint16_t(0x0200));
+        QVERIFY(disassembler_.isControlTransfer(instrs[0]));
+        QVERIFY(disassembler_.isControlTransfer(instrs[1]));
+        QVERIFY(!disassembler_.isControlTransfer(instrs[2]));
+        QVERIFY(disassembler_.isControlTransfer(instrs[3]));
+        QVERIFY(disassembler_.format(instrs[2]) == "SET 0, (IX+$05)");
+        QVERIFY(disassembler_.format(instrs[3]) == "CALL Z, $0200");
+    }
+
     void TestDisassembleBackward() {
         /*
 
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+
+#include "fakeviceserver.h"
+
+// Standalone fake VICE binary monitor, for trying out vicedebug without an
+// emulator and for benchmarking it over slow connections.
+
+using vicedebug::FakeViceServer;
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("fakevice");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Fake VICE binary monitor");
+    parser.addHelpOption();
+    QCommandLineOption portOption("port", "Port to listen on.", "port", "6502");
+    QCommandLineOption imageOption("image", "Memory image to load. 64K files are loaded at 0, .prg files at their load address.", "file");
+    QCommandLineOption loadAddressOption("load-address", "Load address (hex) for images that are neither 64K nor .prg files.", "addr", "0");
+    QCommandLineOption machineOption("machine", "Machine to simulate: c64 or c128.", "machine", "c64");
+    QCommandLineOption latencyOption("latency", "Delay in ms before each response is sent.", "ms", "0");
+    QCommandLineOption bandwidthOption("bandwidth", "Bandwidth limit in bytes per second, 0 for unlimited.", "bytes", "0");
+    QCommandLineOption stopAfterOption("stop-after", "Stop execution this many ms after it was resumed, 0 to never stop.", "ms", "0");
+    parser.addOptions({ portOption, imageOption, loadAddressOption, machineOption, latencyOption, bandwidthOption, stopAfterOption });
+    parser.process(app);
+
+    FakeViceServer::Options options;
+    options.machine = parser.value(machineOption).toLower() == "c128" ? FakeViceServer::Machine::C128 : FakeViceServer::Machine::C64;
+    options.latencyMs = parser.value(latencyOption).toInt();
+    options.bytesPerSecond = parser.value(bandwidthOption).toULongLong();
+    options.stopAfterMs = parser.value(stopAfterOption).toInt();
+
+    FakeViceServer server(options);
+    if (parser.isSet(imageOption)) {
+        std::uint16_t loadAddress = parser.value(loadAddressOption).toUInt(nullptr, 16);
+        if (!server.loadImage(parser.value(imageOption), loadAddress)) {
+            qCritical() << "Can't load" << parser.value(imageOption);
+            return 1;
+        }
+    }
+
+    if (!server.listen(QHostAddress::Any, parser.value(portOption).toUShort())) {
+        qCritical() << "Can't listen on port" << parser.value(portOption);
+        return 1;
+    }
+    qInfo() << "Listening on port" << server.port();
+
+    return app.exec();
+}
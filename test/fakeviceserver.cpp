@@ -0,0 +1,473 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fakeviceserver.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QDebug>
+
+#include <algorithm>
+
+#include "protocol.h"
+
+namespace vicedebug {
+
+namespace {
+
+constexpr const std::size_t kRequestHeaderSize = kEncodedSize<RequestHeader>;
+
+constexpr const std::uint8_t kErrorInvalidCommand = 0x83;
+
+constexpr const std::uint8_t kCheckpointOpExec = 0x04;
+
+// 6502 register IDs, as used by VICE
+constexpr const std::uint8_t kRegA = 0;
+constexpr const std::uint8_t kRegX = 1;
+constexpr const std::uint8_t kRegY = 2;
+constexpr const std::uint8_t kRegPC = 3;
+constexpr const std::uint8_t kRegSP = 4;
+constexpr const std::uint8_t kRegFlags = 5;
+
+struct RegDesc {
+    std::uint8_t id;
+    std::uint8_t bits;
+    const char* name;
+};
+
+const std::vector<RegDesc> kRegisters = {
+    { kRegA, 8, "A" },
+    { kRegX, 8, "X" },
+    { kRegY, 8, "Y" },
+    { kRegPC, 16, "PC" },
+    { kRegSP, 8, "SP" },
+    { kRegFlags, 8, "FL" },
+};
+
+}
+
+FakeViceServer::FakeViceServer(const Options& options, QObject* parent)
+    : QObject(parent), options_(options), server_(this), client_(nullptr), writeTimer_(this), lastDueNs_(0),
+      nextCheckpointNumber_(1), running_(false), commandsReceived_(0)
+{
+    switch(options_.machine) {
+    case Machine::C64:
+        banks_ = { {0, "default"}, {1, "cpu"}, {2, "ram"}, {3, "rom"}, {4, "io"}, {5, "cart"} };
+        break;
+    case Machine::C128:
+        banks_ = { {0, "default"}, {1, "cpu"}, {2, "ram"}, {3, "rom"}, {4, "io"}, {5, "ram00"}, {6, "ram01"}, {7, "ram02"}, {8, "ram03"}, {9, "vdc"} };
+        break;
+    }
+
+    // Something recognizable instead of all zeroes
+    std::vector<std::uint8_t> pattern(0x10000);
+    for (int i = 0; i < pattern.size(); i++) {
+        pattern[i] = (i >> 8) ^ (i & 0xff);
+    }
+    for (const auto& b : banks_) {
+        memory_[b.first] = pattern;
+    }
+
+    registers_ = {
+        { kRegA, 0x00 },
+        { kRegX, 0x00 },
+        { kRegY, 0x00 },
+        { kRegPC, 0xc000 },
+        { kRegSP, 0xff },
+        { kRegFlags, 0x20 },
+    };
+
+    writeTimer_.setSingleShot(true);
+    writeTimer_.setTimerType(Qt::PreciseTimer);
+    connect(&writeTimer_, &QTimer::timeout, this, &FakeViceServer::writeDueFrames);
+    connect(&server_, &QTcpServer::newConnection, this, &FakeViceServer::onNewConnection);
+    clock_.start();
+}
+
+FakeViceServer::~FakeViceServer() {
+}
+
+bool FakeViceServer::listen(const QHostAddress& address, quint16 port) {
+    return server_.listen(address, port);
+}
+
+quint16 FakeViceServer::port() const {
+    return server_.serverPort();
+}
+
+void FakeViceServer::setMemory(std::uint16_t addr, const std::vector<std::uint8_t>& data) {
+    for (const auto& b : banks_) {
+        if (b.second == "default" || b.second == "cpu" || b.second == "ram") {
+            std::vector<std::uint8_t>& mem = memory_[b.first];
+            for (int i = 0; i < data.size() && addr + i < mem.size(); i++) {
+                mem[addr + i] = data[i];
+            }
+        }
+    }
+}
+
+bool FakeViceServer::loadImage(const QString& filename, std::uint16_t loadAddress) {
+    QFile f(filename);
+    if (!f.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QByteArray content = f.readAll();
+    std::vector<std::uint8_t> data(content.begin(), content.end());
+    if (data.size() == 0x10000) {
+        loadAddress = 0;
+    } else if (QFileInfo(filename).suffix().toLower() == "prg" && data.size() >= 2) {
+        loadAddress = data[1] << 8 | data[0];
+        data.erase(data.begin(), data.begin() + 2);
+    }
+    setMemory(loadAddress, data);
+    return true;
+}
+
+void FakeViceServer::onNewConnection() {
+    QTcpSocket* socket = server_.nextPendingConnection();
+    if (client_ != nullptr) {
+        // Like VICE, we only talk to one client at a time.
+        client_->disconnectFromHost();
+        client_->deleteLater();
+    }
+    client_ = socket;
+    in_.clear();
+    outQueue_.clear();
+    writeTimer_.stop();
+    connect(client_, &QTcpSocket::readyRead, this, &FakeViceServer::onReadyRead);
+}
+
+void FakeViceServer::onReadyRead() {
+    QTcpSocket* socket = qobject_cast<QTcpSocket*>(sender());
+    if (socket != client_) {
+        return;
+    }
+    in_.append(client_->readAll());
+    while (in_.size() >= (qsizetype)kRequestHeaderSize) {
+        std::span<const std::uint8_t> data((const std::uint8_t*)in_.constData(), in_.size());
+        RequestHeader header;
+        decode(data, header);
+        if (header.stx != kProtocolStx) {
+            qWarning() << "FakeViceServer: bad magic, dropping connection";
+            client_->disconnectFromHost();
+            in_.clear();
+            return;
+        }
+        if (data.size() < kRequestHeaderSize + header.bodyLength) {
+            break;
+        }
+        handleCommand(header.command, header.requestId, data.subspan(kRequestHeaderSize, header.bodyLength));
+        in_.remove(0, kRequestHeaderSize + header.bodyLength);
+    }
+}
+
+void FakeViceServer::handleCommand(std::uint8_t cmd, std::uint32_t id, std::span<const std::uint8_t> body) {
+    commandsReceived_++;
+    if (running_) {
+        // Just like VICE, any command stops the emulator.
+        running_ = false;
+        StoppedResponse stopped;
+        stopped.pc = registers_[kRegPC];
+        send(RESPONSE_STOPPED, kOobRequestId, encode(stopped));
+    }
+
+    switch(cmd) {
+    case CMD_MEM_GET: {
+        MemGetCommand c;
+        decode(body, c);
+        auto it = memory_.find(c.bankId);
+        if (it == memory_.end() || c.endAddress < c.startAddress) {
+            send(RESPONSE_MEM_GET, id, {}, 0x82);
+            return;
+        }
+        // Like VICE, the length wraps to 0 for all 64K.
+        MemGetResponseBody res;
+        res.memory = std::span<const std::uint8_t>(it->second).subspan(c.startAddress, c.endAddress - c.startAddress + 1);
+        res.length = (std::uint16_t)res.memory.size();
+        send(RESPONSE_MEM_GET, id, encode(res));
+        return;
+    }
+    case CMD_MEM_SET: {
+        MemSetCommand c;
+        decode(body, c);
+        auto it = memory_.find(c.bankId);
+        if (it != memory_.end()) {
+            for (int i = 0; i < c.data.size() && c.startAddress + i < it->second.size(); i++) {
+                it->second[c.startAddress + i] = c.data[i];
+            }
+        }
+        send(RESPONSE_MEM_SET, id, {});
+        return;
+    }
+    case CMD_REGISTERS_GET:
+        sendRegisters(id);
+        return;
+    case CMD_REGISTERS_SET: {
+        RegistersSetCommand c;
+        decode(body, c);
+        for (const auto& p : c.values) {
+            if (registers_.contains(p.first)) {
+                registers_[p.first] = p.second;
+            }
+        }
+        sendRegisters(id);
+        return;
+    }
+    case CMD_REGISTERS_AVAILABLE: {
+        RegistersAvailableResponse res;
+        for (const auto& reg : kRegisters) {
+            res.regInfos[reg.id] = RegInfo{reg.bits, reg.name};
+        }
+        send(RESPONSE_REGISTERS_AVAILABLE, id, encode(res));
+        return;
+    }
+    case CMD_BANKS_AVAILABLE: {
+        BanksAvailableResponse res;
+        res.banks.insert(banks_.begin(), banks_.end());
+        send(RESPONSE_BANKS_AVAILABLE, id, encode(res));
+        return;
+    }
+    case CMD_CHECKPOINT_GET: {
+        CheckpointGetCommand c;
+        decode(body, c);
+        auto it = checkpoints_.find(c.number);
+        if (it == checkpoints_.end()) {
+            send(RESPONSE_CHECKPOINT_INFO, id, {}, 0x01);
+            return;
+        }
+        sendCheckpoint(id, it->second);
+        return;
+    }
+    case CMD_CHECKPOINT_SET: {
+        CheckpointSetCommand c;
+        decode(body, c);
+        Checkpoint cp;
+        cp.number = nextCheckpointNumber_++;
+        cp.startAddress = c.startAddress;
+        cp.endAddress = c.endAddress;
+        cp.stopWhenHit = c.stopWhenHit;
+        cp.enabled = c.enabled;
+        cp.op = c.op;
+        cp.temporary = c.temporary;
+        cp.memspace = c.memSpace;
+        cp.hitCount = 0;
+        checkpoints_[cp.number] = cp;
+        sendCheckpoint(id, cp);
+        return;
+    }
+    case CMD_CHECKPOINT_DELETE: {
+        CheckpointDeleteCommand c;
+        decode(body, c);
+        checkpoints_.erase(c.number);
+        send(RESPONSE_CHECKPOINT_DELETE, id, {});
+        return;
+    }
+    case CMD_CHECKPOINT_LIST: {
+        for (const auto& p : checkpoints_) {
+            sendCheckpoint(id, p.second);
+        }
+        CheckpointListResponse res;
+        res.nofCheckpoints = checkpoints_.size();
+        send(RESPONSE_CHECKPOINT_LIST, id, encode(res));
+        return;
+    }
+    case CMD_CHECKPOINT_TOGGLE: {
+        CheckpointToggleCommand c;
+        decode(body, c);
+        auto it = checkpoints_.find(c.number);
+        if (it != checkpoints_.end()) {
+            it->second.enabled = c.enabled;
+        }
+        send(RESPONSE_CHECKPOINT_TOGGLE, id, {});
+        return;
+    }
+    case CMD_CONDITION_SET: {
+        ConditionSetCommand c;
+        decode(body, c);
+        auto it = checkpoints_.find(c.number);
+        // VICE rejects conditions that don't parse; the fake only checks for a comparison.
+        bool parses = c.condition.find_first_of("=<>") != std::string::npos;
+        if (it == checkpoints_.end() || !parses) {
+            send(RESPONSE_CONDITION_SET, id, {}, 0x01);
+            return;
+        }
+        // Not evaluated, the fake never runs code that could hit a checkpoint.
+        it->second.condition = c.condition;
+        send(RESPONSE_CONDITION_SET, id, {});
+        return;
+    }
+    case CMD_ADVANCE_INSTRUCTIONS: {
+        AdvanceInstructionsCommand c;
+        decode(body, c);
+        send(RESPONSE_ADVANCE_INSTRUCTIONS, id, {});
+        resume();
+        countHits(registers_[kRegPC], c.count);
+        registers_[kRegPC] += c.count;
+        stop();
+        return;
+    }
+    case CMD_EXECUTE_UNTIL_RETURN:
+        send(RESPONSE_EXECUTE_UNTIL_RETURN, id, {});
+        resume();
+        registers_[kRegPC] += 3;
+        stop();
+        return;
+    case CMD_PING:
+        send(RESPONSE_PING, id, {});
+        return;
+    case CMD_EXIT:
+        send(RESPONSE_EXIT, id, {});
+        resume();
+        if (options_.runIntoCheckpoints) {
+            runIntoCheckpoint();
+        }
+        if (options_.stopAfterMs > 0) {
+            QTimer::singleShot(options_.stopAfterMs, this, &FakeViceServer::stop);
+        }
+        return;
+    default:
+        qWarning() << "FakeViceServer: unsupported command" << cmd;
+        send(cmd, id, {}, kErrorInvalidCommand);
+    }
+}
+
+void FakeViceServer::sendRegisters(std::uint32_t id) {
+    RegistersResponse res;
+    res.values = registers_;
+    send(RESPONSE_REGISTER_INFO, id, encode(res));
+}
+
+void FakeViceServer::sendCheckpoint(std::uint32_t id, const Checkpoint& cp, bool hit) {
+    CheckpointInfoResponse res;
+    res.checkpoint = CheckpointInfo{
+        cp.number,
+        hit,
+        cp.startAddress,
+        cp.endAddress,
+        cp.stopWhenHit,
+        cp.enabled,
+        cp.op,
+        cp.temporary,
+        cp.hitCount,
+        0, // ignore count
+        !cp.condition.empty(),
+        cp.memspace,
+    };
+    send(RESPONSE_CHECKPOINT_INFO, id, encode(res));
+}
+
+void FakeViceServer::resume() {
+    running_ = true;
+    ResumedResponse res;
+    res.pc = registers_[kRegPC];
+    send(RESPONSE_RESUMED, kOobRequestId, encode(res));
+}
+
+void FakeViceServer::runIntoCheckpoint() {
+    for (auto& p : checkpoints_) {
+        Checkpoint& cp = p.second;
+        if (!cp.enabled || !(cp.op & kCheckpointOpExec)) {
+            continue;
+        }
+        // Like VICE, report the checkpoint before stopping.
+        cp.hitCount++;
+        registers_[kRegPC] = cp.startAddress;
+        sendCheckpoint(kOobRequestId, cp, true);
+        stop();
+        return;
+    }
+}
+
+void FakeViceServer::countHits(std::uint16_t pc, int instructions) {
+    // Every instruction is a one byte NOP, so the instructions execute pc, pc + 1, ...
+    int last = std::min((int)pc + instructions - 1, 0xffff);
+    for (auto& p : checkpoints_) {
+        Checkpoint& cp = p.second;
+        if (cp.stopWhenHit || !cp.enabled || !(cp.op & kCheckpointOpExec)) {
+            continue;
+        }
+        int overlap = std::min(last, (int)cp.endAddress) - std::max((int)pc, (int)cp.startAddress) + 1;
+        if (overlap > 0) {
+            cp.hitCount += overlap;
+        }
+    }
+}
+
+void FakeViceServer::stop() {
+    if (!running_) {
+        return;
+    }
+    running_ = false;
+    StoppedResponse res;
+    res.pc = registers_[kRegPC];
+    send(RESPONSE_STOPPED, kOobRequestId, encode(res));
+}
+
+void FakeViceServer::send(std::uint8_t responseType, std::uint32_t id, const std::vector<std::uint8_t>& body, std::uint8_t errorCode) {
+    if (client_ == nullptr) {
+        return;
+    }
+    ResponseHeader header;
+    header.bodyLength = body.size();
+    header.responseType = responseType;
+    header.errorCode = errorCode;
+    header.requestId = id;
+    std::vector<std::uint8_t> frame;
+    frame.reserve(kEncodedSize<ResponseHeader> + body.size());
+    encodeTo(frame, header);
+    frame.insert(frame.end(), body.begin(), body.end());
+
+    // Responses leave in order: each one is sent after the latency has passed,
+    // but not before the previous one went out completely.
+    qint64 dueNs = std::max(clock_.nsecsElapsed() + options_.latencyMs * 1000000LL, lastDueNs_);
+    if (options_.bytesPerSecond > 0) {
+        dueNs += frame.size() * 1000000000LL / options_.bytesPerSecond;
+    }
+    lastDueNs_ = dueNs;
+    outQueue_.push_back(Frame{dueNs, QByteArray((const char*)frame.data(), frame.size())});
+    scheduleWrite();
+}
+
+void FakeViceServer::scheduleWrite() {
+    if (outQueue_.empty() || writeTimer_.isActive()) {
+        return;
+    }
+    qint64 waitNs = outQueue_.front().dueNs - clock_.nsecsElapsed();
+    if (waitNs <= 0 && options_.latencyMs == 0 && options_.bytesPerSecond == 0) {
+        // Don't bother with timers if there's nothing to simulate.
+        writeDueFrames();
+        return;
+    }
+    writeTimer_.start(std::max<qint64>(0, (waitNs + 999999) / 1000000));
+}
+
+void FakeViceServer::writeDueFrames() {
+    if (client_ == nullptr) {
+        outQueue_.clear();
+        return;
+    }
+    qint64 now = clock_.nsecsElapsed();
+    while (!outQueue_.empty() && outQueue_.front().dueNs <= now) {
+        client_->write(outQueue_.front().data);
+        outQueue_.pop_front();
+    }
+    scheduleWrite();
+}
+
+}
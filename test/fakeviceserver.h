@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QHostAddress>
+#include <QByteArray>
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "connectionworker.h"
+
+namespace vicedebug {
+
+// A stand-in for VICE's binary monitor, good enough to drive ViceClient and
+// Controller without a running emulator.
+//
+// The "emulator" has a 6502 register set and a memory image per bank, and
+// treats every instruction as a one byte NOP: stepping just advances PC.
+// Responses can be delayed by a fixed latency and throttled to a bandwidth
+// limit, to simulate slow or remote connections.
+class FakeViceServer : public QObject {
+    Q_OBJECT
+
+public:
+    enum class Machine {
+        C64,
+        C128,
+    };
+
+    struct Options {
+        Machine machine = Machine::C64;
+        int latencyMs = 0; // Delay before a response is sent
+        std::uint64_t bytesPerSecond = 0; // 0 means unlimited
+        int stopAfterMs = 0; // If > 0, stop this long after execution was resumed
+        bool runIntoCheckpoints = false; // If set, execution hits the first enabled exec checkpoint right after it was resumed
+    };
+
+    explicit FakeViceServer(const Options& options, QObject* parent = nullptr);
+    virtual ~FakeViceServer();
+
+    bool listen(const QHostAddress& address = QHostAddress::LocalHost, quint16 port = 0);
+    quint16 port() const;
+
+    // Writes data to all RAM banks
+    void setMemory(std::uint16_t addr, const std::vector<std::uint8_t>& data);
+
+    // Loads a file into RAM. 64K files are loaded at 0, .prg files at the
+    // address in their first two bytes, and everything else at loadAddress.
+    bool loadImage(const QString& filename, std::uint16_t loadAddress);
+
+    std::uint64_t commandsReceived() const {
+        return commandsReceived_;
+    }
+
+public slots:
+    // Simulates the emulator hitting a breakpoint.
+    void stop();
+
+private slots:
+    void onNewConnection();
+    void onReadyRead();
+    void writeDueFrames();
+
+private:
+    struct Checkpoint {
+        std::uint32_t number;
+        std::uint16_t startAddress;
+        std::uint16_t endAddress;
+        bool stopWhenHit;
+        bool enabled;
+        std::uint8_t op;
+        bool temporary;
+        std::uint8_t memspace;
+        std::uint32_t hitCount;
+        std::string condition;
+    };
+
+    struct Frame {
+        qint64 dueNs;
+        QByteArray data;
+    };
+
+    void handleCommand(std::uint8_t cmd, std::uint32_t id, std::span<const std::uint8_t> body);
+    void send(std::uint8_t responseType, std::uint32_t id, const std::vector<std::uint8_t>& body, std::uint8_t errorCode = 0);
+    void sendRegisters(std::uint32_t id);
+    void sendCheckpoint(std::uint32_t id, const Checkpoint& cp, bool hit = false);
+    void resume();
+    void runIntoCheckpoint();
+    void countHits(std::uint16_t pc, int instructions);
+    void scheduleWrite();
+
+    Options options_;
+    QTcpServer server_;
+    QTcpSocket* client_;
+    QByteArray in_;
+
+    QElapsedTimer clock_;
+    QTimer writeTimer_;
+    std::deque<Frame> outQueue_;
+    qint64 lastDueNs_;
+
+    std::vector<std::pair<std::uint16_t, std::string>> banks_;
+    std::map<std::uint16_t, std::vector<std::uint8_t>> memory_;
+    std::map<std::uint8_t, std::uint16_t> registers_;
+    std::map<std::uint32_t, Checkpoint> checkpoints_;
+    std::uint32_t nextCheckpointNumber_;
+    bool running_;
+    std::uint64_t commandsReceived_;
+};
+
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QTest>
+
+#include <vector>
+#include <cstdint>
+
+#include "instructionboundarymap.h"
+
+namespace vicedebug {
+
+class InstructionBoundaryMapTest: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testMark() {
+        InstructionBoundaryMap map;
+        map.mark(0x1000, std::vector<std::uint8_t>{0x20, 0x00, 0x20});
+        map.mark(0x1003, std::vector<std::uint8_t>{0xea});
+        QCOMPARE(map.lengthAt(0x1000), 3);
+        QCOMPARE(map.lengthAt(0x1001), 0);
+        QCOMPARE(map.lengthAt(0x1003), 1);
+        QCOMPARE(map.size(), 2);
+
+        // Marking the same instruction again changes nothing.
+        map.mark(0x1000, std::vector<std::uint8_t>{0x20, 0x00, 0x20});
+        QCOMPARE(map.size(), 2);
+    }
+
+    void testMarkForgetsOverlapping() {
+        InstructionBoundaryMap map;
+        map.mark(0x1000, std::vector<std::uint8_t>{0x20, 0x00, 0x20});
+        map.mark(0x1003, std::vector<std::uint8_t>{0xea});
+
+        // Overlaps the end of the JSR, but not the NOP.
+        map.mark(0x1002, std::vector<std::uint8_t>{0x20});
+        QCOMPARE(map.lengthAt(0x1000), 0);
+        QCOMPARE(map.lengthAt(0x1002), 1);
+        QCOMPARE(map.lengthAt(0x1003), 1);
+        QCOMPARE(map.size(), 2);
+
+        // Overlaps both.
+        map.mark(0x1001, std::vector<std::uint8_t>{0xad, 0x20, 0xea});
+        QCOMPARE(map.lengthAt(0x1001), 3);
+        QCOMPARE(map.lengthAt(0x1002), 0);
+        QCOMPARE(map.lengthAt(0x1003), 0);
+        QCOMPARE(map.size(), 1);
+    }
+
+    void testMarkAtEndOfMemory() {
+        InstructionBoundaryMap map;
+        map.mark(0xfffe, std::vector<std::uint8_t>{0xa9, 0x00});
+        QCOMPARE(map.lengthAt(0xfffe), 2);
+        // Would wrap around
+        map.mark(0xffff, std::vector<std::uint8_t>{0x20, 0x00, 0x10});
+        QCOMPARE(map.lengthAt(0xffff), 0);
+        QCOMPARE(map.lengthAt(0xfffe), 2);
+    }
+
+    void testUpdate() {
+        InstructionBoundaryMap map;
+        map.mark(0x1000, std::vector<std::uint8_t>{0x20, 0x00, 0x20});
+        map.mark(0x1003, std::vector<std::uint8_t>{0xea});
+        map.mark(0x1004, std::vector<std::uint8_t>{0xa9, 0x01});
+
+        // Unchanged bytes keep the instructions.
+        map.update(0x0ff0, std::vector<std::uint8_t>(0x10, 0x00));
+        map.update(0x1002, std::vector<std::uint8_t>{0x20, 0xea, 0xa9});
+        QCOMPARE(map.size(), 3);
+
+        // Changes the last byte of the JSR and the operand of the LDA.
+        map.update(0x1002, std::vector<std::uint8_t>{0x30});
+        map.update(0x1005, std::vector<std::uint8_t>{0x02});
+        QCOMPARE(map.lengthAt(0x1000), 0);
+        QCOMPARE(map.lengthAt(0x1003), 1);
+        QCOMPARE(map.lengthAt(0x1004), 0);
+        QCOMPARE(map.size(), 1);
+    }
+
+    void testClear() {
+        InstructionBoundaryMap map;
+        map.mark(0x1000, std::vector<std::uint8_t>{0xea});
+        map.clear();
+        QCOMPARE(map.lengthAt(0x1000), 0);
+        QCOMPARE(map.size(), 0);
+    }
+};
+
+}
+
+QTEST_MAIN(vicedebug::InstructionBoundaryMapTest)
+
+#include "instructionboundarymap_test.moc"
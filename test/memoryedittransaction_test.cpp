@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QTest>
+
+#include <cstdint>
+#include <vector>
+
+#include "memoryedittransaction.h"
+
+namespace vicedebug {
+
+using Bytes = std::vector<std::uint8_t>;
+
+class MemoryEditTransactionTest: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testEmpty() {
+        MemoryEditTransaction transaction;
+        QVERIFY(transaction.empty());
+        QVERIFY(transaction.runs().empty());
+    }
+
+    void testAdjacentEditsAreMerged() {
+        MemoryEditTransaction transaction;
+        transaction.set(0x1000, 1);
+        transaction.set(0x1001, 2);
+        transaction.set(0x1003, 4);
+        transaction.set(0x1002, 3);
+        transaction.set(0x2000, 9);
+
+        auto runs = transaction.runs();
+        QCOMPARE(runs.size(), size_t(2));
+        QCOMPARE(runs[0].addr, std::uint16_t(0x1000));
+        QCOMPARE(runs[0].data, (Bytes{1, 2, 3, 4}));
+        QCOMPARE(runs[0].end(), std::uint16_t(0x1003));
+        QCOMPARE(runs[1].addr, std::uint16_t(0x2000));
+        QCOMPARE(runs[1].data, (Bytes{9}));
+    }
+
+    void testLaterEditsWin() {
+        MemoryEditTransaction transaction;
+        transaction.write(0x1000, {1, 2, 3, 4});
+        transaction.fill(0x1002, 0x1005, 0xff);
+
+        auto runs = transaction.runs();
+        QCOMPARE(runs.size(), size_t(1));
+        QCOMPARE(runs[0].data, (Bytes{1, 2, 0xff, 0xff, 0xff, 0xff}));
+        QCOMPARE(transaction.size(), size_t(6));
+    }
+
+    void testWriteIsClippedAtEndOfMemory() {
+        MemoryEditTransaction transaction;
+        transaction.write(0xfffe, {1, 2, 3});
+        QCOMPARE(transaction.size(), size_t(2));
+    }
+
+    void testFillWholeBank() {
+        MemoryEditTransaction transaction;
+        transaction.fill(0x0000, 0xffff, 0);
+        auto runs = transaction.runs();
+        QCOMPARE(runs.size(), size_t(1));
+        QCOMPARE(runs[0].data.size(), size_t(0x10000));
+        QCOMPARE(runs[0].end(), std::uint16_t(0xffff));
+    }
+
+    void testEditsAtBothEnds() {
+        MemoryEditTransaction transaction;
+        transaction.set(0xffff, 2);
+        transaction.set(0x0000, 1);
+        auto runs = transaction.runs();
+        QCOMPARE(runs.size(), size_t(2));
+        QCOMPARE(runs[0].addr, std::uint16_t(0x0000));
+        QCOMPARE(runs[1].addr, std::uint16_t(0xffff));
+        QCOMPARE(runs[1].data, (Bytes{2}));
+    }
+
+    void testParseHexBytes_data() {
+        QTest::addColumn<QString>("text");
+        QTest::addColumn<bool>("valid");
+        QTest::addColumn<QByteArray>("bytes");
+
+        QTest::newRow("spaces") << "a9 00 8D 20 d0" << true << QByteArray::fromHex("a9008d20d0");
+        QTest::newRow("contiguous") << "A9008d20D0" << true << QByteArray::fromHex("a9008d20d0");
+        QTest::newRow("prefixes") << "$a9, $00,0x8d\n" << true << QByteArray::fromHex("a9008d");
+        QTest::newRow("empty") << "" << true << QByteArray();
+        QTest::newRow("odd digits") << "a9 0" << false << QByteArray();
+        QTest::newRow("not hex") << "zz" << false << QByteArray();
+        QTest::newRow("prefix only") << "$" << false << QByteArray();
+    }
+
+    void testParseHexBytes() {
+        QFETCH(QString, text);
+        QFETCH(bool, valid);
+        QFETCH(QByteArray, bytes);
+
+        auto res = parseHexBytes(text.toStdString());
+        QCOMPARE(res.has_value(), valid);
+        if (valid) {
+            QCOMPARE(res.value(), Bytes(bytes.begin(), bytes.end()));
+        }
+    }
+};
+
+}
+
+QTEST_MAIN(vicedebug::MemoryEditTransactionTest)
+#include "memoryedittransaction_test.moc"
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QTest>
+
+#include <vector>
+#include <cstdint>
+
+#include "memoryimage.h"
+
+namespace vicedebug {
+
+using Ranges = std::vector<std::pair<std::uint16_t, std::uint16_t>>;
+
+class MemoryImageTest: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testEmptyImage() {
+        MemoryImage image;
+        QCOMPARE(image.size(), std::size_t(0x10000));
+        QVERIFY(!image.isPresent(0x1234));
+        QCOMPARE(image[0x1234], std::uint8_t(0));
+        QCOMPARE(image.missingRanges(0x0000, 0xffff), (Ranges{{0x0000, 0xffff}}));
+    }
+
+    void testWriteFullPages() {
+        MemoryImage image;
+        image.write(0x1000, std::vector<std::uint8_t>(0x200, 0xaa));
+        QVERIFY(image.isPresent(0x1000, 0x11ff));
+        QVERIFY(!image.isPresent(0x0fff));
+        QVERIFY(!image.isPresent(0x1200));
+        QCOMPARE(image[0x1000], std::uint8_t(0xaa));
+        QCOMPARE(image[0x11ff], std::uint8_t(0xaa));
+    }
+
+    void testPartialWriteDoesNotMarkPage() {
+        MemoryImage image;
+        image.write(0x1010, { 0x01, 0x02 });
+        QCOMPARE(image[0x1010], std::uint8_t(0x01));
+        QCOMPARE(image[0x1011], std::uint8_t(0x02));
+        QVERIFY(!image.isPresent(0x1010));
+
+        // Spans a full page, but only partially covers its neighbours.
+        image.write(0x20ff, std::vector<std::uint8_t>(0x102, 0x55));
+        QVERIFY(!image.isPagePresent(0x20));
+        QVERIFY(image.isPagePresent(0x21));
+        QVERIFY(!image.isPagePresent(0x22));
+    }
+
+    void testMissingRanges() {
+        MemoryImage image;
+        image.write(0x0100, std::vector<std::uint8_t>(0x100, 0));
+        image.write(0x0300, std::vector<std::uint8_t>(0x100, 0));
+        QCOMPARE(image.missingRanges(0x0010, 0x04ff), (Ranges{{0x0000, 0x00ff}, {0x0200, 0x02ff}, {0x0400, 0x04ff}}));
+        QCOMPARE(image.missingRanges(0x0100, 0x01ff), Ranges{});
+        QCOMPARE(image.missingRanges(0xff80, 0xffff), (Ranges{{0xff00, 0xffff}}));
+    }
+
+    void testMissingRangesIgnoresPages() {
+        MemoryImage image;
+        std::bitset<MemoryImage::kMaxPages> inFlight;
+        inFlight[0x01] = true;
+        QCOMPARE(image.missingRanges(0x0000, 0x02ff, inFlight), (Ranges{{0x0000, 0x00ff}, {0x0200, 0x02ff}}));
+    }
+
+    void testInvalidate() {
+        MemoryImage image;
+        image.write(0xc000, std::vector<std::uint8_t>(0x100, 0x42));
+        QVERIFY(image.isPresent(0xc000));
+        image.invalidate();
+        QVERIFY(!image.isPresent(0xc000));
+    }
+
+    void testSmallImage() {
+        MemoryImage image(0x80);
+        QCOMPARE(image.size(), std::size_t(0x80));
+        QVERIFY(!image.isPresent(0x00, 0xff));
+        image.write(0x70, std::vector<std::uint8_t>(0x20, 0x11)); // truncated
+        QCOMPARE(image[0x7f], std::uint8_t(0x11));
+    }
+
+    void testCopiesShareStorage() {
+        MemoryImage image;
+        image.write(0x1000, std::vector<std::uint8_t>(0x200, 0xaa));
+        MemoryImage copy = image;
+        QVERIFY(copy.sharesPageWith(image, 0x10));
+        QVERIFY(copy.sharesPageWith(image, 0x11));
+        QCOMPARE(&copy.bytes(), &image.bytes());
+    }
+
+    void testWriteCopiesOnlyTouchedPages() {
+        MemoryImage image;
+        image.write(0x1000, std::vector<std::uint8_t>(0x200, 0xaa));
+        MemoryImage copy = image;
+
+        copy.write(0x1010, { 0x55 });
+        QCOMPARE(copy[0x1010], std::uint8_t(0x55));
+        QCOMPARE(image[0x1010], std::uint8_t(0xaa));
+        QCOMPARE(copy.bytes()[0x1010], std::uint8_t(0x55));
+        QCOMPARE(image.bytes()[0x1010], std::uint8_t(0xaa));
+        QVERIFY(!copy.sharesPageWith(image, 0x10));
+        QVERIFY(copy.sharesPageWith(image, 0x11));
+
+        // Presence is per image, too.
+        copy.write(0x2000, std::vector<std::uint8_t>(0x100, 0x11));
+        QVERIFY(copy.isPresent(0x2000));
+        QVERIFY(!image.isPresent(0x2000));
+        QCOMPARE(image[0x2000], std::uint8_t(0));
+    }
+
+    void cleanupTestCase() {
+    }
+
+};
+
+}
+
+QTEST_MAIN(vicedebug::MemoryImageTest)
+
+#include "memoryimage_test.moc"
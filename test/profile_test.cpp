@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <QTest>
+
+#include <cstdint>
+#include <string>
+
+#include "profile.h"
+
+namespace vicedebug {
+
+class ProfileTest: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testRoutineRegions() {
+        auto regions = Profile::routineRegions({{"loop", 0x1000}, {"main", 0x0810}, {"again", 0x1000}});
+        QCOMPARE(regions.size(), size_t(2));
+        QCOMPARE(regions[0].name, std::string("main"));
+        QCOMPARE(regions[0].start, std::uint16_t(0x0810));
+        QCOMPARE(regions[0].end, std::uint16_t(0x0810));
+        // One checkpoint for labels of the same address.
+        QCOMPARE(regions[1].name, std::string("again, loop"));
+    }
+
+    void testRoutineRegionsAreCapped() {
+        std::vector<std::pair<std::string, std::uint16_t>> symbols;
+        for (int i = 0; i < 2000; i++) {
+            symbols.push_back({"l" + std::to_string(i), (std::uint16_t)i});
+        }
+        QCOMPARE(Profile::routineRegions(symbols).size(), Profile::kMaxRegions);
+    }
+
+    void testBucketRegions() {
+        auto regions = Profile::bucketRegions(0x1000);
+        QCOMPARE(regions.size(), size_t(16));
+        QCOMPARE(regions[15].name, std::string("$f000-$ffff"));
+        QCOMPARE(regions[15].start, std::uint16_t(0xf000));
+        QCOMPARE(regions[15].end, std::uint16_t(0xffff));
+
+        // Too small buckets would need more than kMaxRegions checkpoints.
+        QCOMPARE(Profile::bucketRegions(1).size(), Profile::kMaxRegions);
+    }
+
+    void testUpdate() {
+        Profile profile;
+        profile.add(ProfileRegion{"main", 0x0810, 0x0810}, 3);
+        profile.add(ProfileRegion{"irq", 0xc000, 0xc000}, 4);
+
+        profile.update({{3, 10}, {4, 1}, {99, 1000}});
+        QCOMPARE(profile.entries()[0].hits, std::uint64_t(10));
+        QCOMPARE(profile.entries()[0].delta, std::uint64_t(10));
+        QCOMPARE(profile.totalHits(), std::uint64_t(11));
+
+        profile.update({{3, 15}});
+        QCOMPARE(profile.entries()[0].hits, std::uint64_t(15));
+        QCOMPARE(profile.entries()[0].delta, std::uint64_t(5));
+        QCOMPARE(profile.entries()[1].hits, std::uint64_t(1));
+        QCOMPARE(profile.entries()[1].delta, std::uint64_t(0));
+    }
+
+    void testUpdateAcrossCounterWrapAround() {
+        Profile profile;
+        profile.add(ProfileRegion{"irq", 0xc000, 0xc000}, 1);
+        profile.update({{1, 0xfffffff0}});
+        profile.update({{1, 0x10}});
+        QCOMPARE(profile.entries()[0].delta, std::uint64_t(0x20));
+        QCOMPARE(profile.entries()[0].hits, std::uint64_t(0x100000010));
+    }
+};
+
+}
+
+QTEST_MAIN(vicedebug::ProfileTest)
+#include "profile_test.moc"
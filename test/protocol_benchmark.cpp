@@ -0,0 +1,572 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QTest>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QThread>
+#include <QTimer>
+#include <QElapsedTimer>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "controllerfixture.h"
+#include "protocol.h"
+#include "receivebuffer.h"
+
+namespace vicedebug {
+
+namespace {
+
+struct Stats {
+    double minMs;
+    double avgMs;
+    double maxMs;
+};
+
+Stats stats(const std::vector<double>& samples) {
+    Stats s{samples[0], 0, samples[0]};
+    for (double v : samples) {
+        s.minMs = std::min(s.minMs, v);
+        s.maxMs = std::max(s.maxMs, v);
+        s.avgMs += v;
+    }
+    s.avgMs /= samples.size();
+    return s;
+}
+
+double elapsedMs(const QElapsedTimer& timer) {
+    return timer.nsecsElapsed() / 1e6;
+}
+
+// Ticks like a 60 fps repaint timer, and records the longest gap between two
+// ticks: the longest time the event loop was blocked.
+class FrameClock {
+public:
+    FrameClock() {
+        QObject::connect(&timer_, &QTimer::timeout, [this] {
+            if (clock_.isValid()) {
+                maxGapMs_ = std::max(maxGapMs_, elapsedMs(clock_));
+            }
+            clock_.start();
+        });
+        timer_.start(16);
+    }
+
+    double maxGapMs() const {
+        return maxGapMs_;
+    }
+
+private:
+    QTimer timer_;
+    QElapsedTimer clock_;
+    double maxGapMs_ = 0;
+};
+
+// Minimal stand-in for VICE's binary monitor: accepts one connection and
+// streams the same frame over and over again, as fast as the socket allows.
+class FakeMonitorServer : public QThread {
+public:
+    FakeMonitorServer(const std::vector<std::uint8_t>& frame, int count)
+        : frame_(frame), count_(count) {
+        server_.moveToThread(this);
+        server_.listen(QHostAddress::LocalHost, 0);
+    }
+
+    quint16 port() const {
+        return server_.serverPort();
+    }
+
+protected:
+    void run() override {
+        if (!server_.waitForNewConnection(5000)) {
+            return;
+        }
+        QTcpSocket* socket = server_.nextPendingConnection();
+        for (int i = 0; i < count_; i++) {
+            socket->write((const char*)frame_.data(), frame_.size());
+            while (socket->bytesToWrite() > 4 * (qint64)frame_.size()) {
+                socket->waitForBytesWritten(1000);
+            }
+        }
+        while (socket->bytesToWrite() > 0 && socket->waitForBytesWritten(1000))
+            ;
+        socket->disconnectFromHost();
+        delete socket;
+    }
+
+private:
+    QTcpServer server_;
+    std::vector<std::uint8_t> frame_;
+    int count_;
+};
+
+}
+
+// Benchmarks of the socket receive path, and end to end benchmarks of ViceClient,
+// ConnectionWorker and Controller against a fake VICE. Results are reported
+// with qInfo(), and the average as benchmark result.
+class ProtocolBenchmark: public QObject
+{
+    Q_OBJECT
+
+private:
+    void addLatencyRows() {
+        QTest::addColumn<int>("latencyMs");
+        QTest::newRow("latency 0ms") << 0;
+        QTest::newRow("latency 5ms") << 5;
+    }
+
+private slots:
+    void benchmarkReceiveThroughput() {
+        // A RESPONSE_MEM_GET for a full 64K bank: 2 bytes length + data
+        const int kFrames = 512;
+        ResponseHeader header;
+        header.bodyLength = 2 + 0x10000;
+        header.responseType = RESPONSE_MEM_GET;
+        header.errorCode = 0;
+        header.requestId = 1;
+        std::vector<std::uint8_t> frame;
+        encodeTo(frame, header);
+        frame.resize(frame.size() + header.bodyLength);
+
+        FakeMonitorServer server(frame, kFrames);
+        server.start();
+
+        QTcpSocket socket;
+        socket.connectToHost(QHostAddress::LocalHost, server.port());
+        QVERIFY(socket.waitForConnected(5000));
+
+        ReceiveBuffer buffer;
+        int frames = 0;
+        std::uint64_t bytes = 0;
+        QElapsedTimer timer;
+        timer.start();
+        while (frames < kFrames && socket.waitForReadyRead(5000)) {
+            // Same receive loop as ConnectionWorker::consumeBytes()
+            qint64 available;
+            while ((available = socket.bytesAvailable()) > 0) {
+                auto dest = buffer.prepare(available);
+                qint64 read = socket.read((char*)dest.data(), dest.size());
+                if (read <= 0) {
+                    break;
+                }
+                buffer.commit(read);
+                for (auto f = buffer.nextFrame(); !f.empty(); f = buffer.nextFrame()) {
+                    frames++;
+                    bytes += f.size();
+                }
+            }
+        }
+        double ms = elapsedMs(timer);
+        server.wait();
+
+        QCOMPARE(frames, kFrames);
+        double secs = ms / 1000;
+        qInfo() << "Received" << frames << "frames," << bytes << "bytes in" << secs << "s:"
+                << (bytes / secs / (1024*1024)) << "MB/s," << (frames / secs) << "frames/s";
+        QTest::setBenchmarkResult(ms, QTest::WalltimeMilliseconds);
+    }
+
+    void benchmarkConnect_data() {
+        addLatencyRows();
+    }
+
+    void benchmarkConnect() {
+        QFETCH(int, latencyMs);
+        const int kRounds = 10;
+
+        ControllerFixture fixture(FakeViceServer::Options{.latencyMs = latencyMs});
+        Controller& controller = fixture.controller();
+
+        std::vector<double> samples;
+        for (int i = 0; i < kRounds; i++) {
+            QElapsedTimer timer;
+            timer.start();
+            QVERIFY(fixture.connect());
+            samples.push_back(elapsedMs(timer));
+            controller.disconnect();
+        }
+
+        Stats s = stats(samples);
+        qInfo() << "Connect:" << s.avgMs << "ms avg," << s.minMs << "ms min," << s.maxMs << "ms max";
+        QTest::setBenchmarkResult(s.avgMs, QTest::WalltimeMilliseconds);
+    }
+
+    void benchmarkStopToState_data() {
+        addLatencyRows();
+    }
+
+    void benchmarkStopToState() {
+        QFETCH(int, latencyMs);
+        const int kRounds = 20;
+
+        ControllerFixture fixture(FakeViceServer::Options{.latencyMs = latencyMs});
+        Controller& controller = fixture.controller();
+        QVERIFY(fixture.connect());
+
+        std::vector<double> samples;
+        for (int i = 0; i < kRounds; i++) {
+            controller.resumeExecution();
+            QVERIFY(waitForSignal(&controller, &Controller::executionResumed));
+            QElapsedTimer timer;
+            timer.start();
+            fixture.server().stop();
+            QVERIFY(waitForSignal(&controller, &Controller::executionPaused));
+            samples.push_back(elapsedMs(timer));
+        }
+
+        Stats s = stats(samples);
+        qInfo() << "Stop to state:" << s.avgMs << "ms avg," << s.minMs << "ms min," << s.maxMs << "ms max";
+        QTest::setBenchmarkResult(s.avgMs, QTest::WalltimeMilliseconds);
+    }
+
+    void benchmarkStepThroughput_data() {
+        addLatencyRows();
+    }
+
+    void benchmarkStepThroughput() {
+        QFETCH(int, latencyMs);
+        const int kSteps = 100;
+
+        ControllerFixture fixture(FakeViceServer::Options{.latencyMs = latencyMs});
+        Controller& controller = fixture.controller();
+        QVERIFY(fixture.connect());
+
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < kSteps; i++) {
+            controller.stepIn();
+            QVERIFY(waitForSignal(&controller, &Controller::executionPaused));
+        }
+        double ms = elapsedMs(timer);
+
+        qInfo() << "Steps:" << kSteps << "in" << ms << "ms," << (kSteps * 1000.0 / ms) << "steps/s";
+        QTest::setBenchmarkResult(ms / kSteps, QTest::WalltimeMilliseconds);
+    }
+
+    void benchmarkHeldStep_data() {
+        addLatencyRows();
+    }
+
+    // Steps requested faster than VICE executes them, like a held step key.
+    void benchmarkHeldStep() {
+        QFETCH(int, latencyMs);
+        const int kSteps = 50;
+
+        ControllerFixture fixture(FakeViceServer::Options{.latencyMs = latencyMs});
+        Controller& controller = fixture.controller();
+        QVERIFY(fixture.connect());
+
+        int pausedCount = 0;
+        std::uint16_t pc = 0;
+        QObject::connect(&controller, &Controller::executionPaused, [&](const MachineState& state) {
+            pausedCount++;
+            pc = state.regs[Registers::PC];
+        });
+
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < kSteps; i++) {
+            controller.stepIn();
+        }
+        while (pc != (std::uint16_t)(fixture.startPc() + kSteps)) {
+            QVERIFY(waitForSignal(&controller, &Controller::executionPaused));
+        }
+        double ms = elapsedMs(timer);
+
+        qInfo() << "Held step:" << kSteps << "steps in" << ms << "ms," << pausedCount << "states shown";
+        QTest::setBenchmarkResult(ms, QTest::WalltimeMilliseconds);
+    }
+
+    void benchmarkStepN_data() {
+        addLatencyRows();
+    }
+
+    void benchmarkStepN() {
+        QFETCH(int, latencyMs);
+        const int kSteps = 500;
+
+        ControllerFixture fixture(FakeViceServer::Options{.latencyMs = latencyMs});
+        Controller& controller = fixture.controller();
+        QVERIFY(fixture.connect());
+
+        QElapsedTimer timer;
+        timer.start();
+        controller.stepN(kSteps, false);
+        QVERIFY(waitForSignal(&controller, &Controller::executionPaused));
+        double ms = elapsedMs(timer);
+
+        qInfo() << "Step N:" << kSteps << "in" << ms << "ms," << (kSteps * 1000.0 / ms) << "steps/s";
+        QTest::setBenchmarkResult(ms / kSteps, QTest::WalltimeMilliseconds);
+    }
+
+    void benchmarkStepUntil_data() {
+        addLatencyRows();
+    }
+
+    void benchmarkStepUntil() {
+        QFETCH(int, latencyMs);
+        const int kMaxSteps = 100;
+
+        ControllerFixture fixture(FakeViceServer::Options{.latencyMs = latencyMs});
+        Controller& controller = fixture.controller();
+        QVERIFY(fixture.connect());
+
+        // Never true for the fake's memory pattern, so the loop runs until kMaxSteps.
+        std::string error;
+        auto condition = StepCondition::parse("[$d020] == $00 && A == $ff", error);
+        QVERIFY(condition.has_value());
+
+        int steps = 0;
+        QObject::connect(&controller, &Controller::steppingFinished, [&steps](int n, double) { steps = n; });
+
+        QElapsedTimer timer;
+        timer.start();
+        controller.stepUntil(condition.value(), false, kMaxSteps);
+        QVERIFY(waitForSignal(&controller, &Controller::executionPaused));
+        double ms = elapsedMs(timer);
+
+        qInfo() << "Step until:" << steps << "in" << ms << "ms," << (steps * 1000.0 / ms) << "steps/s";
+        QTest::setBenchmarkResult(ms / kMaxSteps, QTest::WalltimeMilliseconds);
+    }
+
+    void benchmarkPause_data() {
+        QTest::addColumn<int>("latencyMs");
+        QTest::addColumn<bool>("reconnect");
+        for (int latencyMs : {0, 5}) {
+            QTest::addRow("ping, latency %dms", latencyMs) << latencyMs << false;
+            QTest::addRow("reconnect, latency %dms", latencyMs) << latencyMs << true;
+        }
+    }
+
+    void benchmarkPause() {
+        QFETCH(int, latencyMs);
+        QFETCH(bool, reconnect);
+        const int kRounds = 20;
+
+        ControllerFixture fixture(FakeViceServer::Options{.latencyMs = latencyMs});
+        Controller& controller = fixture.controller();
+        controller.setPauseMethod(reconnect ? Controller::PauseMethod::RECONNECT : Controller::PauseMethod::PING);
+        QVERIFY(fixture.connect());
+
+        std::vector<double> samples;
+        for (int i = 0; i < kRounds; i++) {
+            controller.resumeExecution();
+            QVERIFY(waitForSignal(&controller, &Controller::executionResumed));
+            QElapsedTimer timer;
+            timer.start();
+            controller.pauseExecution();
+            QVERIFY(waitForSignal(&controller, &Controller::executionPaused));
+            samples.push_back(elapsedMs(timer));
+        }
+
+        Stats s = stats(samples);
+        qInfo() << "Pause:" << s.avgMs << "ms avg," << s.minMs << "ms min," << s.maxMs << "ms max";
+        QTest::setBenchmarkResult(s.avgMs, QTest::WalltimeMilliseconds);
+    }
+
+    void benchmarkEditDuringStreaming() {
+        // After a stop, the rest of the CPU's memory streams in. That takes
+        // about a second on this link, and an edit must not wait for it.
+        ControllerFixture fixture(FakeViceServer::Options{.bytesPerSecond = 64 * 1024});
+        Controller& controller = fixture.controller();
+        QVERIFY(fixture.connect());
+
+        bool edited = false;
+        int chunks = 0; // Streamed memory that arrived
+        QObject::connect(&controller, &Controller::memoryChanged, [&](std::uint16_t, std::uint16_t address, const std::vector<std::uint8_t>& data) {
+            if (address == 0x1234 && data.size() == 1 && data[0] == 0x42) {
+                edited = true;
+            } else {
+                chunks++;
+            }
+        });
+
+        QElapsedTimer timer;
+        timer.start();
+        controller.writeMemory(fixture.cpuBankId(), 0x1234, 0x42);
+        while (!edited) {
+            QVERIFY(waitForSignal(&controller, &Controller::memoryChanged));
+        }
+        double ms = elapsedMs(timer);
+
+        // The edit overtook the streamed reads that were still queued, so more of them arrive after it.
+        int chunksBeforeEdit = chunks;
+        QVERIFY(waitForSignal(&controller, &Controller::memoryChanged));
+        QVERIFY(chunks > chunksBeforeEdit);
+
+        qInfo() << "Edit during streaming:" << ms << "ms," << chunksBeforeEdit << "streamed chunks before it";
+        QTest::setBenchmarkResult(ms, QTest::WalltimeMilliseconds);
+    }
+
+    void benchmarkFillRange_data() {
+        addLatencyRows();
+    }
+
+    void benchmarkFillRange() {
+        QFETCH(int, latencyMs);
+        const std::uint16_t kStart = 0x2000;
+        const std::uint16_t kEnd = 0x2fff;
+
+        ControllerFixture fixture(FakeViceServer::Options{.latencyMs = latencyMs});
+        Controller& controller = fixture.controller();
+        QVERIFY(fixture.connect());
+
+        bool written = false;
+        QObject::connect(&controller, &Controller::memoryChanged, [&written](std::uint16_t, std::uint16_t address, const std::vector<std::uint8_t>&) {
+            written |= address == kStart;
+        });
+
+        MemoryEditTransaction transaction;
+        transaction.fill(kStart, kEnd, 0xea);
+        QElapsedTimer timer;
+        timer.start();
+        controller.writeMemory(fixture.cpuBankId(), transaction);
+        while (!written) {
+            QVERIFY(waitForSignal(&controller, &Controller::memoryChanged));
+        }
+        double ms = elapsedMs(timer);
+
+        qInfo() << "Fill" << (kEnd - kStart + 1) << "bytes:" << ms << "ms";
+        QTest::setBenchmarkResult(ms, QTest::WalltimeMilliseconds);
+    }
+
+    void benchmarkConditionalBreakpoint() {
+        ControllerFixture fixture;
+        Controller& controller = fixture.controller();
+        QVERIFY(fixture.connect());
+
+        QElapsedTimer timer;
+        timer.start();
+        controller.createBreakpoint(Breakpoint::Type::EXEC, 0x1000, 0x1000, true, "A == $ff");
+        QVERIFY(waitForSignal(&controller, &Controller::breakpointsChanged));
+        double ms = elapsedMs(timer);
+
+        qInfo() << "Create conditional breakpoint:" << ms << "ms";
+        QTest::setBenchmarkResult(ms, QTest::WalltimeMilliseconds);
+    }
+
+    void benchmarkTracepointThroughput_data() {
+        addLatencyRows();
+    }
+
+    void benchmarkTracepointThroughput() {
+        QFETCH(int, latencyMs);
+        const int kHits = 100;
+
+        // The fake runs straight into the tracepoint whenever it is resumed.
+        ControllerFixture fixture(FakeViceServer::Options{.latencyMs = latencyMs, .runIntoCheckpoints = true});
+        Controller& controller = fixture.controller();
+        QVERIFY(fixture.connect());
+
+        std::string error;
+        controller.createBreakpoint(Breakpoint::Type::EXEC, 0xc010, 0xc010, true, {}, TraceSpec::parse("A X [$d020] [$fb-$fe]", error));
+        QVERIFY(waitForSignal(&controller, &Controller::breakpointsChanged));
+
+        std::size_t hits = 0;
+        double hitsPerSecond = 0;
+        QObject::connect(&controller, &Controller::tracepointHit, [&](std::uint32_t, std::size_t n, double perSecond) {
+            hits = n;
+            hitsPerSecond = perSecond;
+        });
+
+        QElapsedTimer timer;
+        timer.start();
+        controller.resumeExecution();
+        while (hits < kHits) {
+            QVERIFY(waitForSignal(&controller, &Controller::tracepointHit));
+        }
+        double ms = elapsedMs(timer);
+
+        qInfo() << "Tracepoint:" << kHits << "hits in" << ms << "ms," << hitsPerSecond << "hits/s";
+        QTest::setBenchmarkResult(ms / kHits, QTest::WalltimeMilliseconds);
+    }
+
+    void benchmarkProfiler_data() {
+        addLatencyRows();
+    }
+
+    void benchmarkProfiler() {
+        QFETCH(int, latencyMs);
+
+        ControllerFixture fixture(FakeViceServer::Options{.latencyMs = latencyMs});
+        Controller& controller = fixture.controller();
+        QVERIFY(fixture.connect());
+
+        QElapsedTimer timer;
+        timer.start();
+        controller.startProfiler(Profile::bucketRegions(0x100));
+        QVERIFY(waitForSignal(&controller, &Controller::profileUpdated));
+        double ms = elapsedMs(timer);
+        controller.stopProfiler();
+
+        qInfo() << "Profiler: 256 checkpoints set up in" << ms << "ms";
+        QTest::setBenchmarkResult(ms, QTest::WalltimeMilliseconds);
+    }
+
+    void benchmarkCoverage_data() {
+        addLatencyRows();
+    }
+
+    void benchmarkCoverage() {
+        QFETCH(int, latencyMs);
+
+        ControllerFixture fixture(FakeViceServer::Options{.latencyMs = latencyMs});
+        Controller& controller = fixture.controller();
+        QVERIFY(fixture.connect());
+
+        QElapsedTimer timer;
+        timer.start();
+        controller.startCoverage(0xc000, 0xc0ff);
+        QVERIFY(waitForSignal(&controller, &Controller::coverageChanged));
+        double ms = elapsedMs(timer);
+        std::size_t blocks = controller.uncoveredBlocks();
+
+        qInfo() << "Coverage:" << blocks << "blocks set up in" << ms << "ms";
+        QTest::setBenchmarkResult(ms, QTest::WalltimeMilliseconds);
+    }
+
+    void benchmarkEventLoopStalls() {
+        // A slow link: every response takes 20ms, and the machine state
+        // needs a few of them. None of that should block the event loop.
+        const int kSteps = 10;
+
+        ControllerFixture fixture(FakeViceServer::Options{.latencyMs = 20, .bytesPerSecond = 64 * 1024});
+        Controller& controller = fixture.controller();
+        FrameClock frameClock;
+
+        QVERIFY(fixture.connect());
+        for (int i = 0; i < kSteps; i++) {
+            controller.stepIn();
+            QVERIFY(waitForSignal(&controller, &Controller::executionPaused));
+        }
+
+        qInfo() << "Longest event loop stall:" << frameClock.maxGapMs() << "ms";
+        QTest::setBenchmarkResult(frameClock.maxGapMs(), QTest::WalltimeMilliseconds);
+    }
+};
+
+}
+
+QTEST_MAIN(vicedebug::ProtocolBenchmark)
+
+#include "protocol_benchmark.moc"
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QTest>
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "protocol.h"
+
+namespace vicedebug {
+
+namespace {
+
+using Bytes = std::vector<std::uint8_t>;
+
+struct TestRegInfo {
+    std::uint8_t bits;
+    std::string name;
+
+    static constexpr auto kFields = std::make_tuple(&TestRegInfo::bits, &TestRegInfo::name);
+};
+
+struct TestRegistersAvailable {
+    std::map<std::uint8_t, TestRegInfo> regInfos;
+
+    static constexpr auto kFields = std::make_tuple(&TestRegistersAvailable::regInfos);
+};
+
+// Sizes of fixed layout messages are known at compile time.
+static_assert(kEncodedSize<RequestHeader> == 11);
+static_assert(kEncodedSize<ResponseHeader> == 12);
+static_assert(kEncodedSize<MemGetCommand> == 8);
+static_assert(kEncodedSize<CheckpointSetCommand> == 9);
+static_assert(kEncodedSize<CheckpointToggleCommand> == 5);
+static_assert(kEncodedSize<ExitCommand> == 0);
+
+}
+
+class ProtocolTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void encodesRequestHeader() {
+        RequestHeader h;
+        h.bodyLength = 3;
+        h.requestId = 0x01020304;
+        h.command = CMD_MEM_GET;
+        QCOMPARE(encode(h), (Bytes{ 0x02, 0x02, 3, 0, 0, 0, 4, 3, 2, 1, CMD_MEM_GET }));
+    }
+
+    void roundTripsFixedLayout() {
+        Bytes encoded = encode(MemGetCommand{ true, 0x1234, 0x5678, 0, 1 });
+        QCOMPARE(encoded, (Bytes{ 1, 0x34, 0x12, 0x78, 0x56, 0, 1, 0 }));
+
+        MemGetCommand decoded{};
+        QVERIFY(decode(encoded, decoded));
+        QCOMPARE(decoded.sideEffects, true);
+        QCOMPARE(decoded.startAddress, 0x1234);
+        QCOMPARE(decoded.endAddress, 0x5678);
+        QCOMPARE(decoded.bankId, 1);
+    }
+
+    void roundTripsMaps() {
+        RegistersSetCommand cmd{ 0, { { 3, 0xc000 }, { 1, 5 } } };
+        Bytes encoded = encode(cmd);
+        QCOMPARE(encoded, (Bytes{ 0, 2, 0, 3, 1, 5, 0, 3, 3, 0, 0xc0 }));
+
+        RegistersSetCommand decoded{};
+        QVERIFY(decode(encoded, decoded));
+        QVERIFY(decoded.values == cmd.values);
+    }
+
+    void roundTripsNestedTypes() {
+        TestRegistersAvailable msg{ { { 3, { 16, "PC" } } } };
+        TestRegistersAvailable decoded{};
+        QVERIFY(decode(encode(msg), decoded));
+        QCOMPARE(decoded.regInfos[3].bits, 16);
+        QCOMPARE(decoded.regInfos[3].name, "PC");
+    }
+
+    void skipsUnknownItemBytes() {
+        // Item size 6 instead of 3: newer VICE versions may append fields we don't know about.
+        Bytes encoded = { 0, 1, 0, 6, 3, 0, 0xc0, 0xaa, 0xbb, 0xcc };
+        RegistersSetCommand decoded{};
+        QVERIFY(decode(encoded, decoded));
+        QVERIFY(decoded.values == (std::map<std::uint8_t, std::uint16_t>{ { 3, 0xc000 } }));
+    }
+
+    void spansTakeTheRestOfTheBody() {
+        Bytes data = { 9, 8, 7 };
+        Bytes encoded = encode(MemSetCommand{ false, 0x100, 0x102, 0, 0, data });
+        QCOMPARE(encoded.size(), 11);
+        QCOMPARE(encoded[10], 7);
+
+        MemSetCommand decoded{};
+        QVERIFY(decode(encoded, decoded));
+        QCOMPARE(Bytes(decoded.data.begin(), decoded.data.end()), data);
+    }
+
+    void roundTripsFullMemGet() {
+        // All 64K: the 2 byte length wraps to 0.
+        Bytes memory(0x10000);
+        for (std::size_t i = 0; i < memory.size(); i++) {
+            memory[i] = i * 7;
+        }
+        Bytes encoded = encode(MemGetResponseBody{ (std::uint16_t)memory.size(), memory });
+        QCOMPARE(encoded.size(), 2 + memory.size());
+        QCOMPARE(encoded[0], 0);
+        QCOMPARE(encoded[1], 0);
+
+        MemGetResponseBody decoded{};
+        QVERIFY(decode(encoded, decoded));
+        QCOMPARE(decoded.length, 0);
+        QCOMPARE(Bytes(decoded.memory.begin(), decoded.memory.end()), memory);
+    }
+
+    void detectsTruncatedBodies() {
+        Bytes encoded = encode(MemGetCommand{ true, 0x1234, 0x5678, 0, 1 });
+        encoded.pop_back();
+        MemGetCommand decoded{};
+        QVERIFY(!decode(encoded, decoded));
+
+        Bytes nested = encode(TestRegistersAvailable{ { { 3, { 16, "PC" } } } });
+        nested[2] = 10; // item claims to be longer than the body
+        TestRegistersAvailable decodedNested{};
+        QVERIFY(!decode(nested, decodedNested));
+    }
+};
+
+}
+
+QTEST_MAIN(vicedebug::ProtocolTest)
+#include "protocol_test.moc"
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QTest>
+
+#include "rasterprofile.h"
+
+namespace vicedebug {
+
+class RasterProfileTest: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testFindExit() {
+        std::vector<std::uint8_t> memory(0x10000);
+        std::vector<std::uint8_t> code = {
+            0xa9, 0x00,       // $1000 LDA #$00
+            0xd0, 0x01,       // $1002 BNE $1005
+            0xe8,             // $1004 INX
+            0x8d, 0x20, 0xd0, // $1005 STA $D020
+            0x60,             // $1008 RTS
+        };
+        std::copy(code.begin(), code.end(), memory.begin() + 0x1000);
+        QCOMPARE(RasterProfile::findExit(Cpu::MOS6502, memory, 0x1000), std::optional<std::uint16_t>(0x1008));
+
+        // JP $1000, then RETI
+        memory[0x2000] = 0xc3;
+        memory[0x2001] = 0x00;
+        memory[0x2002] = 0x10;
+        memory[0x2003] = 0xed;
+        memory[0x2004] = 0x4d;
+        QCOMPARE(RasterProfile::findExit(Cpu::Z80, memory, 0x2000), std::optional<std::uint16_t>(0x2003));
+    }
+
+    void testFindExitGivesUp() {
+        // All NOP
+        std::vector<std::uint8_t> memory(0x10000, 0xea);
+        QVERIFY(!RasterProfile::findExit(Cpu::MOS6502, memory, 0x1000).has_value());
+    }
+
+    void testSpans() {
+        RasterProfile profile({ {"irq", 0x1000, 0x1080}, {"music", 0x2000, 0x2100} }, kRasterPal);
+        profile.addHit(0, true, 10, 0);
+        profile.addHit(1, true, 10, 20);
+        profile.addHit(1, false, 20, 20);
+        profile.addHit(0, false, 21, 0);
+
+        QCOMPARE(profile.frameCount(), std::uint64_t(1));
+        const RasterFrame& frame = profile.frames().back();
+        QCOMPARE(frame.spans.size(), size_t(2));
+        QCOMPARE(frame.spans[0].routine, 1);
+        QCOMPARE(frame.spans[0].start, 10 * 63 + 20);
+        QCOMPARE(frame.spans[0].cycles, 10 * 63);
+        QCOMPARE(frame.spans[1].routine, 0);
+        QCOMPARE(frame.spans[1].cycles, 11 * 63);
+        QCOMPARE(frame.cycles(0), 11 * 63);
+    }
+
+    void testFrames() {
+        RasterProfile profile({ {"irq", 0x1000, 0x1080} }, kRasterPal);
+        for (int frame = 0; frame < 3; frame++) {
+            // Twice per frame, the second one longer in the last frame.
+            profile.addHit(0, true, 50, 0);
+            profile.addHit(0, false, 60, 0);
+            profile.addHit(0, true, 250, 0);
+            profile.addHit(0, false, frame == 2 ? 280 : 260, 0);
+        }
+        QCOMPARE(profile.frameCount(), std::uint64_t(3));
+        QCOMPARE(profile.frames().size(), size_t(3));
+
+        const RasterRoutineStats& stats = profile.stats(0);
+        QCOMPARE(stats.calls, std::uint64_t(6));
+        QCOMPARE(stats.minCycles, 10 * 63);
+        QCOMPARE(stats.maxCycles, 30 * 63);
+        QCOMPARE(stats.totalCycles, std::uint64_t((5 * 10 + 30) * 63));
+        QCOMPARE(stats.maxCyclesPerFrame, 40 * 63);
+        QCOMPARE(profile.averageCyclesPerFrame(0), (5 * 10 + 30) * 63 / 3.0);
+    }
+
+    void testSpanAcrossFrames() {
+        RasterProfile profile({ {"irq", 0x1000, 0x1080} }, kRasterPal);
+        profile.addHit(0, true, 310, 0);
+        profile.addHit(0, false, 2, 0);
+
+        QCOMPARE(profile.frameCount(), std::uint64_t(2));
+        const RasterFrame& frame = profile.frames().back();
+        QCOMPARE(frame.spans.size(), size_t(1));
+        QCOMPARE(frame.spans[0].cycles, 4 * 63);
+        QCOMPARE(frame.spans[0].start, -2 * 63);
+    }
+
+    void testExitWithoutEntry() {
+        RasterProfile profile({ {"irq", 0x1000, 0x1080} }, kRasterPal);
+        profile.addHit(0, false, 20, 0);
+        QCOMPARE(profile.stats(0).calls, std::uint64_t(0));
+        QVERIFY(profile.frames().back().spans.empty());
+    }
+
+    void testFramesAreCapped() {
+        RasterProfile profile({ {"irq", 0x1000, 0x1080} }, kRasterPal);
+        for (std::size_t frame = 0; frame < RasterProfile::kMaxFrames + 10; frame++) {
+            profile.addHit(0, true, 100, 0);
+            profile.addHit(0, false, 101, 0);
+        }
+        QCOMPARE(profile.frames().size(), RasterProfile::kMaxFrames);
+        QCOMPARE(profile.frameCount(), std::uint64_t(RasterProfile::kMaxFrames + 10));
+    }
+};
+
+}
+
+QTEST_MAIN(vicedebug::RasterProfileTest)
+#include "rasterprofile_test.moc"
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QTest>
+
+#include <vector>
+#include <cstdint>
+#include <cstring>
+
+#include "receivebuffer.h"
+
+namespace vicedebug {
+
+namespace {
+
+std::vector<std::uint8_t> makeFrame(std::uint8_t responseType, std::uint32_t id, const std::vector<std::uint8_t>& body) {
+    std::vector<std::uint8_t> frame = {
+        0x02, // Binary response marker
+        0x02, // API version
+        (std::uint8_t)(body.size() & 0xff),
+        (std::uint8_t)((body.size() >> 8) & 0xff),
+        (std::uint8_t)((body.size() >> 16) & 0xff),
+        (std::uint8_t)((body.size() >> 24) & 0xff),
+        responseType,
+        0x00, // error code
+        (std::uint8_t)(id & 0xff),
+        (std::uint8_t)((id >> 8) & 0xff),
+        (std::uint8_t)((id >> 16) & 0xff),
+        (std::uint8_t)((id >> 24) & 0xff),
+    };
+    frame.insert(frame.end(), body.begin(), body.end());
+    return frame;
+}
+
+void append(ReceiveBuffer& buffer, const std::uint8_t* data, std::size_t len) {
+    auto dest = buffer.prepare(len);
+    std::memcpy(dest.data(), data, len);
+    buffer.commit(len);
+}
+
+}
+
+class ReceiveBufferTest: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testIncompleteHeader() {
+        ReceiveBuffer buffer(16);
+        auto frame = makeFrame(0x62, 0xffffffff, { 0x34, 0x12 });
+        append(buffer, frame.data(), 5);
+        QVERIFY(buffer.nextFrame().empty());
+        append(buffer, frame.data() + 5, frame.size() - 5);
+        auto f = buffer.nextFrame();
+        QCOMPARE(f.size(), frame.size());
+        QVERIFY(std::equal(f.begin(), f.end(), frame.begin()));
+        QCOMPARE(buffer.size(), std::size_t(0));
+    }
+
+    void testFrameSplitAcrossReads() {
+        ReceiveBuffer buffer(16);
+        std::vector<std::uint8_t> body(1000);
+        for (std::size_t i = 0; i < body.size(); i++) {
+            body[i] = i & 0xff;
+        }
+        auto frame = makeFrame(0x01, 1, body);
+        for (std::size_t i = 0; i < frame.size(); i += 7) {
+            QVERIFY(buffer.nextFrame().empty());
+            append(buffer, frame.data() + i, std::min<std::size_t>(7, frame.size() - i));
+        }
+        auto f = buffer.nextFrame();
+        QCOMPARE(f.size(), frame.size());
+        QVERIFY(std::equal(f.begin(), f.end(), frame.begin()));
+        QVERIFY(buffer.nextFrame().empty());
+    }
+
+    void testMultipleFramesInOneRead() {
+        ReceiveBuffer buffer(64);
+        auto f1 = makeFrame(0x01, 1, { 0xaa, 0xbb });
+        auto f2 = makeFrame(0x31, 2, {});
+        auto f3 = makeFrame(0x62, 0xffffffff, { 0x00, 0xc0 });
+        std::vector<std::uint8_t> all;
+        all.insert(all.end(), f1.begin(), f1.end());
+        all.insert(all.end(), f2.begin(), f2.end());
+        all.insert(all.end(), f3.begin(), f3.end());
+        // Only the first byte of the 4th frame
+        all.push_back(0x02);
+        append(buffer, all.data(), all.size());
+
+        QCOMPARE(buffer.nextFrame().size(), f1.size());
+        QCOMPARE(buffer.nextFrame().size(), f2.size());
+        auto f = buffer.nextFrame();
+        QCOMPARE(f.size(), f3.size());
+        QCOMPARE(f[6], std::uint8_t(0x62));
+        QVERIFY(buffer.nextFrame().empty());
+        QCOMPARE(buffer.size(), std::size_t(1));
+    }
+
+    void testPartialFrameIsMovedToFront() {
+        ReceiveBuffer buffer(32);
+        auto f1 = makeFrame(0x01, 1, std::vector<std::uint8_t>(10, 0x11));
+        auto f2 = makeFrame(0x01, 2, std::vector<std::uint8_t>(10, 0x22));
+        append(buffer, f1.data(), f1.size());
+        append(buffer, f2.data(), 8);
+        QCOMPARE(buffer.nextFrame().size(), f1.size());
+        // Rest of f2 doesn't fit at the end, so the partial frame is moved instead of growing the buffer.
+        append(buffer, f2.data() + 8, f2.size() - 8);
+        QCOMPARE(buffer.capacity(), std::size_t(32));
+        auto f = buffer.nextFrame();
+        QCOMPARE(f.size(), f2.size());
+        QVERIFY(std::equal(f.begin(), f.end(), f2.begin()));
+    }
+
+    void testGrowsForLargeFrames() {
+        ReceiveBuffer buffer(16);
+        auto frame = makeFrame(0x01, 1, std::vector<std::uint8_t>(0x10002, 0x42));
+        append(buffer, frame.data(), frame.size());
+        QVERIFY(buffer.capacity() >= frame.size());
+        QCOMPARE(buffer.nextFrame().size(), frame.size());
+    }
+};
+
+}
+
+QTEST_MAIN(vicedebug::ReceiveBufferTest)
+
+#include "receivebuffer_test.moc"
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QTest>
+
+#include <cstdint>
+
+#include "machinestate.h"
+
+namespace vicedebug {
+
+class RegistersTest: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testEmpty() {
+        const Registers regs;
+        for (int id = 0; id < Registers::kNofRegisters; id++) {
+            QVERIFY(!regs.contains((Registers::ID)id));
+            QCOMPARE(regs[(Registers::ID)id], std::uint16_t(0));
+        }
+    }
+
+    void testWriteMarksPresent() {
+        Registers regs;
+        regs[Registers::PC] = 0xc000;
+        regs[Registers::A] = 0x12;
+        QVERIFY(regs.contains(Registers::PC));
+        QVERIFY(regs.contains(Registers::A));
+        QVERIFY(!regs.contains(Registers::X));
+        QVERIFY(!regs.contains(Registers::IX));
+
+        const Registers& c = regs;
+        QCOMPARE(c[Registers::PC], std::uint16_t(0xc000));
+        QCOMPARE(c[Registers::A], std::uint16_t(0x12));
+    }
+
+    void testConstReadDoesNotMarkPresent() {
+        Registers regs;
+        const Registers& c = regs;
+        QCOMPARE(c[Registers::SP], std::uint16_t(0));
+        QVERIFY(!regs.contains(Registers::SP));
+    }
+
+    void testCopy() {
+        Registers regs;
+        regs[Registers::HLPrime] = 0xbeef;
+        Registers copy = regs;
+        QVERIFY(copy.contains(Registers::HLPrime));
+        QCOMPARE(copy[Registers::HLPrime], std::uint16_t(0xbeef));
+    }
+};
+
+}
+
+QTEST_MAIN(vicedebug::RegistersTest)
+#include "registers_test.moc"
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QTest>
+
+#include <cstdint>
+#include <string>
+
+#include "stepcondition.h"
+
+namespace vicedebug {
+
+class StepConditionTest: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testRegisterComparison() {
+        std::string error;
+        auto c = StepCondition::parse("PC == $c000", error);
+        QVERIFY(c.has_value());
+        QVERIFY(c->memoryAddresses().empty());
+
+        Registers regs;
+        regs[Registers::PC] = 0xc000;
+        QVERIFY(c->evaluate(regs, {}));
+        regs[Registers::PC] = 0xc001;
+        QVERIFY(!c->evaluate(regs, {}));
+    }
+
+    void testMemoryOperands() {
+        std::string error;
+        auto c = StepCondition::parse("A != 0 && [$d020] == $0e && [0xd020] < 16", error);
+        QVERIFY(c.has_value());
+        // Each address is fetched only once.
+        QCOMPARE(c->memoryAddresses().size(), size_t(1));
+        QCOMPARE(c->memoryAddresses()[0], std::uint16_t(0xd020));
+
+        Registers regs;
+        regs[Registers::A] = 1;
+        QVERIFY(c->evaluate(regs, {{0xd020, 0x0e}}));
+        QVERIFY(!c->evaluate(regs, {{0xd020, 0x0f}}));
+    }
+
+    void testPrecedence() {
+        std::string error;
+        Registers regs;
+        auto c = StepCondition::parse("1 < 2 || 3 > 4 && 0 == 1", error);
+        QVERIFY(c.has_value());
+        QVERIFY(c->evaluate(regs, {}));
+
+        c = StepCondition::parse("(1 < 2 || 3 > 4) && 0 == 1", error);
+        QVERIFY(c.has_value());
+        QVERIFY(!c->evaluate(regs, {}));
+    }
+
+    void testRegisterNames() {
+        std::string error;
+        auto c = StepCondition::parse("af' == %101 && x >= 10", error);
+        QVERIFY(c.has_value());
+
+        Registers regs;
+        regs[Registers::AFPrime] = 5;
+        regs[Registers::X] = 10;
+        QVERIFY(c->evaluate(regs, {}));
+    }
+
+    void testErrors_data() {
+        QTest::addColumn<QString>("text");
+
+        QTest::newRow("missing operand") << "PC ==";
+        QTest::newRow("trailing paren") << "PC == 1 )";
+        QTest::newRow("single equals") << "PC = 1";
+        QTest::newRow("value too large") << "PC == $10000";
+        QTest::newRow("unknown register") << "PCX == 1";
+    }
+
+    void testErrors() {
+        QFETCH(QString, text);
+        std::string error;
+        QVERIFY(!StepCondition::parse(text.toStdString(), error).has_value());
+        QVERIFY(!error.empty());
+    }
+};
+
+}
+
+QTEST_MAIN(vicedebug::StepConditionTest)
+#include "stepcondition_test.moc"
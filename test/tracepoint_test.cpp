@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <QTest>
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "tracepoint.h"
+
+namespace vicedebug {
+
+class TracepointTest: public QObject
+{
+    Q_OBJECT
+
+private:
+    static Registers registers(std::uint16_t a, std::uint16_t x) {
+        Registers regs;
+        regs[Registers::A] = a;
+        regs[Registers::X] = x;
+        return regs;
+    }
+
+private slots:
+    void testParse() {
+        std::string error;
+        auto spec = TraceSpec::parse("a, X af' [$d020] [$fb-$fe] a", error);
+        QVERIFY(spec.has_value());
+        QCOMPARE(spec->registers, (std::vector<Registers::ID>{Registers::A, Registers::X, Registers::AFPrime}));
+        QCOMPARE(spec->memory.size(), size_t(2));
+        QCOMPARE(spec->memory[1].start, std::uint16_t(0xfb));
+        QCOMPARE(spec->memory[1].end, std::uint16_t(0xfe));
+        QCOMPARE(spec->memorySize(), 5);
+        QCOMPARE(spec->toString(), std::string("A X AF' [$d020] [$00fb-$00fe]"));
+
+        // toString() can be parsed again.
+        auto again = TraceSpec::parse(spec->toString(), error);
+        QVERIFY(again.has_value());
+        QCOMPARE(again->toString(), spec->toString());
+    }
+
+    void testParseErrors_data() {
+        QTest::addColumn<QString>("text");
+        QTest::newRow("unknown register") << "A Q";
+        QTest::newRow("unterminated range") << "[$d020";
+        QTest::newRow("reversed range") << "[$10-$5]";
+        QTest::newRow("address out of range") << "[$10000]";
+    }
+
+    void testParseErrors() {
+        QFETCH(QString, text);
+        std::string error;
+        QVERIFY(!TraceSpec::parse(text.toStdString(), error).has_value());
+        QVERIFY(!error.empty());
+    }
+
+    void testAppend() {
+        std::string error;
+        TraceLog log(*TraceSpec::parse("A [$10-$11]", error));
+        log.append(100, 0xc000, registers(1, 2), std::vector<std::uint8_t>{0xaa, 0xbb});
+        // A short read is padded, so that the following hits stay aligned.
+        log.append(200, 0xc003, registers(3, 4), std::vector<std::uint8_t>{0xcc});
+        QCOMPARE(log.size(), size_t(2));
+        QCOMPARE(log.pc(1), std::uint16_t(0xc003));
+        QCOMPARE(log.reg(0, 1), std::uint16_t(3));
+        QCOMPARE(std::vector<std::uint8_t>(log.memory(0).begin(), log.memory(0).end()), (std::vector<std::uint8_t>{0xaa, 0xbb}));
+        QCOMPARE(std::vector<std::uint8_t>(log.memory(1).begin(), log.memory(1).end()), (std::vector<std::uint8_t>{0xcc, 0x00}));
+
+        log.clear();
+        QCOMPARE(log.size(), size_t(0));
+    }
+
+    void testHitsPerSecond() {
+        TraceLog log(TraceSpec{});
+        for (int i = 0; i < 10; i++) {
+            log.append(i * 200'000'000LL, 0, Registers(), {});
+        }
+        // Hits at 1.0s ... 1.8s are in the last second before 1.8s.
+        QCOMPARE(log.hitsPerSecond(1'800'000'000LL), 5.0);
+        QCOMPARE(log.hitsPerSecond(100'000'000'000LL), 0.0);
+    }
+
+    void testWriteCsv() {
+        std::string error;
+        TraceLog log(*TraceSpec::parse("A X [$d020]", error));
+        log.append(5'000'000, 0xc000, registers(0xff, 1), std::vector<std::uint8_t>{0x0e});
+        log.append(7'500'000, 0xc010, registers(0x00, 2), std::vector<std::uint8_t>{0x06});
+        std::ostringstream os;
+        log.writeCsv(os);
+        QCOMPARE(os.str(), std::string(
+            "time_us,pc,A,X,d020\n"
+            "0,c000,ff,01,0e\n"
+            "2500,c010,00,02,06\n"));
+    }
+
+    void testWriteBinary() {
+        std::string error;
+        TraceLog log(*TraceSpec::parse("X [$d020]", error));
+        log.append(0x0102, 0xc000, registers(0, 7), std::vector<std::uint8_t>{0x0e});
+        std::ostringstream os;
+        log.writeBinary(os);
+        std::string expected("VDTRACE1", 8);
+        expected += std::string("\x01\x01", 2); // one register: X
+        expected += std::string("\x01\x20\xd0\x20\xd0", 5); // one range: $d020-$d020
+        expected += std::string("\x01\x00\x00\x00", 4); // one hit
+        expected += std::string("\x02\x01\x00\x00\x00\x00\x00\x00", 8); // timestamps
+        expected += std::string("\x00\xc0", 2); // PCs
+        expected += std::string("\x07\x00", 2); // X
+        expected += std::string("\x0e", 1); // memory
+        QCOMPARE(os.str(), expected);
+    }
+};
+
+}
+
+QTEST_MAIN(vicedebug::TracepointTest)
+#include "tracepoint_test.moc"
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2024 Andreas Signer <asigner@gmail.com>
+ *
+ * This file is part of vicedebug.
+ *
+ * vicedebug is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * vicedebug is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with vicedebug.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QTest>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <cstring>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "tracing.h"
+
+namespace vicedebug {
+
+namespace {
+
+const PhaseStats* findStats(const std::vector<PhaseStats>& stats, const char* name) {
+    for (const auto& s : stats) {
+        if (s.name == name) {
+            return &s;
+        }
+    }
+    return nullptr;
+}
+
+TraceEvent event(const char* name, TraceEvent::Kind kind, std::uint32_t stepId, std::int64_t startNs, std::int64_t durationNs = 0) {
+    return TraceEvent{name, kind, stepId, 1, startNs, durationNs};
+}
+
+}
+
+class TracingTest: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testRecordsInOrder() {
+        Tracer tracer(8);
+        tracer.setEnabled(true);
+        tracer.beginStep();
+        tracer.instant(kTraceStoppedReceived);
+        tracer.complete(kTraceMachineState, 1000, 3000);
+
+        auto events = tracer.snapshot();
+        QCOMPARE(events.size(), std::size_t(2));
+        QCOMPARE(events[0].name, kTraceStoppedReceived);
+        QVERIFY(events[0].kind == TraceEvent::Kind::INSTANT);
+        QCOMPARE(events[0].stepId, std::uint32_t(1));
+        QCOMPARE(events[1].name, kTraceMachineState);
+        QCOMPARE(events[1].startNs, std::int64_t(1000));
+        QCOMPARE(events[1].durationNs, std::int64_t(2000));
+    }
+
+    void testOverwritesOldestEvents() {
+        Tracer tracer(4);
+        tracer.setEnabled(true);
+        for (int i = 0; i < 10; i++) {
+            tracer.complete(kTraceMachineState, i, i + 1);
+        }
+        auto events = tracer.snapshot();
+        QCOMPARE(events.size(), std::size_t(4));
+        QCOMPARE(events.front().startNs, std::int64_t(6));
+        QCOMPARE(events.back().startNs, std::int64_t(9));
+        QCOMPARE(tracer.recorded(), std::uint64_t(10));
+    }
+
+    void testDisabledByDefault() {
+        Tracer tracer(4);
+        QVERIFY(!tracer.isEnabled());
+        tracer.instant(kTraceStoppedReceived);
+        QVERIFY(tracer.snapshot().empty());
+    }
+
+    void testClearAndDisable() {
+        Tracer tracer(4);
+        tracer.setEnabled(true);
+        tracer.instant(kTraceStoppedReceived);
+        tracer.clear();
+        QVERIFY(tracer.snapshot().empty());
+
+        tracer.setEnabled(false);
+        tracer.instant(kTraceStoppedReceived);
+        {
+            TraceScope scope(kTraceMachineState, tracer);
+        }
+        QVERIFY(tracer.snapshot().empty());
+        QCOMPARE(tracer.recorded(), std::uint64_t(0));
+    }
+
+    void testConcurrentWriters() {
+        constexpr int kThreads = 4;
+        constexpr int kEventsPerThread = 20000;
+        Tracer tracer(1024);
+        tracer.setEnabled(true);
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreads; t++) {
+            threads.emplace_back([&tracer, t] {
+                for (int i = 0; i < kEventsPerThread; i++) {
+                    tracer.complete(kTraceMachineState, t * kEventsPerThread + i, t * kEventsPerThread + i + t);
+                }
+            });
+        }
+        // Snapshots while writing must only ever see consistent events.
+        for (int i = 0; i < 100; i++) {
+            for (const auto& e : tracer.snapshot()) {
+                QCOMPARE(e.durationNs, e.startNs / kEventsPerThread);
+            }
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+
+        auto events = tracer.snapshot();
+        QCOMPARE(events.size(), tracer.capacity());
+        std::set<std::int64_t> starts;
+        for (const auto& e : events) {
+            QCOMPARE(e.durationNs, e.startNs / kEventsPerThread);
+            starts.insert(e.startNs);
+        }
+        QCOMPARE(starts.size(), events.size());
+    }
+
+    void testPhaseStats() {
+        std::vector<TraceEvent> events;
+        for (int i = 1; i <= 100; i++) {
+            events.push_back(event(kTraceMachineState, TraceEvent::Kind::COMPLETE, i, 0, i * 1000));
+        }
+        auto stats = computePhaseStats(events);
+        const PhaseStats* s = findStats(stats, kTraceMachineState);
+        QVERIFY(s != nullptr);
+        QCOMPARE(s->samplesNs.size(), std::size_t(100));
+        QCOMPARE(s->minNs(), std::int64_t(1000));
+        QCOMPARE(s->maxNs(), std::int64_t(100000));
+        QCOMPARE(s->percentileNs(50), std::int64_t(50000));
+        QCOMPARE(s->percentileNs(95), std::int64_t(95000));
+        QCOMPARE(s->meanNs(), std::int64_t(50500));
+
+        // 1us -> 0, 2..3us -> 1, 4..7us -> 2, ..., 64..100us -> 6
+        QCOMPARE(s->histogram[0], std::uint32_t(1));
+        QCOMPARE(s->histogram[1], std::uint32_t(2));
+        QCOMPARE(s->histogram[2], std::uint32_t(4));
+        QCOMPARE(s->histogram[6], std::uint32_t(37));
+    }
+
+    void testStopToPaint() {
+        std::vector<TraceEvent> events = {
+            event(kTraceStoppedReceived, TraceEvent::Kind::INSTANT, 1, 1000),
+            event("paint A", TraceEvent::Kind::COMPLETE, 1, 5000, 1000),
+            event("paint B", TraceEvent::Kind::COMPLETE, 1, 6000, 2000),
+            // Later paints of the same widget (e.g. scrolling) don't count.
+            event("paint A", TraceEvent::Kind::COMPLETE, 1, 50000, 1000),
+            // Paint without a stop
+            event("paint A", TraceEvent::Kind::COMPLETE, 2, 60000, 1000),
+        };
+        auto stats = computePhaseStats(events);
+        const PhaseStats* s = findStats(stats, kTraceStopToPaint);
+        QVERIFY(s != nullptr);
+        QCOMPARE(s->samplesNs, std::vector<std::int64_t>{7000});
+    }
+
+    void testChromeTrace() {
+        std::vector<TraceEvent> events = {
+            event(kTraceStoppedReceived, TraceEvent::Kind::INSTANT, 3, 10000),
+            event(kTraceMachineState, TraceEvent::Kind::COMPLETE, 3, 11500, 2250),
+        };
+        std::ostringstream os;
+        writeChromeTrace(os, events);
+
+        QJsonParseError error;
+        QJsonDocument doc = QJsonDocument::fromJson(QByteArray::fromStdString(os.str()), &error);
+        QCOMPARE(error.error, QJsonParseError::NoError);
+        QJsonArray traceEvents = doc.object()["traceEvents"].toArray();
+        QCOMPARE(traceEvents.size(), 2);
+
+        QJsonObject e0 = traceEvents[0].toObject();
+        QCOMPARE(e0["name"].toString(), QString(kTraceStoppedReceived));
+        QCOMPARE(e0["ph"].toString(), QString("i"));
+        QCOMPARE(e0["ts"].toDouble(), 0.0);
+
+        QJsonObject e1 = traceEvents[1].toObject();
+        QCOMPARE(e1["ph"].toString(), QString("X"));
+        QCOMPARE(e1["ts"].toDouble(), 1.5);
+        QCOMPARE(e1["dur"].toDouble(), 2.25);
+        QCOMPARE(e1["args"].toObject()["step"].toInt(), 3);
+    }
+};
+
+}
+
+QTEST_MAIN(vicedebug::TracingTest)
+#include "tracing_test.moc"